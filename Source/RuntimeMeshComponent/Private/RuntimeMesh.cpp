@@ -67,6 +67,7 @@ URuntimeMesh::URuntimeMesh(const FObjectInitializer& ObjectInitializer)
 	, bUseAsyncCooking(false)
 	, bShouldSerializeMeshData(true)
 	, CollisionMode(ERuntimeMeshCollisionCookingMode::CookingPerformance)
+	, bUseSharedSectionBuffers(false)
 	, BodySetup(nullptr)
 {
 	Data->Setup(TWeakObjectPtr<URuntimeMesh>(this));
@@ -0,0 +1,339 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshArena.h"
+#include "RuntimeMeshComponentPlugin.h"
+
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Arena - Pages"), STAT_RuntimeMesh_Arena_NumPages, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Arena - Allocations"), STAT_RuntimeMesh_Arena_NumAllocations, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Arena - Flush"), STAT_RuntimeMesh_Arena_Flush, STATGROUP_RuntimeMesh);
+
+// Default size of a page, sections bigger than this get a page sized to fit them
+static const int32 RuntimeMeshArenaPageVertices = 64 * 1024;
+static const int32 RuntimeMeshArenaPageIndices = 3 * RuntimeMeshArenaPageVertices;
+
+
+FRuntimeMeshRangeAllocator::FRuntimeMeshRangeAllocator(int32 InSize)
+{
+	if (InSize > 0)
+	{
+		FreeRanges.Add(FRuntimeMeshStreamRange(0, InSize));
+	}
+}
+
+bool FRuntimeMeshRangeAllocator::Allocate(int32 Count, int32& OutStart)
+{
+	if (Count <= 0)
+	{
+		OutStart = 0;
+		return true;
+	}
+
+	for (int32 Index = 0; Index < FreeRanges.Num(); Index++)
+	{
+		FRuntimeMeshStreamRange& Range = FreeRanges[Index];
+		if (Range.Count >= Count)
+		{
+			OutStart = Range.Start;
+
+			Range.Start += Count;
+			Range.Count -= Count;
+			if (Range.IsEmpty())
+			{
+				FreeRanges.RemoveAt(Index);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+void FRuntimeMeshRangeAllocator::Free(int32 Start, int32 Count)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// Find the first free range after this one
+	int32 Index = 0;
+	while (Index < FreeRanges.Num() && FreeRanges[Index].Start < Start)
+	{
+		Index++;
+	}
+
+	const bool bMergeWithPrevious = Index > 0 && FreeRanges[Index - 1].Start + FreeRanges[Index - 1].Count == Start;
+	const bool bMergeWithNext = Index < FreeRanges.Num() && Start + Count == FreeRanges[Index].Start;
+
+	if (bMergeWithPrevious && bMergeWithNext)
+	{
+		FreeRanges[Index - 1].Count += Count + FreeRanges[Index].Count;
+		FreeRanges.RemoveAt(Index);
+	}
+	else if (bMergeWithPrevious)
+	{
+		FreeRanges[Index - 1].Count += Count;
+	}
+	else if (bMergeWithNext)
+	{
+		FreeRanges[Index].Start = Start;
+		FreeRanges[Index].Count += Count;
+	}
+	else
+	{
+		FreeRanges.Insert(FRuntimeMeshStreamRange(Start, Count), Index);
+	}
+}
+
+
+
+FRuntimeMeshArenaPage::FRuntimeMeshArenaPage(ERHIFeatureLevel::Type InFeatureLevel, const FRuntimeMeshArenaFormat& InFormat, int32 InNumVertices, int32 InNumIndices, int32 InNumAdjacencyIndices)
+	: Format(InFormat)
+	, VertexFactory(InFeatureLevel, nullptr)
+	, PositionBuffer(InFormat.UpdateFrequency)
+	, TangentsBuffer(InFormat.UpdateFrequency, InFormat.bUseHighPrecisionTangents)
+	, UVsBuffer(InFormat.UpdateFrequency, InFormat.bUseHighPrecisionUVs, InFormat.NumUVs)
+	, ColorBuffer(InFormat.UpdateFrequency)
+	, IndexBuffer(InFormat.UpdateFrequency, InFormat.IndexSize == 4)
+	, AdjacencyIndexBuffer(InFormat.UpdateFrequency, InFormat.IndexSize == 4)
+	, VertexAllocator(InNumVertices)
+	, IndexAllocator(InNumIndices)
+	, AdjacencyIndexAllocator(InNumAdjacencyIndices)
+	, NumAllocations(0)
+	, DirtyBuffers(ERuntimeMeshBuffersToUpdate::None)
+{
+	check(IsInRenderingThread());
+
+	PositionBuffer.Reset(InNumVertices);
+	TangentsBuffer.Reset(InNumVertices);
+	UVsBuffer.Reset(InNumVertices);
+	ColorBuffer.Reset(InNumVertices);
+	IndexBuffer.Reset(InFormat.IndexSize, InNumIndices, InFormat.UpdateFrequency);
+	AdjacencyIndexBuffer.Reset(InFormat.IndexSize, InNumAdjacencyIndices, InFormat.UpdateFrequency);
+
+	PositionData.SetNumZeroed(PositionBuffer.GetBufferSize());
+	TangentsData.SetNumZeroed(TangentsBuffer.GetBufferSize());
+	UVsData.SetNumZeroed(UVsBuffer.GetBufferSize());
+	ColorData.SetNumZeroed(ColorBuffer.GetBufferSize());
+	IndexData.SetNumZeroed(IndexBuffer.GetBufferSize());
+	AdjacencyIndexData.SetNumZeroed(AdjacencyIndexBuffer.GetBufferSize());
+
+	// The page buffers never get reallocated, so the vertex factory only has to be set up once
+	FLocalVertexFactory::FDataType DataType;
+	PositionBuffer.Bind(DataType);
+	TangentsBuffer.Bind(DataType);
+	UVsBuffer.Bind(DataType);
+	ColorBuffer.Bind(DataType);
+
+	VertexFactory.Init(DataType);
+	VertexFactory.InitResource();
+
+	INC_DWORD_STAT(STAT_RuntimeMesh_Arena_NumPages);
+}
+
+FRuntimeMeshArenaPage::~FRuntimeMeshArenaPage()
+{
+	check(IsInRenderingThread());
+	check(NumAllocations == 0);
+
+	PositionBuffer.ReleaseResource();
+	TangentsBuffer.ReleaseResource();
+	UVsBuffer.ReleaseResource();
+	ColorBuffer.ReleaseResource();
+	IndexBuffer.ReleaseResource();
+	AdjacencyIndexBuffer.ReleaseResource();
+	VertexFactory.ReleaseResource();
+
+	DEC_DWORD_STAT(STAT_RuntimeMesh_Arena_NumPages);
+}
+
+void FRuntimeMeshArenaPage::WriteVertices(ERuntimeMeshBuffersToUpdate Stream, const TArray<uint8>& Data, int32 StartVertex)
+{
+	check(IsInRenderingThread());
+
+	TArray<uint8>* Shadow = nullptr;
+	int32 VertexSize = 0;
+	switch (Stream)
+	{
+	case ERuntimeMeshBuffersToUpdate::PositionBuffer:
+		Shadow = &PositionData;
+		VertexSize = PositionBuffer.GetVertexSize();
+		break;
+	case ERuntimeMeshBuffersToUpdate::TangentBuffer:
+		Shadow = &TangentsData;
+		VertexSize = TangentsBuffer.GetVertexSize();
+		break;
+	case ERuntimeMeshBuffersToUpdate::UVBuffer:
+		Shadow = &UVsData;
+		VertexSize = UVsBuffer.GetVertexSize();
+		break;
+	case ERuntimeMeshBuffersToUpdate::ColorBuffer:
+		Shadow = &ColorData;
+		VertexSize = ColorBuffer.GetVertexSize();
+		break;
+	default:
+		checkNoEntry();
+		return;
+	}
+
+	const int32 StartOffset = StartVertex * VertexSize;
+	check(StartVertex >= 0 && StartOffset + Data.Num() <= Shadow->Num());
+
+	if (Data.Num() > 0)
+	{
+		FMemory::Memcpy(Shadow->GetData() + StartOffset, Data.GetData(), Data.Num());
+		DirtyBuffers |= Stream;
+	}
+}
+
+void FRuntimeMeshArenaPage::WriteIndices(ERuntimeMeshBuffersToUpdate Stream, const TArray<uint8>& Data, int32 StartIndex)
+{
+	check(IsInRenderingThread());
+	check(Stream == ERuntimeMeshBuffersToUpdate::IndexBuffer || Stream == ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer);
+
+	TArray<uint8>& Shadow = Stream == ERuntimeMeshBuffersToUpdate::IndexBuffer ? IndexData : AdjacencyIndexData;
+
+	const int32 StartOffset = StartIndex * Format.IndexSize;
+	check(StartIndex >= 0 && StartOffset + Data.Num() <= Shadow.Num());
+
+	if (Data.Num() > 0)
+	{
+		FMemory::Memcpy(Shadow.GetData() + StartOffset, Data.GetData(), Data.Num());
+		DirtyBuffers |= Stream;
+	}
+}
+
+void FRuntimeMeshArenaPage::Flush()
+{
+	check(IsInRenderingThread());
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Arena_Flush);
+
+	if (!!(DirtyBuffers & ERuntimeMeshBuffersToUpdate::PositionBuffer))
+	{
+		PositionBuffer.SetData(PositionData);
+	}
+	if (!!(DirtyBuffers & ERuntimeMeshBuffersToUpdate::TangentBuffer))
+	{
+		TangentsBuffer.SetData(TangentsData);
+	}
+	if (!!(DirtyBuffers & ERuntimeMeshBuffersToUpdate::UVBuffer))
+	{
+		UVsBuffer.SetData(UVsData);
+	}
+	if (!!(DirtyBuffers & ERuntimeMeshBuffersToUpdate::ColorBuffer))
+	{
+		ColorBuffer.SetData(ColorData);
+	}
+	if (!!(DirtyBuffers & ERuntimeMeshBuffersToUpdate::IndexBuffer))
+	{
+		IndexBuffer.SetData(IndexData);
+	}
+	if (!!(DirtyBuffers & ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer))
+	{
+		AdjacencyIndexBuffer.SetData(AdjacencyIndexData);
+	}
+
+	DirtyBuffers = ERuntimeMeshBuffersToUpdate::None;
+}
+
+
+
+FRuntimeMeshArena::FRuntimeMeshArena(ERHIFeatureLevel::Type InFeatureLevel)
+	: FeatureLevel(InFeatureLevel)
+{
+}
+
+FRuntimeMeshArena::~FRuntimeMeshArena()
+{
+	// Every section should have given back its space by now
+	check(Pages.Num() == 0);
+}
+
+FRuntimeMeshArenaAllocation FRuntimeMeshArena::Allocate(const FRuntimeMeshArenaFormat& Format, int32 NumVertices, int32 NumIndices, int32 NumAdjacencyIndices)
+{
+	check(IsInRenderingThread());
+
+	FRuntimeMeshArenaAllocation Allocation;
+	Allocation.NumVertices = NumVertices;
+	Allocation.NumIndices = NumIndices;
+	Allocation.NumAdjacencyIndices = NumAdjacencyIndices;
+
+	auto TryAllocate = [&](FRuntimeMeshArenaPage* Page) -> bool
+	{
+		if (!Page->VertexAllocator.Allocate(NumVertices, Allocation.VertexStart))
+		{
+			return false;
+		}
+
+		if (!Page->IndexAllocator.Allocate(NumIndices, Allocation.IndexStart))
+		{
+			Page->VertexAllocator.Free(Allocation.VertexStart, NumVertices);
+			return false;
+		}
+
+		if (!Page->AdjacencyIndexAllocator.Allocate(NumAdjacencyIndices, Allocation.AdjacencyIndexStart))
+		{
+			Page->VertexAllocator.Free(Allocation.VertexStart, NumVertices);
+			Page->IndexAllocator.Free(Allocation.IndexStart, NumIndices);
+			return false;
+		}
+
+		Allocation.Page = Page;
+		Page->NumAllocations++;
+		INC_DWORD_STAT(STAT_RuntimeMesh_Arena_NumAllocations);
+		return true;
+	};
+
+	for (const TUniquePtr<FRuntimeMeshArenaPage>& Page : Pages)
+	{
+		if (Page->Format == Format && TryAllocate(Page.Get()))
+		{
+			return Allocation;
+		}
+	}
+
+	// Nothing had room, so start a new page. Adjacency is rare so pages only get room for it when it's asked for.
+	const int32 PageVertices = FMath::Max(NumVertices, RuntimeMeshArenaPageVertices);
+	const int32 PageIndices = FMath::Max(NumIndices, RuntimeMeshArenaPageIndices);
+	const int32 PageAdjacencyIndices = NumAdjacencyIndices > 0 ? FMath::Max(NumAdjacencyIndices, RuntimeMeshArenaPageIndices * 4) : 0;
+
+	FRuntimeMeshArenaPage* NewPage = new FRuntimeMeshArenaPage(FeatureLevel, Format, PageVertices, PageIndices, PageAdjacencyIndices);
+	Pages.Emplace(NewPage);
+
+	verify(TryAllocate(NewPage));
+	return Allocation;
+}
+
+void FRuntimeMeshArena::Free(FRuntimeMeshArenaAllocation& Allocation)
+{
+	check(IsInRenderingThread());
+
+	if (!Allocation.IsValid())
+	{
+		return;
+	}
+
+	FRuntimeMeshArenaPage* Page = Allocation.Page;
+	Page->VertexAllocator.Free(Allocation.VertexStart, Allocation.NumVertices);
+	Page->IndexAllocator.Free(Allocation.IndexStart, Allocation.NumIndices);
+	Page->AdjacencyIndexAllocator.Free(Allocation.AdjacencyIndexStart, Allocation.NumAdjacencyIndices);
+	Page->NumAllocations--;
+	DEC_DWORD_STAT(STAT_RuntimeMesh_Arena_NumAllocations);
+
+	if (Page->NumAllocations == 0)
+	{
+		Pages.RemoveAll([Page](const TUniquePtr<FRuntimeMeshArenaPage>& Entry) { return Entry.Get() == Page; });
+	}
+
+	Allocation = FRuntimeMeshArenaAllocation();
+}
+
+void FRuntimeMeshArena::Flush()
+{
+	check(IsInRenderingThread());
+
+	for (const TUniquePtr<FRuntimeMeshArenaPage>& Page : Pages)
+	{
+		Page->Flush();
+	}
+}
@@ -0,0 +1,153 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshCore.h"
+#include "RuntimeMeshRendering.h"
+
+
+/** First fit allocator for ranges of elements within a fixed size buffer */
+class FRuntimeMeshRangeAllocator
+{
+	/** Free ranges, sorted by start and never adjacent to each other */
+	TArray<FRuntimeMeshStreamRange> FreeRanges;
+
+public:
+	FRuntimeMeshRangeAllocator(int32 InSize);
+
+	/** Finds space for Count elements, returns false if there's no free range big enough */
+	bool Allocate(int32 Count, int32& OutStart);
+
+	/** Returns a range to the allocator, merging it with any free neighbors */
+	void Free(int32 Start, int32 Count);
+};
+
+
+/** Stream configuration of a section LOD. Sections can only share arena buffers when these all match */
+struct FRuntimeMeshArenaFormat
+{
+	EUpdateFrequency UpdateFrequency;
+	bool bUseHighPrecisionTangents;
+	bool bUseHighPrecisionUVs;
+	int32 NumUVs;
+	int32 IndexSize;
+
+	FRuntimeMeshArenaFormat(EUpdateFrequency InUpdateFrequency, bool bInUseHighPrecisionTangents, bool bInUseHighPrecisionUVs, int32 InNumUVs, int32 InIndexSize)
+		: UpdateFrequency(InUpdateFrequency)
+		, bUseHighPrecisionTangents(bInUseHighPrecisionTangents)
+		, bUseHighPrecisionUVs(bInUseHighPrecisionUVs)
+		, NumUVs(InNumUVs)
+		, IndexSize(InIndexSize)
+	{ }
+
+	bool operator==(const FRuntimeMeshArenaFormat& Other) const
+	{
+		return UpdateFrequency == Other.UpdateFrequency && bUseHighPrecisionTangents == Other.bUseHighPrecisionTangents &&
+			bUseHighPrecisionUVs == Other.bUseHighPrecisionUVs && NumUVs == Other.NumUVs && IndexSize == Other.IndexSize;
+	}
+};
+
+
+/** One set of large shared buffers, and the single vertex factory used to draw every section allocated from them */
+class FRuntimeMeshArenaPage
+{
+public:
+	const FRuntimeMeshArenaFormat Format;
+
+	FRuntimeMeshVertexFactory VertexFactory;
+
+	FRuntimeMeshPositionVertexBuffer PositionBuffer;
+	FRuntimeMeshTangentsVertexBuffer TangentsBuffer;
+	FRuntimeMeshUVsVertexBuffer UVsBuffer;
+	FRuntimeMeshColorVertexBuffer ColorBuffer;
+	FRuntimeMeshIndexBuffer IndexBuffer;
+	FRuntimeMeshIndexBuffer AdjacencyIndexBuffer;
+
+	FRuntimeMeshRangeAllocator VertexAllocator;
+	FRuntimeMeshRangeAllocator IndexAllocator;
+	FRuntimeMeshRangeAllocator AdjacencyIndexAllocator;
+
+	/** Number of section LODs currently allocated from this page */
+	int32 NumAllocations;
+
+	FRuntimeMeshArenaPage(ERHIFeatureLevel::Type InFeatureLevel, const FRuntimeMeshArenaFormat& InFormat, int32 InNumVertices, int32 InNumIndices, int32 InNumAdjacencyIndices);
+	~FRuntimeMeshArenaPage();
+
+	/** Writes a section's vertices for one stream into the page, starting at StartVertex. Uploaded on the next Flush */
+	void WriteVertices(ERuntimeMeshBuffersToUpdate Stream, const TArray<uint8>& Data, int32 StartVertex);
+
+	/** Writes a section's indices into the index or adjacency index buffer, starting at StartIndex. Uploaded on the next Flush */
+	void WriteIndices(ERuntimeMeshBuffersToUpdate Stream, const TArray<uint8>& Data, int32 StartIndex);
+
+	/** Uploads every buffer written to since the last flush */
+	void Flush();
+
+private:
+	/*
+	 *	Render thread copy of every page buffer. Locking part of a buffer doesn't keep the rest of it on every RHI
+	 *	(D3D11 fills a static buffer lock from fresh scratch memory and uploads it over the whole buffer), so sections
+	 *	write here and the buffers are only ever uploaded whole.
+	 */
+	TArray<uint8> PositionData;
+	TArray<uint8> TangentsData;
+	TArray<uint8> UVsData;
+	TArray<uint8> ColorData;
+	TArray<uint8> IndexData;
+	TArray<uint8> AdjacencyIndexData;
+
+	/** Buffers written to since the last flush */
+	ERuntimeMeshBuffersToUpdate DirtyBuffers;
+};
+
+
+/** A single section LOD's slice of an arena page */
+struct FRuntimeMeshArenaAllocation
+{
+	FRuntimeMeshArenaPage* Page;
+
+	int32 VertexStart;
+	int32 NumVertices;
+
+	int32 IndexStart;
+	int32 NumIndices;
+
+	int32 AdjacencyIndexStart;
+	int32 NumAdjacencyIndices;
+
+	FRuntimeMeshArenaAllocation()
+		: Page(nullptr), VertexStart(0), NumVertices(0), IndexStart(0), NumIndices(0), AdjacencyIndexStart(0), NumAdjacencyIndices(0)
+	{ }
+
+	bool IsValid() const { return Page != nullptr; }
+};
+
+
+/*
+ *	Suballocates the vertex and index data of all the sections in a mesh out of a few large buffers.
+ *	Sections are drawn using BaseVertexIndex/FirstIndex into their page's buffers, so every section
+ *	with the same stream format shares one set of RHI resources and one vertex factory.
+ */
+class FRuntimeMeshArena
+{
+	ERHIFeatureLevel::Type FeatureLevel;
+
+	TArray<TUniquePtr<FRuntimeMeshArenaPage>> Pages;
+
+public:
+	FRuntimeMeshArena(ERHIFeatureLevel::Type InFeatureLevel);
+	~FRuntimeMeshArena();
+
+	/** Reserves space for a section LOD in a page of the matching format, creating a new page if none have room */
+	FRuntimeMeshArenaAllocation Allocate(const FRuntimeMeshArenaFormat& Format, int32 NumVertices, int32 NumIndices, int32 NumAdjacencyIndices);
+
+	/** Releases a section LOD's space, freeing the page once nothing is left in it */
+	void Free(FRuntimeMeshArenaAllocation& Allocation);
+
+	/** Uploads everything written to the pages since the last flush */
+	void Flush();
+
+	int32 NumPages() const { return Pages.Num(); }
+};
+
+using FRuntimeMeshArenaPtr = TSharedPtr<FRuntimeMeshArena, ESPMode::NotThreadSafe>;
@@ -0,0 +1,70 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshBoundsTree.h"
+#include "RuntimeMeshComponentPlugin.h"
+
+
+FRuntimeMeshBoundsTree::FRuntimeMeshBoundsTree()
+	: NumLeaves(0)
+{
+}
+
+bool FRuntimeMeshBoundsTree::Set(int32 Id, const FBox& Box)
+{
+	check(Id >= 0);
+
+	if (Id >= NumLeaves)
+	{
+		// Nothing to clear past the end
+		if (!Box.IsValid)
+		{
+			return false;
+		}
+		Grow(Id + 1);
+	}
+
+	int32 Node = NumLeaves + Id;
+	if (AreBoxesEqual(Nodes[Node], Box))
+	{
+		return false;
+	}
+	Nodes[Node] = Box;
+
+	// Walk up recomputing unions, stopping once a node comes out the same as it was
+	for (Node /= 2; Node >= 1; Node /= 2)
+	{
+		const FBox NewBox = Nodes[Node * 2] + Nodes[Node * 2 + 1];
+		if (AreBoxesEqual(Nodes[Node], NewBox))
+		{
+			break;
+		}
+		Nodes[Node] = NewBox;
+	}
+	return true;
+}
+
+void FRuntimeMeshBoundsTree::Empty()
+{
+	Nodes.Empty();
+	NumLeaves = 0;
+}
+
+void FRuntimeMeshBoundsTree::Grow(int32 MinLeaves)
+{
+	const int32 NewNumLeaves = FMath::RoundUpToPowerOfTwo(FMath::Max(MinLeaves, 8));
+
+	TArray<FBox> NewNodes;
+	NewNodes.Init(FBox(EForceInit::ForceInitToZero), NewNumLeaves * 2);
+	for (int32 Index = 0; Index < NumLeaves; Index++)
+	{
+		NewNodes[NewNumLeaves + Index] = Nodes[NumLeaves + Index];
+	}
+
+	for (int32 Node = NewNumLeaves - 1; Node >= 1; Node--)
+	{
+		NewNodes[Node] = NewNodes[Node * 2] + NewNodes[Node * 2 + 1];
+	}
+
+	Nodes = MoveTemp(NewNodes);
+	NumLeaves = NewNumLeaves;
+}
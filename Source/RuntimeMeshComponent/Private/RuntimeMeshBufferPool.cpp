@@ -0,0 +1,239 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshBufferPool.h"
+#include "RuntimeMeshComponentPlugin.h"
+
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Buffer Pool - Pooled Buffers"), STAT_RuntimeMesh_BufferPool_NumBuffers, STATGROUP_RuntimeMesh);
+DECLARE_MEMORY_STAT(TEXT("Buffer Pool - Pooled Memory"), STAT_RuntimeMesh_BufferPool_Memory, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Buffer Pool - Hits"), STAT_RuntimeMesh_BufferPool_Hits, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Buffer Pool - Misses"), STAT_RuntimeMesh_BufferPool_Misses, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Buffer Pool - Freed"), STAT_RuntimeMesh_BufferPool_Freed, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("Buffer Pool - Tick"), STAT_RuntimeMesh_BufferPool_Tick, STATGROUP_RuntimeMesh);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshBufferPoolEnable(
+	TEXT("r.RuntimeMesh.BufferPool.Enable"),
+	1,
+	TEXT("Whether runtime mesh sections reuse vertex/index buffers through a shared pool."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshBufferPoolRetentionFrames(
+	TEXT("r.RuntimeMesh.BufferPool.RetentionFrames"),
+	300,
+	TEXT("Number of frames an unused buffer is kept in the runtime mesh buffer pool before it's freed."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshBufferPoolMaxSizeMB(
+	TEXT("r.RuntimeMesh.BufferPool.MaxSizeMB"),
+	64,
+	TEXT("Maximum amount of memory in MB held by unused buffers in the runtime mesh buffer pool."),
+	ECVF_RenderThreadSafe);
+
+// Frames a buffer has to sit in the pool before reuse so we don't write into a buffer the GPU may still be reading
+static const uint32 RuntimeMeshBufferPoolSafeFrames = 3;
+
+// Smallest size class, anything smaller is rounded up to this
+static const uint32 RuntimeMeshBufferPoolMinSize = 256;
+
+/*
+ *	Size classes are a quarter of the way between powers of two, so a pooled
+ *	buffer is at most 25% bigger than what was asked for.
+ */
+static uint32 GetPooledBufferSize(uint32 SizeInBytes)
+{
+	SizeInBytes = FMath::Max(SizeInBytes, RuntimeMeshBufferPoolMinSize);
+	const uint32 Step = (1u << FMath::FloorLog2(SizeInBytes)) >> 2;
+	return Align(SizeInBytes, Step);
+}
+
+
+TGlobalResource<FRuntimeMeshBufferPool> GRuntimeMeshBufferPool;
+
+FRuntimeMeshBufferPool::FRuntimeMeshBufferPool()
+	: FTickableObjectRenderThread(false, false)
+	, PooledMemory(0)
+{
+}
+
+FVertexBufferRHIRef FRuntimeMeshBufferPool::AcquireVertexBuffer(uint32 SizeInBytes, uint32 Usage, uint32& OutSizeInBytes)
+{
+	check(IsInRenderingThread());
+
+	if (CVarRuntimeMeshBufferPoolEnable.GetValueOnRenderThread() == 0)
+	{
+		OutSizeInBytes = SizeInBytes;
+		FRHIResourceCreateInfo CreateInfo;
+		return RHICreateVertexBuffer(SizeInBytes, Usage, CreateInfo);
+	}
+
+	OutSizeInBytes = GetPooledBufferSize(SizeInBytes);
+
+	FVertexBufferRHIRef Buffer;
+	if (!FindInPool(VertexBuffers, FPoolKey(OutSizeInBytes, Usage, 0), Buffer))
+	{
+		FRHIResourceCreateInfo CreateInfo;
+		Buffer = RHICreateVertexBuffer(OutSizeInBytes, Usage, CreateInfo);
+	}
+	return Buffer;
+}
+
+FIndexBufferRHIRef FRuntimeMeshBufferPool::AcquireIndexBuffer(uint32 Stride, uint32 SizeInBytes, uint32 Usage, uint32& OutSizeInBytes)
+{
+	check(IsInRenderingThread());
+
+	if (CVarRuntimeMeshBufferPoolEnable.GetValueOnRenderThread() == 0)
+	{
+		OutSizeInBytes = SizeInBytes;
+		FRHIResourceCreateInfo CreateInfo;
+		return RHICreateIndexBuffer(Stride, SizeInBytes, Usage, CreateInfo);
+	}
+
+	// Size classes are always a multiple of 64 bytes so they hold a whole number of indices
+	OutSizeInBytes = GetPooledBufferSize(SizeInBytes);
+
+	FIndexBufferRHIRef Buffer;
+	if (!FindInPool(IndexBuffers, FPoolKey(OutSizeInBytes, Usage, Stride), Buffer))
+	{
+		FRHIResourceCreateInfo CreateInfo;
+		Buffer = RHICreateIndexBuffer(Stride, OutSizeInBytes, Usage, CreateInfo);
+	}
+	return Buffer;
+}
+
+void FRuntimeMeshBufferPool::ReleaseVertexBuffer(FVertexBufferRHIRef& Buffer)
+{
+	check(IsInRenderingThread());
+
+	if (Buffer.IsValid())
+	{
+		AddToPool(VertexBuffers, FPoolKey(Buffer->GetSize(), Buffer->GetUsage(), 0), Buffer);
+	}
+	Buffer.SafeRelease();
+}
+
+void FRuntimeMeshBufferPool::ReleaseIndexBuffer(FIndexBufferRHIRef& Buffer)
+{
+	check(IsInRenderingThread());
+
+	if (Buffer.IsValid())
+	{
+		AddToPool(IndexBuffers, FPoolKey(Buffer->GetSize(), Buffer->GetUsage(), Buffer->GetStride()), Buffer);
+	}
+	Buffer.SafeRelease();
+}
+
+void FRuntimeMeshBufferPool::InitRHI()
+{
+	Register();
+}
+
+void FRuntimeMeshBufferPool::ReleaseRHI()
+{
+	Unregister();
+	Trim(true);
+}
+
+void FRuntimeMeshBufferPool::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_BufferPool_Tick);
+
+	Trim(CVarRuntimeMeshBufferPoolEnable.GetValueOnRenderThread() == 0);
+}
+
+TStatId FRuntimeMeshBufferPool::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FRuntimeMeshBufferPool, STATGROUP_Tickables);
+}
+
+void FRuntimeMeshBufferPool::Trim(bool bForceAll)
+{
+	TrimBuckets(VertexBuffers, bForceAll);
+	TrimBuckets(IndexBuffers, bForceAll);
+}
+
+template<typename BufferRefType>
+void FRuntimeMeshBufferPool::TrimBuckets(TMap<FPoolKey, TArray<TPooledBuffer<BufferRefType>>>& Buckets, bool bForceAll)
+{
+	const uint32 RetentionFrames = FMath::Max(CVarRuntimeMeshBufferPoolRetentionFrames.GetValueOnRenderThread(), 0);
+
+	for (auto It = Buckets.CreateIterator(); It; ++It)
+	{
+		TArray<TPooledBuffer<BufferRefType>>& Bucket = It.Value();
+
+		// Buffers are added to the end as they're released, so the oldest are always at the front
+		int32 NumToRemove = 0;
+		while (NumToRemove < Bucket.Num() && (bForceAll || Bucket[NumToRemove].FrameReleased + RetentionFrames < GFrameNumberRenderThread))
+		{
+			NumToRemove++;
+		}
+
+		if (NumToRemove > 0)
+		{
+			const uint64 FreedMemory = uint64(It.Key().Size) * NumToRemove;
+			PooledMemory -= FreedMemory;
+			DEC_MEMORY_STAT_BY(STAT_RuntimeMesh_BufferPool_Memory, FreedMemory);
+			DEC_DWORD_STAT_BY(STAT_RuntimeMesh_BufferPool_NumBuffers, NumToRemove);
+			INC_DWORD_STAT_BY(STAT_RuntimeMesh_BufferPool_Freed, NumToRemove);
+
+			Bucket.RemoveAt(0, NumToRemove, false);
+		}
+
+		if (Bucket.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+template<typename BufferRefType>
+void FRuntimeMeshBufferPool::AddToPool(TMap<FPoolKey, TArray<TPooledBuffer<BufferRefType>>>& Buckets, const FPoolKey& Key, BufferRefType& Buffer)
+{
+	if (CVarRuntimeMeshBufferPoolEnable.GetValueOnRenderThread() == 0)
+	{
+		return;
+	}
+
+	// Only buffers in a pool size class can be handed back out, anything else is just freed
+	if (Key.Size != GetPooledBufferSize(Key.Size))
+	{
+		return;
+	}
+
+	// Over budget, let this one go instead of holding onto it
+	const uint64 MaxPooledMemory = uint64(FMath::Max(CVarRuntimeMeshBufferPoolMaxSizeMB.GetValueOnRenderThread(), 0)) * 1024 * 1024;
+	if (PooledMemory + Key.Size > MaxPooledMemory)
+	{
+		return;
+	}
+
+	TPooledBuffer<BufferRefType> Entry;
+	Entry.Buffer = Buffer;
+	Entry.FrameReleased = GFrameNumberRenderThread;
+	Buckets.FindOrAdd(Key).Add(Entry);
+
+	PooledMemory += Key.Size;
+	INC_MEMORY_STAT_BY(STAT_RuntimeMesh_BufferPool_Memory, Key.Size);
+	INC_DWORD_STAT(STAT_RuntimeMesh_BufferPool_NumBuffers);
+}
+
+template<typename BufferRefType>
+bool FRuntimeMeshBufferPool::FindInPool(TMap<FPoolKey, TArray<TPooledBuffer<BufferRefType>>>& Buckets, const FPoolKey& Key, BufferRefType& OutBuffer)
+{
+	TArray<TPooledBuffer<BufferRefType>>* Bucket = Buckets.Find(Key);
+
+	// The oldest buffer is at the front, if that one isn't safe to reuse yet none of them are
+	if (Bucket && Bucket->Num() > 0 && (*Bucket)[0].FrameReleased + RuntimeMeshBufferPoolSafeFrames <= GFrameNumberRenderThread)
+	{
+		OutBuffer = (*Bucket)[0].Buffer;
+		Bucket->RemoveAt(0, 1, false);
+
+		PooledMemory -= Key.Size;
+		DEC_MEMORY_STAT_BY(STAT_RuntimeMesh_BufferPool_Memory, Key.Size);
+		DEC_DWORD_STAT(STAT_RuntimeMesh_BufferPool_NumBuffers);
+		INC_DWORD_STAT(STAT_RuntimeMesh_BufferPool_Hits);
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_RuntimeMesh_BufferPool_Misses);
+	return false;
+}
@@ -0,0 +1,90 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshCore.h"
+#include "TickableObjectRenderThread.h"
+
+
+/*
+ *	Render thread pool of RHI vertex/index buffers shared by all runtime mesh sections.
+ *	Buffers are bucketed by usage flags and a size class so sections that are constantly
+ *	created and cleared reuse allocations instead of going back to the RHI each time.
+ */
+class FRuntimeMeshBufferPool : public FRenderResource, public FTickableObjectRenderThread
+{
+	struct FPoolKey
+	{
+		uint32 Size;
+		uint32 Usage;
+		uint32 Stride;
+
+		FPoolKey(uint32 InSize, uint32 InUsage, uint32 InStride)
+			: Size(InSize), Usage(InUsage), Stride(InStride) { }
+
+		bool operator==(const FPoolKey& Other) const
+		{
+			return Size == Other.Size && Usage == Other.Usage && Stride == Other.Stride;
+		}
+
+		friend uint32 GetTypeHash(const FPoolKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Size), GetTypeHash(Key.Usage)), GetTypeHash(Key.Stride));
+		}
+	};
+
+	template<typename BufferRefType>
+	struct TPooledBuffer
+	{
+		BufferRefType Buffer;
+		uint32 FrameReleased;
+	};
+
+	TMap<FPoolKey, TArray<TPooledBuffer<FVertexBufferRHIRef>>> VertexBuffers;
+	TMap<FPoolKey, TArray<TPooledBuffer<FIndexBufferRHIRef>>> IndexBuffers;
+
+	/** Total size of all buffers currently sitting in the pool */
+	uint64 PooledMemory;
+
+public:
+	FRuntimeMeshBufferPool();
+
+	/** Gets a vertex buffer of at least SizeInBytes, OutSizeInBytes is set to the real size of the buffer */
+	FVertexBufferRHIRef AcquireVertexBuffer(uint32 SizeInBytes, uint32 Usage, uint32& OutSizeInBytes);
+
+	/** Gets an index buffer of at least SizeInBytes, OutSizeInBytes is set to the real size of the buffer */
+	FIndexBufferRHIRef AcquireIndexBuffer(uint32 Stride, uint32 SizeInBytes, uint32 Usage, uint32& OutSizeInBytes);
+
+	/** Returns a vertex buffer to the pool, clearing the supplied reference */
+	void ReleaseVertexBuffer(FVertexBufferRHIRef& Buffer);
+
+	/** Returns an index buffer to the pool, clearing the supplied reference */
+	void ReleaseIndexBuffer(FIndexBufferRHIRef& Buffer);
+
+	// FRenderResource interface
+	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+
+	// FTickableObjectRenderThread interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return true; }
+	virtual bool NeedsRenderingResumedForRenderingThreadTick() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** Frees buffers that have been unused past the retention period, or until under the size budget. bForceAll empties the pool */
+	void Trim(bool bForceAll);
+
+	template<typename BufferRefType>
+	void TrimBuckets(TMap<FPoolKey, TArray<TPooledBuffer<BufferRefType>>>& Buckets, bool bForceAll);
+
+	template<typename BufferRefType>
+	void AddToPool(TMap<FPoolKey, TArray<TPooledBuffer<BufferRefType>>>& Buckets, const FPoolKey& Key, BufferRefType& Buffer);
+
+	template<typename BufferRefType>
+	bool FindInPool(TMap<FPoolKey, TArray<TPooledBuffer<BufferRefType>>>& Buckets, const FPoolKey& Key, BufferRefType& OutBuffer);
+};
+
+/** The pool used by all runtime mesh vertex/index buffers */
+extern TGlobalResource<FRuntimeMeshBufferPool> GRuntimeMeshBufferPool;
@@ -785,6 +785,28 @@ FRuntimeMeshBuilder::~FRuntimeMeshBuilder()
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+//	FRuntimeMeshSharedReadonlyAccessor
+
+// The accessor never writes through these, the blocks are only non const to fit the accessor's streams
+FRuntimeMeshSharedReadonlyAccessor::FRuntimeMeshSharedReadonlyAccessor(bool bInTangentsHighPrecision, bool bInUVsHighPrecision, int32 bInUVCount, bool bIn32BitIndices, const FRuntimeMeshSharedStreamDataPtr& InPositionStream,
+	const FRuntimeMeshSharedStreamDataPtr& InTangentStream, const FRuntimeMeshSharedStreamDataPtr& InUVStream, const FRuntimeMeshSharedStreamDataPtr& InColorStream, const FRuntimeMeshSharedStreamDataPtr& InIndexStream)
+	: FRuntimeMeshAccessor(bInTangentsHighPrecision, bInUVsHighPrecision, bInUVCount, bIn32BitIndices, const_cast<TArray<uint8>*>(InPositionStream.Get()), const_cast<TArray<uint8>*>(InTangentStream.Get()),
+		const_cast<TArray<uint8>*>(InUVStream.Get()), const_cast<TArray<uint8>*>(InColorStream.Get()), const_cast<TArray<uint8>*>(InIndexStream.Get()), true)
+	, PositionStream(InPositionStream)
+	, TangentStream(InTangentStream)
+	, UVStream(InUVStream)
+	, ColorStream(InColorStream)
+	, IndexStream(InIndexStream)
+{
+}
+
+FRuntimeMeshSharedReadonlyAccessor::~FRuntimeMeshSharedReadonlyAccessor()
+{
+
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //	FRuntimeMeshScopedUpdater
 
@@ -793,6 +815,7 @@ FRuntimeMeshScopedUpdater::FRuntimeMeshScopedUpdater(const FRuntimeMeshDataPtr&
 	: FRuntimeMeshAccessor(bInTangentsHighPrecision, bInUVsHighPrecision, bInUVCount, bIn32BitIndices, PositionStreamData, TangentStreamData, UVStreamData, ColorStreamData, IndexStreamData, bIsReadonly)
 	, FRuntimeMeshScopeLock(InSyncObject, true)
 	, LinkedMeshData(InLinkedMeshData), SectionIndex(InSectionIndex), LODIndex(InLODIndex), UpdateFlags(InUpdateFlags)
+	, StartingNumVertices(NumVertices()), StartingNumIndices(NumIndices())
 {
 
 }
@@ -804,34 +827,51 @@ FRuntimeMeshScopedUpdater::~FRuntimeMeshScopedUpdater()
 
 void FRuntimeMeshScopedUpdater::Commit(bool bNeedsPositionUpdate, bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate)
 {
-	check(!IsReadonly());
-
-	ERuntimeMeshBuffersToUpdate BuffersToUpdate;
-	BuffersToUpdate |= bNeedsPositionUpdate ? ERuntimeMeshBuffersToUpdate::PositionBuffer : ERuntimeMeshBuffersToUpdate::None;
-	BuffersToUpdate |= bNeedsNormalTangentUpdate ? ERuntimeMeshBuffersToUpdate::TangentBuffer : ERuntimeMeshBuffersToUpdate::None;
-	BuffersToUpdate |= bNeedsColorUpdate ? ERuntimeMeshBuffersToUpdate::ColorBuffer : ERuntimeMeshBuffersToUpdate::None;
-	BuffersToUpdate |= bNeedsUVUpdate ? ERuntimeMeshBuffersToUpdate::UVBuffer : ERuntimeMeshBuffersToUpdate::None;
-	BuffersToUpdate |= bNeedsIndexUpdate ? ERuntimeMeshBuffersToUpdate::IndexBuffer : ERuntimeMeshBuffersToUpdate::None;
+	CommitInternal(GetBuffersToUpdate(bNeedsPositionUpdate, bNeedsNormalTangentUpdate, bNeedsColorUpdate, bNeedsUVUpdate, bNeedsIndexUpdate), 
+		nullptr, FRuntimeMeshStreamRange::All(), FRuntimeMeshStreamRange::All());
+}
 
-	LinkedMeshData->EndSectionUpdate(this, BuffersToUpdate);
+void FRuntimeMeshScopedUpdater::Commit(const FBox& BoundingBox, bool bNeedsPositionUpdate, bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate)
+{
+	CommitInternal(GetBuffersToUpdate(bNeedsPositionUpdate, bNeedsNormalTangentUpdate, bNeedsColorUpdate, bNeedsUVUpdate, bNeedsIndexUpdate),
+		&BoundingBox, FRuntimeMeshStreamRange::All(), FRuntimeMeshStreamRange::All());
+}
 
-	// Release the mesh and lock.
-	FRuntimeMeshAccessor::Unlink();
-	FRuntimeMeshScopeLock::Unlock();
+void FRuntimeMeshScopedUpdater::Commit(const FRuntimeMeshStreamRange& DirtyVertices, const FRuntimeMeshStreamRange& DirtyIndices, bool bNeedsPositionUpdate, 
+	bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate)
+{
+	CommitInternal(GetBuffersToUpdate(bNeedsPositionUpdate, bNeedsNormalTangentUpdate, bNeedsColorUpdate, bNeedsUVUpdate, bNeedsIndexUpdate),
+		nullptr, DirtyVertices, DirtyIndices);
 }
 
-void FRuntimeMeshScopedUpdater::Commit(const FBox& BoundingBox, bool bNeedsPositionUpdate, bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate)
+void FRuntimeMeshScopedUpdater::Commit(const FBox& BoundingBox, const FRuntimeMeshStreamRange& DirtyVertices, const FRuntimeMeshStreamRange& DirtyIndices, 
+	bool bNeedsPositionUpdate, bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate)
 {
-	check(!IsReadonly());
+	CommitInternal(GetBuffersToUpdate(bNeedsPositionUpdate, bNeedsNormalTangentUpdate, bNeedsColorUpdate, bNeedsUVUpdate, bNeedsIndexUpdate),
+		&BoundingBox, DirtyVertices, DirtyIndices);
+}
 
-	ERuntimeMeshBuffersToUpdate BuffersToUpdate;
+ERuntimeMeshBuffersToUpdate FRuntimeMeshScopedUpdater::GetBuffersToUpdate(bool bNeedsPositionUpdate, bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate)
+{
+	ERuntimeMeshBuffersToUpdate BuffersToUpdate = ERuntimeMeshBuffersToUpdate::None;
 	BuffersToUpdate |= bNeedsPositionUpdate ? ERuntimeMeshBuffersToUpdate::PositionBuffer : ERuntimeMeshBuffersToUpdate::None;
 	BuffersToUpdate |= bNeedsNormalTangentUpdate ? ERuntimeMeshBuffersToUpdate::TangentBuffer : ERuntimeMeshBuffersToUpdate::None;
 	BuffersToUpdate |= bNeedsColorUpdate ? ERuntimeMeshBuffersToUpdate::ColorBuffer : ERuntimeMeshBuffersToUpdate::None;
 	BuffersToUpdate |= bNeedsUVUpdate ? ERuntimeMeshBuffersToUpdate::UVBuffer : ERuntimeMeshBuffersToUpdate::None;
 	BuffersToUpdate |= bNeedsIndexUpdate ? ERuntimeMeshBuffersToUpdate::IndexBuffer : ERuntimeMeshBuffersToUpdate::None;
+	return BuffersToUpdate;
+}
+
+void FRuntimeMeshScopedUpdater::CommitInternal(ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FBox* BoundingBox, const FRuntimeMeshStreamRange& DirtyVertices, const FRuntimeMeshStreamRange& DirtyIndices)
+{
+	check(!IsReadonly());
 
-	LinkedMeshData->EndSectionUpdate(this, BuffersToUpdate, &BoundingBox);
+	// A stream that changed length has to be resent whole
+	const FRuntimeMeshStreamRange VertexRange = NumVertices() == StartingNumVertices ? DirtyVertices : FRuntimeMeshStreamRange::All();
+	const FRuntimeMeshStreamRange IndexRange = NumIndices() == StartingNumIndices ? DirtyIndices : FRuntimeMeshStreamRange::All();
+
+	LinkedMeshData->EndSectionUpdate(this, BuffersToUpdate, BoundingBox, VertexRange, IndexRange);
+	LinkedMeshData.Reset();
 
 	// Release the mesh and lock.
 	FRuntimeMeshAccessor::Unlink();
@@ -840,6 +880,13 @@ void FRuntimeMeshScopedUpdater::Commit(const FBox& BoundingBox, bool bNeedsPosit
 
 void FRuntimeMeshScopedUpdater::Cancel()
 {
+	// Still linked means this was never committed, so let the mesh put the section back at rest while we hold the lock
+	if (LinkedMeshData.IsValid())
+	{
+		LinkedMeshData->EndSectionAccess(SectionIndex);
+		LinkedMeshData.Reset();
+	}
+
 	// Release the mesh and lock.
 	FRuntimeMeshAccessor::Unlink();
 	FRuntimeMeshScopeLock::Unlock();
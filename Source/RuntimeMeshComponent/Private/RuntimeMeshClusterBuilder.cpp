@@ -0,0 +1,232 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshClusterBuilder.h"
+#include "RuntimeMeshComponentPlugin.h"
+#include "RuntimeMeshSection.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("RM - Build Clusters"), STAT_RuntimeMesh_BuildClusters, STATGROUP_RuntimeMesh);
+
+// A cluster can be closed early for a tighter normal cone once it has this fraction of the max triangles
+static const int32 RuntimeMeshClusterMinSplitDivisor = 4;
+
+// Triangles facing further than this from the cluster so far, as a cosine, start a new one where allowed
+static const float RuntimeMeshClusterSplitNormalDot = 0.25f;
+
+// Taken off the cone so triangles very close to edge on aren't culled through float error
+static const float RuntimeMeshClusterConeSlack = 0.01f;
+
+
+// Spreads the low 10 bits out to every third bit
+static uint32 SpreadMortonBits(uint32 Value)
+{
+	Value &= 0x3FF;
+	Value = (Value | (Value << 16)) & 0x030000FF;
+	Value = (Value | (Value << 8)) & 0x0300F00F;
+	Value = (Value | (Value << 4)) & 0x030C30C3;
+	Value = (Value | (Value << 2)) & 0x09249249;
+	return Value;
+}
+
+// Reads indices out of the buffer widened to 32 bits
+static void ReadClusterIndices(const FRuntimeMeshSectionIndexBuffer& Buffer, TArray<uint32>& OutIndices)
+{
+	const int32 NumIndices = Buffer.GetNumIndices();
+	OutIndices.SetNumUninitialized(NumIndices);
+
+	if (Buffer.Is32BitIndices())
+	{
+		FMemory::Memcpy(OutIndices.GetData(), Buffer.GetData().GetData(), NumIndices * sizeof(uint32));
+	}
+	else
+	{
+		const uint16* Indices = reinterpret_cast<const uint16*>(Buffer.GetData().GetData());
+		for (int32 Index = 0; Index < NumIndices; Index++)
+		{
+			OutIndices[Index] = Indices[Index];
+		}
+	}
+}
+
+// Writes indices into the buffer in its own format
+static void WriteClusterIndices(FRuntimeMeshSectionIndexBuffer& Buffer, const TArray<uint32>& Indices)
+{
+	TArray<uint8> NewData;
+	NewData.SetNumUninitialized(Indices.Num() * Buffer.GetStride());
+
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		if (Buffer.Is32BitIndices())
+		{
+			reinterpret_cast<uint32*>(NewData.GetData())[Index] = Indices[Index];
+		}
+		else
+		{
+			reinterpret_cast<uint16*>(NewData.GetData())[Index] = (uint16)Indices[Index];
+		}
+	}
+
+	Buffer.SetData(NewData, true);
+}
+
+
+void FRuntimeMeshClusterBuilder::BuildClusters(const TArray<uint32>& Indices, const TArray<FVector>& Positions, int32 MaxTriangles, TArray<uint32>& OutIndices, TArray<FRuntimeMeshCluster>& OutClusters)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_BuildClusters);
+
+	OutIndices.Reset();
+	OutClusters.Reset();
+
+	MaxTriangles = FMath::Max(MaxTriangles, 1);
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (NumTriangles <= MaxTriangles || Indices.Num() % 3 != 0)
+	{
+		return;
+	}
+
+	for (uint32 Index : Indices)
+	{
+		if (Index >= (uint32)Positions.Num())
+		{
+			return;
+		}
+	}
+
+	TArray<FVector> Centers;
+	TArray<FVector> Normals;
+	Centers.SetNumUninitialized(NumTriangles);
+	Normals.SetNumUninitialized(NumTriangles);
+
+	FBox CenterBounds(EForceInit::ForceInit);
+	for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+	{
+		const FVector& P0 = Positions[Indices[Triangle * 3 + 0]];
+		const FVector& P1 = Positions[Indices[Triangle * 3 + 1]];
+		const FVector& P2 = Positions[Indices[Triangle * 3 + 2]];
+
+		Centers[Triangle] = (P0 + P1 + P2) / 3.0f;
+		Normals[Triangle] = FVector::CrossProduct(P1 - P2, P0 - P2).GetSafeNormal();
+		CenterBounds += Centers[Triangle];
+	}
+
+	// Sort along a Morton curve through the centers, so runs of the sorted triangles stay close together
+	const FVector CenterSize = CenterBounds.GetSize();
+	const FVector Scale(
+		CenterSize.X > 0.0f ? 1023.0f / CenterSize.X : 0.0f,
+		CenterSize.Y > 0.0f ? 1023.0f / CenterSize.Y : 0.0f,
+		CenterSize.Z > 0.0f ? 1023.0f / CenterSize.Z : 0.0f);
+
+	TArray<uint64> SortKeys;
+	SortKeys.SetNumUninitialized(NumTriangles);
+	for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+	{
+		const FVector Cell = (Centers[Triangle] - CenterBounds.Min) * Scale;
+		const uint32 Code =
+			SpreadMortonBits((uint32)FMath::Clamp(FMath::FloorToInt(Cell.X), 0, 1023)) |
+			(SpreadMortonBits((uint32)FMath::Clamp(FMath::FloorToInt(Cell.Y), 0, 1023)) << 1) |
+			(SpreadMortonBits((uint32)FMath::Clamp(FMath::FloorToInt(Cell.Z), 0, 1023)) << 2);
+
+		SortKeys[Triangle] = ((uint64)Code << 32) | (uint64)Triangle;
+	}
+	SortKeys.Sort();
+
+	OutIndices.Reserve(Indices.Num());
+	OutClusters.Reserve(FMath::DivideAndRoundUp(NumTriangles, MaxTriangles));
+
+	TArray<int32> ClusterTriangles;
+	ClusterTriangles.Reserve(MaxTriangles);
+	FVector NormalSum = FVector::ZeroVector;
+
+	auto CloseCluster = [&]()
+	{
+		if (ClusterTriangles.Num() == 0)
+		{
+			return;
+		}
+
+		// Back in their existing order, which is usually better for the vertex cache than the curve's
+		ClusterTriangles.Sort();
+
+		FRuntimeMeshCluster& Cluster = OutClusters[OutClusters.AddDefaulted()];
+		Cluster.FirstIndex = OutIndices.Num();
+		Cluster.NumIndices = ClusterTriangles.Num() * 3;
+
+		FBox Bounds(EForceInit::ForceInit);
+		for (int32 Triangle : ClusterTriangles)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 Vertex = Indices[Triangle * 3 + Corner];
+				OutIndices.Add(Vertex);
+				Bounds += Positions[Vertex];
+			}
+		}
+
+		Cluster.BoundsCenter = Bounds.GetCenter();
+		float MaxDistanceSquared = 0.0f;
+		for (int32 Index = Cluster.FirstIndex; Index < Cluster.FirstIndex + Cluster.NumIndices; Index++)
+		{
+			MaxDistanceSquared = FMath::Max(MaxDistanceSquared, FVector::DistSquared(Positions[OutIndices[Index]], Cluster.BoundsCenter));
+		}
+		Cluster.BoundsRadius = FMath::Sqrt(MaxDistanceSquared);
+
+		// Degenerate triangles have no facing, and don't draw anything either
+		const FVector Axis = NormalSum.GetSafeNormal();
+		if (!Axis.IsZero())
+		{
+			float MinDot = 1.0f;
+			for (int32 Triangle : ClusterTriangles)
+			{
+				if (!Normals[Triangle].IsZero())
+				{
+					MinDot = FMath::Min(MinDot, FVector::DotProduct(Normals[Triangle], Axis));
+				}
+			}
+			MinDot -= RuntimeMeshClusterConeSlack;
+
+			Cluster.ConeAxis = Axis;
+			Cluster.ConeCutoff = MinDot > 0.0f ? FMath::Sqrt(1.0f - FMath::Min(MinDot * MinDot, 1.0f)) : 1.0f;
+		}
+
+		ClusterTriangles.Reset();
+		NormalSum = FVector::ZeroVector;
+	};
+
+	const int32 MinSplitTriangles = FMath::Max(MaxTriangles / RuntimeMeshClusterMinSplitDivisor, 1);
+	for (uint64 SortKey : SortKeys)
+	{
+		const int32 Triangle = (int32)(SortKey & 0xFFFFFFFF);
+
+		const bool bFull = ClusterTriangles.Num() >= MaxTriangles;
+		const bool bFacesAway = ClusterTriangles.Num() >= MinSplitTriangles && !Normals[Triangle].IsZero() &&
+			FVector::DotProduct(Normals[Triangle], NormalSum.GetSafeNormal()) < RuntimeMeshClusterSplitNormalDot;
+		if (bFull || bFacesAway)
+		{
+			CloseCluster();
+		}
+
+		ClusterTriangles.Add(Triangle);
+		NormalSum += Normals[Triangle];
+	}
+	CloseCluster();
+}
+
+bool FRuntimeMeshClusterBuilder::ClusterLOD(FRuntimeMeshSectionLODData& LOD, int32 MaxTriangles, TArray<FRuntimeMeshCluster>& OutClusters)
+{
+	TArray<uint32> Indices;
+	ReadClusterIndices(LOD.IndexBuffer, Indices);
+
+	TArray<FVector> Positions;
+	Positions.SetNumUninitialized(LOD.PositionBuffer.GetNumVertices());
+	FMemory::Memcpy(Positions.GetData(), LOD.PositionBuffer.GetData().GetData(), Positions.Num() * sizeof(FVector));
+
+	TArray<uint32> NewIndices;
+	BuildClusters(Indices, Positions, MaxTriangles, NewIndices, OutClusters);
+	if (OutClusters.Num() == 0)
+	{
+		return false;
+	}
+
+	WriteClusterIndices(LOD.IndexBuffer, NewIndices);
+	return true;
+}
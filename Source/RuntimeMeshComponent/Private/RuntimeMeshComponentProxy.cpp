@@ -6,6 +6,28 @@
 #include "RuntimeMeshProxy.h"
 #include "PhysicsEngine/BodySetup.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Dynamic LOD Batches Skipped"), STAT_RuntimeMesh_DynamicLODBatchesSkipped, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Dynamic Section Batches Frustum Culled"), STAT_RuntimeMesh_DynamicSectionBatchesFrustumCulled, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Dynamic Clusters Culled"), STAT_RuntimeMesh_DynamicClustersCulled, STATGROUP_RuntimeMesh);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshDynamicLODSelection(
+	TEXT("r.RuntimeMesh.DynamicLODSelection"),
+	1,
+	TEXT("How the dynamic path picks LODs. 0 submits every LOD and leaves it to their screen sizes, 1 picks one LOD per view."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshSectionFrustumCulling(
+	TEXT("r.RuntimeMesh.SectionFrustumCulling"),
+	1,
+	TEXT("Whether the dynamic path tests the bounds of each section against the view frustum before drawing it."),
+	ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshClusterCulling(
+	TEXT("r.RuntimeMesh.ClusterCulling"),
+	1,
+	TEXT("Whether the dynamic path frustum and backface culls the clusters of sections built with BuildClusters, drawing only the visible ones."),
+	ECVF_RenderThreadSafe);
+
 FRuntimeMeshComponentSceneProxy::FRuntimeMeshComponentSceneProxy(URuntimeMeshComponent* Component) 
 	: FPrimitiveSceneProxy(Component)
 	, BodySetup(Component->GetBodySetup())
@@ -28,7 +50,7 @@ FRuntimeMeshComponentSceneProxy::FRuntimeMeshComponentSceneProxy(URuntimeMeshCom
 			Mat = UMaterial::GetDefaultMaterial(MD_Surface);
 		}
 
-		SectionRenderData.Add(SectionId, FRuntimeMeshSectionRenderData{ Mat, false });
+		SectionRenderData.Add(SectionId, FRuntimeMeshSectionRenderData{ Mat, false, Mat->IsTwoSided() });
 
 		MaterialRelevance |= Mat->GetRelevance(GetScene().GetFeatureLevel());
 	}
@@ -125,8 +147,6 @@ void FRuntimeMeshComponentSceneProxy::CreateMeshBatch(FMeshBatch& MeshBatch, con
 	*/
 
 
-	FMeshBatchElement& BatchElement = MeshBatch.Elements[0];
-
 	MeshBatch.LODIndex = LODIndex;
 #if RUNTIMEMESH_ENABLE_DEBUG_RENDERING
 	MeshBatch.VisualizeLODIndex = LODIndex;
@@ -142,10 +162,14 @@ void FRuntimeMeshComponentSceneProxy::CreateMeshBatch(FMeshBatch& MeshBatch, con
 	MeshBatch.ReverseCulling = IsLocalToWorldDeterminantNegative();
 	MeshBatch.bCanApplyViewModeOverrides = true;
 
-	BatchElement.PrimitiveUniformBufferResource = &GetUniformBuffer();
+	// Sections with segmented indices draw with one element per segment
+	for (FMeshBatchElement& BatchElement : MeshBatch.Elements)
+	{
+		BatchElement.PrimitiveUniformBufferResource = &GetUniformBuffer();
 
-	BatchElement.MaxScreenSize = RuntimeMeshProxy->GetScreenSize(LODIndex);
-	BatchElement.MinScreenSize = RuntimeMeshProxy->GetScreenSize(LODIndex + 1); 
+		BatchElement.MaxScreenSize = RuntimeMeshProxy->GetScreenSize(LODIndex);
+		BatchElement.MinScreenSize = RuntimeMeshProxy->GetScreenSize(LODIndex + 1);
+	}
 
 	return;
 }
@@ -198,6 +222,83 @@ int32 FRuntimeMeshComponentSceneProxy::GetLOD(const FSceneView * View) const
 	return MinLOD;
 }
 
+int32 FRuntimeMeshComponentSceneProxy::GetRenderableLOD(const FRuntimeMeshSectionProxyPtr& Section, int32 LODIndex) const
+{
+	// Sections missing the LOD draw their most detailed one below it instead of nothing
+	for (int32 Index = FMath::Min(LODIndex, Section->NumLODs() - 1); Index >= 0; Index--)
+	{
+		if (Section->GetLOD(Index)->CanRender())
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+const FConvexVolume* FRuntimeMeshComponentSceneProxy::GetSectionCullFrustum(const FSceneView* View, const FRuntimeMeshSectionProxyPtr& Section, bool& bOutIsShadowGather) const
+{
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 22
+	// Shadow depth passes gather with the main view, but give the frustum of the shadow to cull against
+	if (const FConvexVolume* ShadowCullFrustum = View->GetDynamicMeshElementsShadowCullFrustum())
+	{
+		bOutIsShadowGather = true;
+		return ShadowCullFrustum;
+	}
+#else
+	// Shadow depth passes gather with the main view and there's no telling them apart, so shadow casters can't be culled by it
+	if (Section->CastsShadow())
+	{
+		bOutIsShadowGather = true;
+		return nullptr;
+	}
+#endif
+
+	bOutIsShadowGather = false;
+	return &View->ViewFrustum;
+}
+
+bool FRuntimeMeshComponentSceneProxy::IsSectionLODInFrustum(const FConvexVolume& Frustum, const FRuntimeMeshSectionProxyLODData& LOD) const
+{
+	if (!LOD.LocalBounds.IsValid)
+	{
+		return true;
+	}
+
+	const FBox WorldBounds = LOD.LocalBounds.TransformBy(GetLocalToWorld());
+	return Frustum.IntersectBox(WorldBounds.GetCenter(), WorldBounds.GetExtent());
+}
+
+int32 FRuntimeMeshComponentSceneProxy::GatherVisibleClusters(const FConvexVolume& Frustum, const FVector* LocalViewOrigin, const FRuntimeMeshSectionProxyLODData& LOD, FRuntimeMeshClusterRanges& OutRanges) const
+{
+	OutRanges.Reset();
+
+	const FMatrix& LocalToWorld = GetLocalToWorld();
+	const float RadiusScale = LocalToWorld.GetMaximumAxisScale();
+
+	int32 NumCulled = 0;
+	for (const FRuntimeMeshCluster& Cluster : LOD.Clusters)
+	{
+		const bool bVisible = (LocalViewOrigin == nullptr || !Cluster.IsBackfacing(*LocalViewOrigin)) &&
+			Frustum.IntersectSphere(LocalToWorld.TransformPosition(Cluster.BoundsCenter), Cluster.BoundsRadius * RadiusScale);
+		if (!bVisible)
+		{
+			NumCulled++;
+			continue;
+		}
+
+		// Runs of visible clusters draw as a single element
+		if (OutRanges.Num() > 0 && OutRanges.Last().FirstIndex + OutRanges.Last().NumIndices == Cluster.FirstIndex)
+		{
+			OutRanges.Last().NumIndices += Cluster.NumIndices;
+		}
+		else
+		{
+			OutRanges.Add(FRuntimeMeshClusterRange{ Cluster.FirstIndex, Cluster.NumIndices });
+		}
+	}
+	return NumCulled;
+}
+
 void FRuntimeMeshComponentSceneProxy::GetMeshDescription(int32 LODIndex, TArray<FMeshBatch>& OutMeshElements) const
 {
 
@@ -238,6 +339,26 @@ void FRuntimeMeshComponentSceneProxy::GetDynamicMeshElements(const TArray<const
 		Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
 	}
 
+	// Pick the LOD for each view up front, rather than submitting them all for every section and view
+	const bool bSelectLODPerView = CVarRuntimeMeshDynamicLODSelection.GetValueOnRenderThread() != 0;
+	TArray<int32, TInlineAllocator<4>> ViewLODs;
+	if (bSelectLODPerView)
+	{
+		ViewLODs.SetNumUninitialized(Views.Num());
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+		{
+			ViewLODs[ViewIndex] = (VisibilityMap & (1 << ViewIndex)) ? GetLOD(Views[ViewIndex]) : INDEX_NONE;
+		}
+	}
+	int32 NumBatchesSkipped = 0;
+
+	const bool bFrustumCullSections = CVarRuntimeMeshSectionFrustumCulling.GetValueOnRenderThread() != 0;
+	const bool bCullClusters = CVarRuntimeMeshClusterCulling.GetValueOnRenderThread() != 0;
+	const FMatrix WorldToLocal = GetLocalToWorld().InverseFast();
+	FRuntimeMeshClusterRanges ClusterRanges;
+	int32 NumBatchesCulled = 0;
+	int32 NumClustersCulled = 0;
+
 	// Iterate over sections
 	for (const auto& SectionEntry : RuntimeMeshProxy->GetSections())
 	{
@@ -254,7 +375,15 @@ void FRuntimeMeshComponentSceneProxy::GetDynamicMeshElements(const TArray<const
 					if (bForceDynamicPath || !Section->WantsToRenderInStaticPath())
 					{
 						const FRuntimeMeshSectionRenderData& RenderData = SectionRenderData[SectionEntry.Key];
-						FMaterialRenderProxy* Material = RenderData.Material->GetRenderProxy(IsSelected());
+						FMaterialRenderProxy* Material = RenderData.Material->GetRenderProxy(false);
+						const int32 SelectedLOD = bSelectLODPerView ? GetRenderableLOD(Section, ViewLODs[ViewIndex]) : INDEX_NONE;
+
+						bool bIsShadowGather = false;
+						const FConvexVolume* CullFrustum = GetSectionCullFrustum(Views[ViewIndex], Section, bIsShadowGather);
+
+						// Backfaces only say something about perspective views of the mesh itself, not a shadow of it or a two sided material
+						const bool bCullBackfaces = !bIsShadowGather && !bWireframe && !RenderData.bIsTwoSided && Views[ViewIndex]->IsPerspectiveProjection();
+						const FVector LocalViewOrigin = WorldToLocal.TransformPosition(Views[ViewIndex]->ViewMatrices.GetViewOrigin());
 
 						int32 NumLODs = Section->NumLODs();
 						for (int32 LODIndex = 0; LODIndex < NumLODs; LODIndex++)
@@ -262,11 +391,38 @@ void FRuntimeMeshComponentSceneProxy::GetDynamicMeshElements(const TArray<const
 							auto* SectionLOD = Section->GetLOD(LODIndex);
 							if (SectionLOD->CanRender())
 							{
-								const FRuntimeMeshSectionRenderData& RenderData = SectionRenderData[SectionEntry.Key];
-								FMaterialRenderProxy* Material = RenderData.Material->GetRenderProxy(false);
+								if (bSelectLODPerView && LODIndex != SelectedLOD)
+								{
+									NumBatchesSkipped++;
+									continue;
+								}
+
+								// The primitive bounds only say some section is visible, so check this one before paying for its batch
+								if (bFrustumCullSections && CullFrustum && !IsSectionLODInFrustum(*CullFrustum, *SectionLOD))
+								{
+									NumBatchesCulled++;
+									continue;
+								}
+
+								// Big clustered sections only draw the ranges of their triangles that can be seen
+								const bool bWantsAdjacency = !bWireframe && RenderData.bWantsAdjacencyInfo;
+								const bool bDrawClusters = bCullClusters && CullFrustum && SectionLOD->CanDrawClusters(bWantsAdjacency);
+								if (bDrawClusters)
+								{
+									NumClustersCulled += GatherVisibleClusters(*CullFrustum, bCullBackfaces ? &LocalViewOrigin : nullptr, *SectionLOD, ClusterRanges);
+									if (ClusterRanges.Num() == 0)
+									{
+										NumBatchesCulled++;
+										continue;
+									}
+								}
 
 								FMeshBatch& MeshBatch = Collector.AllocateMesh();
 								CreateMeshBatch(MeshBatch, Section, LODIndex, RenderData, Material, WireframeMaterialInstance);
+								if (bDrawClusters)
+								{
+									FRuntimeMeshSectionProxyLODData::ApplyClusterRanges(MeshBatch, ClusterRanges);
+								}
 
 								Collector.AddMesh(ViewIndex, MeshBatch);
 							}
@@ -277,6 +433,10 @@ void FRuntimeMeshComponentSceneProxy::GetDynamicMeshElements(const TArray<const
 		}
 	}
 
+	INC_DWORD_STAT_BY(STAT_RuntimeMesh_DynamicLODBatchesSkipped, NumBatchesSkipped);
+	INC_DWORD_STAT_BY(STAT_RuntimeMesh_DynamicSectionBatchesFrustumCulled, NumBatchesCulled);
+	INC_DWORD_STAT_BY(STAT_RuntimeMesh_DynamicClustersCulled, NumClustersCulled);
+
 	// Draw bounds
 #if RUNTIMEMESH_ENABLE_DEBUG_RENDERING
 	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
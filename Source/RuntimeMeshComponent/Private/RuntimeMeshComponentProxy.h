@@ -17,6 +17,7 @@ private:
 	{
 		UMaterialInterface* Material;
 		bool bWantsAdjacencyInfo;
+		bool bIsTwoSided;
 	};
 
 
@@ -62,6 +63,18 @@ public:
 	/** Returns the LOD that the primitive will render at for this view. */
 	virtual int32 GetLOD(const FSceneView* View) const override;
 
+	/** The LOD a section draws when the given LOD is wanted, which is the closest one it can render at or below it */
+	int32 GetRenderableLOD(const FRuntimeMeshSectionProxyPtr& Section, int32 LODIndex) const;
+
+	/** The frustum the view is gathering the section for, or null if that can't be told */
+	const FConvexVolume* GetSectionCullFrustum(const FSceneView* View, const FRuntimeMeshSectionProxyPtr& Section, bool& bOutIsShadowGather) const;
+
+	/** Does the LOD overlap the frustum. LODs without bounds always do */
+	bool IsSectionLODInFrustum(const FConvexVolume& Frustum, const FRuntimeMeshSectionProxyLODData& LOD) const;
+
+	/** Gets the index ranges of the LOD's clusters in the frustum, and not facing away from the view origin if one is given. Returns how many were culled */
+	int32 GatherVisibleClusters(const FConvexVolume& Frustum, const FVector* LocalViewOrigin, const FRuntimeMeshSectionProxyLODData& LOD, FRuntimeMeshClusterRanges& OutRanges) const;
+
 	/** Gathers a description of the mesh elements to be rendered for the given LOD index, without consideration for views. */
 	virtual void GetMeshDescription(int32 LODIndex, TArray<FMeshBatch>& OutMeshElements) const override;
 
@@ -0,0 +1,243 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshCompression.h"
+#include "RuntimeMeshComponentPlugin.h"
+#include "RuntimeMeshSection.h"
+#include "RuntimeMeshGeometryKernels.h"
+#include "Misc/Compression.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("RM - Compress Section LOD"), STAT_RuntimeMesh_CompressLOD, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Decompress Section LOD"), STAT_RuntimeMesh_DecompressLOD, STATGROUP_RuntimeMesh);
+DECLARE_MEMORY_STAT(TEXT("Compressed Sections - Raw Size"), STAT_RuntimeMesh_Compression_RawSize, STATGROUP_RuntimeMesh);
+DECLARE_MEMORY_STAT(TEXT("Compressed Sections - Stored Size"), STAT_RuntimeMesh_Compression_StoredSize, STATGROUP_RuntimeMesh);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Compressed Sections - Ratio"), STAT_RuntimeMesh_Compression_Ratio, STATGROUP_RuntimeMesh);
+
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 21
+#define RUNTIMEMESH_COMPRESSION_FORMAT NAME_Zlib
+#else
+#define RUNTIMEMESH_COMPRESSION_FORMAT COMPRESS_ZLIB
+#endif
+
+// Running totals over all compressed LODs, only used to keep the ratio stat up to date
+static volatile int64 GRuntimeMeshCompressionRawTotal = 0;
+static volatile int64 GRuntimeMeshCompressionStoredTotal = 0;
+
+static void UpdateCompressionStats(int64 RawDelta, int64 StoredDelta)
+{
+	const int64 RawTotal = FPlatformAtomics::InterlockedAdd(&GRuntimeMeshCompressionRawTotal, RawDelta) + RawDelta;
+	const int64 StoredTotal = FPlatformAtomics::InterlockedAdd(&GRuntimeMeshCompressionStoredTotal, StoredDelta) + StoredDelta;
+
+	if (RawDelta >= 0)
+	{
+		INC_MEMORY_STAT_BY(STAT_RuntimeMesh_Compression_RawSize, RawDelta);
+		INC_MEMORY_STAT_BY(STAT_RuntimeMesh_Compression_StoredSize, StoredDelta);
+	}
+	else
+	{
+		DEC_MEMORY_STAT_BY(STAT_RuntimeMesh_Compression_RawSize, -RawDelta);
+		DEC_MEMORY_STAT_BY(STAT_RuntimeMesh_Compression_StoredSize, -StoredDelta);
+	}
+	SET_FLOAT_STAT(STAT_RuntimeMesh_Compression_Ratio, RawTotal > 0 ? float(double(StoredTotal) / double(RawTotal)) : 0.0f);
+}
+
+
+static void AppendBytes(TArray<uint8>& Out, const void* Data, int32 NumBytes)
+{
+	Out.Append(static_cast<const uint8*>(Data), NumBytes);
+}
+
+static void AppendInt32(TArray<uint8>& Out, int32 Value)
+{
+	AppendBytes(Out, &Value, sizeof(int32));
+}
+
+static int32 ReadInt32(const uint8*& Read)
+{
+	int32 Value;
+	FMemory::Memcpy(&Value, Read, sizeof(int32));
+	Read += sizeof(int32);
+	return Value;
+}
+
+/** Writes each index as the zigzag varint of its difference from the previous one */
+static void AppendIndices(TArray<uint8>& Out, const TArray<uint8>& Indices, bool b32BitIndices)
+{
+	const int32 NumIndices = Indices.Num() / (b32BitIndices ? 4 : 2);
+	int64 Previous = 0;
+	for (int32 Index = 0; Index < NumIndices; Index++)
+	{
+		const int64 Value = b32BitIndices ? int64(reinterpret_cast<const uint32*>(Indices.GetData())[Index]) : int64(reinterpret_cast<const uint16*>(Indices.GetData())[Index]);
+		const int64 Delta = Value - Previous;
+		Previous = Value;
+
+		uint64 ZigZag = (uint64(Delta) << 1) ^ uint64(Delta >> 63);
+		while (ZigZag >= 0x80)
+		{
+			Out.Add(uint8((ZigZag & 0x7F) | 0x80));
+			ZigZag >>= 7;
+		}
+		Out.Add(uint8(ZigZag));
+	}
+}
+
+static void ReadIndices(const uint8*& Read, TArray<uint8>& OutIndices, int32 NumIndices, bool b32BitIndices)
+{
+	OutIndices.SetNumUninitialized(NumIndices * (b32BitIndices ? 4 : 2));
+
+	int64 Previous = 0;
+	for (int32 Index = 0; Index < NumIndices; Index++)
+	{
+		uint64 ZigZag = 0;
+		int32 Shift = 0;
+		uint8 Byte;
+		do
+		{
+			Byte = *Read++;
+			ZigZag |= uint64(Byte & 0x7F) << Shift;
+			Shift += 7;
+		} while (Byte & 0x80);
+
+		const int64 Delta = int64(ZigZag >> 1) ^ -int64(ZigZag & 1);
+		Previous += Delta;
+
+		if (b32BitIndices)
+		{
+			reinterpret_cast<uint32*>(OutIndices.GetData())[Index] = uint32(Previous);
+		}
+		else
+		{
+			reinterpret_cast<uint16*>(OutIndices.GetData())[Index] = uint16(Previous);
+		}
+	}
+}
+
+
+void FRuntimeMeshSectionCompression::CompressLOD(FRuntimeMeshSectionLODData& LOD, FRuntimeMeshCompressedLODData& OutData, const FRuntimeMeshPositionGrid& PreviousGrid)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_CompressLOD);
+
+	const TArray<uint8>& Positions = LOD.PositionBuffer.GetData();
+	const TArray<uint8>& Tangents = LOD.TangentsBuffer.GetData();
+	const TArray<uint8>& UVs = LOD.UVsBuffer.GetData();
+	const TArray<uint8>& Colors = LOD.ColorBuffer.GetData();
+	const TArray<uint8>& Indices = LOD.IndexBuffer.GetData();
+	const TArray<uint8>& AdjacencyIndices = LOD.AdjacencyIndexBuffer.GetData();
+
+	OutData.NumVertices = LOD.PositionBuffer.GetNumVertices();
+	OutData.NumIndices = LOD.IndexBuffer.GetNumIndices();
+	OutData.NumAdjacencyIndices = LOD.AdjacencyIndexBuffer.GetNumIndices();
+	OutData.RawSize = Positions.Num() + Tangents.Num() + UVs.Num() + Colors.Num() + Indices.Num() + AdjacencyIndices.Num();
+
+	TArray<uint8> Packed;
+	Packed.Reserve(OutData.RawSize);
+
+	// The other vertex streams can be empty, so their sizes go first
+	AppendInt32(Packed, Tangents.Num());
+	AppendInt32(Packed, UVs.Num());
+	AppendInt32(Packed, Colors.Num());
+
+	// Quantize positions within their bounds. Positions unpacked from the previous grid are already on it, so
+	// reusing it stores them exactly as before instead of quantizing them again.
+	const FVector* PositionData = reinterpret_cast<const FVector*>(Positions.GetData());
+	const FBox Bounds = FRuntimeMeshGeometryKernels::ComputeBoundingBox(PositionData, OutData.NumVertices);
+	OutData.PositionGrid = PreviousGrid.CanQuantize(Bounds) ? PreviousGrid : FRuntimeMeshPositionGrid(Bounds);
+
+	const FVector& PositionMin = OutData.PositionGrid.Min;
+	const FVector& PositionStep = OutData.PositionGrid.Step;
+	const FVector InvStep(
+		PositionStep.X > 0.0f ? 1.0f / PositionStep.X : 0.0f,
+		PositionStep.Y > 0.0f ? 1.0f / PositionStep.Y : 0.0f,
+		PositionStep.Z > 0.0f ? 1.0f / PositionStep.Z : 0.0f);
+
+	const int32 PositionStart = Packed.AddUninitialized(OutData.NumVertices * 3 * sizeof(uint16));
+	uint16* QuantizedPositions = reinterpret_cast<uint16*>(Packed.GetData() + PositionStart);
+	for (int32 Index = 0; Index < OutData.NumVertices; Index++)
+	{
+		const FVector Offset = (PositionData[Index] - PositionMin) * InvStep;
+		QuantizedPositions[Index * 3 + 0] = uint16(FMath::Clamp(FMath::RoundToInt(Offset.X), 0, 65535));
+		QuantizedPositions[Index * 3 + 1] = uint16(FMath::Clamp(FMath::RoundToInt(Offset.Y), 0, 65535));
+		QuantizedPositions[Index * 3 + 2] = uint16(FMath::Clamp(FMath::RoundToInt(Offset.Z), 0, 65535));
+	}
+
+	AppendBytes(Packed, Tangents.GetData(), Tangents.Num());
+	AppendBytes(Packed, UVs.GetData(), UVs.Num());
+	AppendBytes(Packed, Colors.GetData(), Colors.Num());
+
+	AppendIndices(Packed, Indices, LOD.IndexBuffer.Is32BitIndices());
+	AppendIndices(Packed, AdjacencyIndices, LOD.AdjacencyIndexBuffer.Is32BitIndices());
+
+	// Entropy code the lot, keeping the packed data as is if zlib can't shrink it
+	int32 CompressedSize = FCompression::CompressMemoryBound(RUNTIMEMESH_COMPRESSION_FORMAT, Packed.Num());
+	OutData.Data.SetNumUninitialized(CompressedSize);
+	if (Packed.Num() > 0 && FCompression::CompressMemory(RUNTIMEMESH_COMPRESSION_FORMAT, OutData.Data.GetData(), CompressedSize, Packed.GetData(), Packed.Num()) && CompressedSize < Packed.Num())
+	{
+		OutData.Data.SetNum(CompressedSize, true);
+		OutData.PackedSize = Packed.Num();
+	}
+	else
+	{
+		OutData.Data = MoveTemp(Packed);
+		OutData.PackedSize = INDEX_NONE;
+	}
+
+	LOD.EmptyData();
+
+	UpdateCompressionStats(OutData.RawSize, OutData.Data.GetAllocatedSize());
+}
+
+void FRuntimeMeshSectionCompression::DecompressLOD(FRuntimeMeshCompressedLODData& InData, FRuntimeMeshSectionLODData& LOD)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_DecompressLOD);
+
+	TArray<uint8> Unzipped;
+	if (InData.PackedSize != INDEX_NONE)
+	{
+		Unzipped.SetNumUninitialized(InData.PackedSize);
+		verify(FCompression::UncompressMemory(RUNTIMEMESH_COMPRESSION_FORMAT, Unzipped.GetData(), InData.PackedSize, InData.Data.GetData(), InData.Data.Num()));
+	}
+	const TArray<uint8>& Packed = InData.PackedSize != INDEX_NONE ? Unzipped : InData.Data;
+
+	const uint8* Read = Packed.GetData();
+	const int32 TangentsSize = ReadInt32(Read);
+	const int32 UVsSize = ReadInt32(Read);
+	const int32 ColorsSize = ReadInt32(Read);
+
+	TArray<uint8> Positions;
+	Positions.SetNumUninitialized(InData.NumVertices * sizeof(FVector));
+	FVector* PositionData = reinterpret_cast<FVector*>(Positions.GetData());
+	const uint16* QuantizedPositions = reinterpret_cast<const uint16*>(Read);
+	for (int32 Index = 0; Index < InData.NumVertices; Index++)
+	{
+		PositionData[Index] = InData.PositionGrid.Min + InData.PositionGrid.Step * FVector(QuantizedPositions[Index * 3 + 0], QuantizedPositions[Index * 3 + 1], QuantizedPositions[Index * 3 + 2]);
+	}
+	Read += InData.NumVertices * 3 * sizeof(uint16);
+
+	TArray<uint8> Tangents(Read, TangentsSize);
+	Read += TangentsSize;
+	TArray<uint8> UVs(Read, UVsSize);
+	Read += UVsSize;
+	TArray<uint8> Colors(Read, ColorsSize);
+	Read += ColorsSize;
+
+	TArray<uint8> Indices, AdjacencyIndices;
+	ReadIndices(Read, Indices, InData.NumIndices, LOD.IndexBuffer.Is32BitIndices());
+	ReadIndices(Read, AdjacencyIndices, InData.NumAdjacencyIndices, LOD.AdjacencyIndexBuffer.Is32BitIndices());
+	check(Read == Packed.GetData() + Packed.Num());
+
+	LOD.PositionBuffer.SetData(Positions, true);
+	LOD.TangentsBuffer.SetData(Tangents, true);
+	LOD.UVsBuffer.SetData(UVs, true);
+	LOD.ColorBuffer.SetData(Colors, true);
+	LOD.IndexBuffer.SetData(Indices, true);
+	LOD.AdjacencyIndexBuffer.SetData(AdjacencyIndices, true);
+
+	DiscardCompressedLOD(InData);
+}
+
+void FRuntimeMeshSectionCompression::DiscardCompressedLOD(FRuntimeMeshCompressedLODData& InData)
+{
+	UpdateCompressionStats(-int64(InData.RawSize), -int64(InData.Data.GetAllocatedSize()));
+
+	InData = FRuntimeMeshCompressedLODData();
+}
@@ -8,6 +8,7 @@
 #include "PhysicsEngine/BodySetup.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 #include "RuntimeMeshProxy.h"
+#include "Async/ParallelFor.h"
 
 
 DECLARE_CYCLE_STAT(TEXT("RM - Validation - Create"), STAT_RuntimeMesh_CheckCreate, STATGROUP_RuntimeMesh);
@@ -21,6 +22,8 @@ DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section - MeshBuilder - Move"), STAT_R
 
 DECLARE_CYCLE_STAT(TEXT("RM - Create Mesh Section - Component Buffers"), STAT_RuntimeMesh_CreateMeshSectionFromComponents, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section - Component Buffers"), STAT_RuntimeMesh_UpdateMeshSectionFromComponents, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Create Mesh Sections - Bulk"), STAT_RuntimeMesh_CreateMeshSections, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Sections Created In Bulk"), STAT_RuntimeMesh_SectionsCreatedInBulk, STATGROUP_RuntimeMesh);
 
 DECLARE_CYCLE_STAT(TEXT("RM - Create Mesh Section - Blueprint Packed Buffer"), STAT_RuntimeMesh_CreateMeshSectionPacked_Blueprint, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section - Blueprint Packed Buffer"), STAT_RuntimeMesh_UpdateMeshSectionPacked_Blueprint, STATGROUP_RuntimeMesh);
@@ -57,17 +60,38 @@ DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section - Internal"), STAT_RuntimeMesh
 DECLARE_CYCLE_STAT(TEXT("RM - Handle Common Section Update Flags"), STAT_RuntimeMesh_HandleCommonSectionUpdateFlags, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Handle Common Section Update Flags - Calculate Tangents"), STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_CalculateTangents, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Handle Common Section Update Flags - Calculate Tessellation Indices"), STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_CalculateTessellationIndices, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Handle Common Section Update Flags - Optimize Vertex Cache"), STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_OptimizeVertexCache, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Handle Common Section Update Flags - Weld Vertices"), STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_WeldVertices, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Handle Common Section Update Flags - Build Clusters"), STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_BuildClusters, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Update Section Properties Internal"), STAT_RuntimeMesh_UpdateSectionPropertiesInternal, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Update Local Bounds"), STAT_RuntimeMesh_UpdateLocalBounds, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Update Section Bounds"), STAT_RuntimeMesh_UpdateSectionBounds, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Bounds Notifications"), STAT_RuntimeMesh_BoundsNotifications, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Game Thread Notifications Queued"), STAT_RuntimeMesh_GameThreadNotificationsQueued, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Game Thread Notification Flushes"), STAT_RuntimeMesh_GameThreadNotificationFlushes, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Initialize"), STAT_RuntimeMesh_Initialize, STATGROUP_RuntimeMesh);
 
 DECLARE_CYCLE_STAT(TEXT("RM - Contains Physics Triangle Mesh Data"), STAT_RuntimeMesh_ContainsPhysicsTriMeshData, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Get Physics Triangle Mesh Data"), STAT_RuntimeMesh_GetPhysicsTriMeshData, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Copy Collision Elements to Body Setup"), STAT_RuntimeMesh_CopyCollisionElementsToBodySetup, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Get Section From Collision Face Index"), STAT_RuntimeMesh_GetSectionFromCollisionFaceIndex, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Flush Game Thread Notifications"), STAT_RuntimeMesh_FlushGameThreadNotifications, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Begin Batch"), STAT_RuntimeMesh_BeginBatch, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - End Batch"), STAT_RuntimeMesh_EndBatch, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Batches"), STAT_RuntimeMesh_Batches, STATGROUP_RuntimeMesh);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshVertexCacheAsyncThreshold(
+	TEXT("r.RuntimeMesh.VertexCacheOptimization.AsyncThreshold"),
+	20000,
+	TEXT("Sections with at least this many triangles are optimized for the vertex cache on a worker thread, and sent again once done. 0 always optimizes inline."),
+	ECVF_Default);
 
 FRuntimeMeshData::FRuntimeMeshData()
-	: SyncRoot(new FRuntimeMeshNullLockProvider())
+	: LocalBounds(FVector(0, 0, 0), FVector(0, 0, 0), 0)
+	, PendingNotifications(0)
+	, SyncRoot(new FRuntimeMeshNullLockProvider())
+	, BatchDepth(0)
+	, bBatchBoundsDirty(false)
 {
 }
 
@@ -128,7 +152,7 @@ void FRuntimeMeshData::CheckUpdate(bool bUseHighPrecisionTangents, bool bUseHigh
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_CheckUpdate);
 #if DO_CHECK
-	if (!MeshSections.IsValidIndex(SectionIndex) || !MeshSections[SectionIndex].IsValid())
+	if (!MeshSections.Contains(SectionIndex))
 	{
 		UE_LOG(RuntimeMeshLog, Fatal, TEXT("Mesh Section %d does not exist in RMC."), SectionIndex);
 	}
@@ -163,16 +187,103 @@ void FRuntimeMeshData::CheckBoundingBox(const FBox& Box) const
 #endif
 }
 
+bool FRuntimeMeshData::CheckStreamRange(int32 SectionId, int32 Start, int32 Count, int32 NumElements, bool bIndices) const
+{
+	if (Start < 0 || Count < 0 || Start > NumElements - Count)
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Range %d-%d is outside the %d %s of mesh section %d. Ranged updates can't resize a section, use a full update instead."),
+			Start, Start + Count, NumElements, bIndices ? TEXT("indices") : TEXT("vertices"), SectionId);
+		return false;
+	}
+	return true;
+}
+
+bool FRuntimeMeshData::CheckSectionHasCPUData(int32 SectionId) const
+{
+	check(DoesSectionExist(SectionId));
+
+	if (!MeshSections[SectionId]->HasCPUData())
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only and can't be updated once its data has been released. Recreate the section instead."), SectionId);
+		return false;
+	}
+	return true;
+}
+
 
 
 void FRuntimeMeshData::EnterSerializedMode()
 {
+	// A batch holds the current lock, swapping it out would leave that unbalanced
+	check(!IsBatching());
+
 	if (!SyncRoot->IsThreadSafe())
 	{
 		SyncRoot = MakeUnique<FRuntimeMeshMutexLockProvider>();
 	}
 }
 
+void FRuntimeMeshData::BeginBatch()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_BeginBatch);
+
+	// Held until the matching EndBatch, so no other thread can see the mesh half way through the batch
+	SyncRoot->Lock();
+
+	if (BatchDepth++ == 0)
+	{
+		INC_DWORD_STAT(STAT_RuntimeMesh_Batches);
+
+		BatchRenderProxy = RenderProxy;
+		if (BatchRenderProxy.IsValid())
+		{
+			BatchRenderProxy->BeginBatch_GameThread();
+		}
+	}
+}
+
+void FRuntimeMeshData::EndBatch()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_EndBatch);
+
+	// Taken before looking at the depth, so a thread outside any batch waits for another thread's batch to end first
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+
+	if (BatchDepth == 0)
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("EndBatch called without a matching BeginBatch. Ignoring it."));
+		return;
+	}
+
+	if (--BatchDepth == 0)
+	{
+		if (bBatchBoundsDirty)
+		{
+			bBatchBoundsDirty = false;
+			SetLocalBounds(SectionBounds.GetBounds());
+		}
+
+		if (BatchRenderProxy.IsValid())
+		{
+			BatchRenderProxy->EndBatch_GameThread();
+			BatchRenderProxy.Reset();
+		}
+
+		// Everything the batch held back goes out together
+		if (IsInGameThread())
+		{
+			FlushGameThreadNotifications();
+		}
+		else if (PendingNotifications != 0)
+		{
+			QueueGameThreadNotifications(ERuntimeMeshGameThreadNotifications::None, INDEX_NONE, true);
+		}
+	}
+
+	// Release the hold BeginBatch took
+	SyncRoot->Unlock();
+}
+
 
 
 void FRuntimeMeshData::SetLODScreenSize(int32 LODIndex, float MinScreenSize)
@@ -188,6 +299,21 @@ void FRuntimeMeshData::SetLODScreenSize(int32 LODIndex, float MinScreenSize)
 	//check(LODIndex == 0 || LODScreenSizes[LODIndex] < LODScreenSizes[LODIndex - 1]);
 }
 
+void FRuntimeMeshData::SetVertexWeldTolerances(float PositionTolerance, float TangentTolerance, float UVTolerance)
+{
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+
+	VertexWeldSettings.PositionTolerance = FMath::Max(PositionTolerance, 0.0f);
+	VertexWeldSettings.TangentTolerance = FMath::Max(TangentTolerance, 0.0f);
+	VertexWeldSettings.UVTolerance = FMath::Max(UVTolerance, 0.0f);
+}
+
+FRuntimeMeshVertexWeldSettings FRuntimeMeshData::GetVertexWeldSettings()
+{
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+	return VertexWeldSettings;
+}
+
 void FRuntimeMeshData::SetLODForCollision(int32 LODIndex)
 {
 	LODForCollision = LODIndex;
@@ -305,6 +431,67 @@ void FRuntimeMeshData::UpdateMeshSectionLOD(int32 SectionId, int32 LODIndex, con
 	UpdateSectionInternal(SectionId, LODIndex, BuffersToUpdate, UpdateFlags);
 }
 
+// Everything a LOD generation needs on the worker thread, and what it produces
+struct FRuntimeMeshLODGenerationTask
+{
+	FRuntimeMeshBuilderPtr Source;
+	TArray<float> Ratios;
+	FRuntimeMeshSimplificationSettings Settings;
+	TArray<FRuntimeMeshBuilderPtr> GeneratedLODs;
+};
+
+void FRuntimeMeshData::GenerateSectionLODs(int32 SectionId, const TArray<float>& LODTriangleRatios, const FRuntimeMeshSimplificationSettings& Settings)
+{
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+
+	check(DoesSectionExist(SectionId));
+	FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
+
+	if (!Section->HasCPUData())
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only, LODs can't be generated once its data has been released."), SectionId);
+		return;
+	}
+
+	TArray<float> Ratios = LODTriangleRatios;
+	if (Ratios.Num() > RUNTIMEMESH_MAXLODS - 1)
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Only %d LODs can be generated, ignoring the rest."), RUNTIMEMESH_MAXLODS - 1);
+		Ratios.SetNum(RUNTIMEMESH_MAXLODS - 1);
+	}
+	if (Ratios.Num() == 0)
+	{
+		return;
+	}
+
+	// The builders aren't thread safe shared pointers, so they're only ever referenced through this while in flight
+	TSharedRef<FRuntimeMeshLODGenerationTask, ESPMode::ThreadSafe> Task = MakeShared<FRuntimeMeshLODGenerationTask, ESPMode::ThreadSafe>();
+	Task->Source = Section->CopyLODToBuilder(0);
+	Task->Ratios = MoveTemp(Ratios);
+	Task->Settings = Settings;
+	const uint32 SourceTopologyCrc = Section->GetLODTopologyCrc(0);
+	ReleaseOrCompressSectionData(SectionId);
+
+	TWeakPtr<FRuntimeMeshData, ESPMode::ThreadSafe> WeakMeshData = AsShared();
+	FFunctionGraphTask::CreateAndDispatchWhenReady([WeakMeshData, SectionId, SourceTopologyCrc, Task]()
+	{
+		if (!FRuntimeMeshSimplifier::GenerateLODs(*Task->Source, Task->Ratios, Task->Settings, Task->GeneratedLODs))
+		{
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d LOD 0 isn't a valid triangle list, skipping LOD generation."), SectionId);
+			return;
+		}
+
+		FFunctionGraphTask::CreateAndDispatchWhenReady([WeakMeshData, SectionId, SourceTopologyCrc, Task]()
+		{
+			TSharedPtr<FRuntimeMeshData, ESPMode::ThreadSafe> MeshData = WeakMeshData.Pin();
+			if (MeshData.IsValid())
+			{
+				MeshData->FinishAsyncLODGeneration(SectionId, SourceTopologyCrc, Task->GeneratedLODs);
+			}
+		}, TStatId(), nullptr, ENamedThreads::GameThread);
+	}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
+
 void FRuntimeMeshData::UpdateMeshSectionByMove(int32 SectionId, const TSharedPtr<FRuntimeMeshBuilder>& MeshData, ESectionUpdateFlags UpdateFlags /*= ESectionUpdateFlags::None*/)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateMeshSection_MeshData_Move);
@@ -357,6 +544,12 @@ TUniquePtr<FRuntimeMeshScopedUpdater> FRuntimeMeshData::GetSectionReadonly(int32
 {
 	check(DoesSectionExist(SectionId));
 
+	if (!MeshSections[SectionId]->HasCPUData())
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only and no longer has any data to read."), SectionId);
+		return nullptr;
+	}
+
 	// Enter the lock and then hand this lock to the updater
 	SyncRoot->Lock();
 
@@ -365,13 +558,14 @@ TUniquePtr<FRuntimeMeshScopedUpdater> FRuntimeMeshData::GetSectionReadonly(int32
 	return Section->GetSectionMeshUpdater(this->AsShared(), SectionId, 0, ESectionUpdateFlags::None, SyncRoot.Get(), true);
 }
 
-void FRuntimeMeshData::EndSectionUpdate(FRuntimeMeshScopedUpdater* Updater, ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FBox* BoundingBox /*= nullptr*/)
+void FRuntimeMeshData::EndSectionUpdate(FRuntimeMeshScopedUpdater* Updater, ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FBox* BoundingBox /*= nullptr*/,
+	const FRuntimeMeshStreamRange& VertexRange /*= FRuntimeMeshStreamRange::All()*/, const FRuntimeMeshStreamRange& IndexRange /*= FRuntimeMeshStreamRange::All()*/)
 {
 	check(DoesSectionExist(Updater->SectionIndex));
 
 	FRuntimeMeshSectionPtr Section = MeshSections[Updater->SectionIndex];
 
-	if (Updater->SectionIndex == 0 /*|| !Section->GetBoundingBox().IsValid*/)
+	if (Updater->LODIndex == 0 && !!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::PositionBuffer))
 	{
 		if (BoundingBox)
 		{
@@ -383,22 +577,15 @@ void FRuntimeMeshData::EndSectionUpdate(FRuntimeMeshScopedUpdater* Updater, ERun
 		}
 	}
 
-	UpdateSectionInternal(Updater->SectionIndex, Updater->LODIndex, BuffersToUpdate, Updater->UpdateFlags);
+	UpdateSectionInternal(Updater->SectionIndex, Updater->LODIndex, BuffersToUpdate, Updater->UpdateFlags, VertexRange, IndexRange);
 }
 
-void FRuntimeMeshData::CreateMeshSectionFromComponents(int32 SectionIndex, int32 LODIndex, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, const TArray<FVector>& Normals,
-	const TArray<FVector2D>& UV0, const TArray<FVector2D>& UV1, TFunction<FColor(int32 Index)> ColorAccessor, int32 NumColors,
-	const TArray<FRuntimeMeshTangent>& Tangents, bool bCreateCollision, EUpdateFrequency UpdateFrequency, ESectionUpdateFlags UpdateFlags,
-	bool bUseHighPrecisionTangents, bool bUseHighPrecisionUVs, bool bWantsSecondUV)
+// Copies separate component arrays into a section LOD, defaulting any that are too short
+static void FillSectionFromComponents(const FRuntimeMeshSectionPtr& Section, int32 LODIndex, const TArray<FVector>& Vertices, const TArray<int32>& Triangles,
+	const TArray<FVector>& Normals, const TArray<FVector2D>& UV0, const TArray<FVector2D>& UV1, const TFunction<FColor(int32 Index)>& ColorAccessor, int32 NumColors,
+	const TArray<FRuntimeMeshTangent>& Tangents, bool bWantsSecondUV)
 {
-	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_CreateMeshSectionFromComponents);
-
-	FRuntimeMeshScopeLock Lock(SyncRoot);
-
-	// Create the section
-	auto NewSection = CreateOrResetSectionForBlueprint(SectionIndex, bWantsSecondUV, bUseHighPrecisionTangents, bUseHighPrecisionUVs, UpdateFrequency);
-
-	TSharedPtr<FRuntimeMeshAccessor> MeshData = NewSection->GetSectionMeshAccessor(LODIndex);
+	TSharedPtr<FRuntimeMeshAccessor> MeshData = Section->GetSectionMeshAccessor(LODIndex);
 
 	// We base the size of the mesh data off the vertices/positions
 	MeshData->SetNumVertices(Vertices.Num());
@@ -417,9 +604,24 @@ void FRuntimeMeshData::CreateMeshSectionFromComponents(int32 SectionIndex, int32
 		}
 	}
 
-	NewSection->UpdateIndexBuffer(LODIndex, Triangles);
+	Section->UpdateIndexBuffer(LODIndex, Triangles);
 
-	NewSection->UpdateBoundingBox();
+	Section->UpdateBoundingBox();
+}
+
+void FRuntimeMeshData::CreateMeshSectionFromComponents(int32 SectionIndex, int32 LODIndex, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, const TArray<FVector>& Normals,
+	const TArray<FVector2D>& UV0, const TArray<FVector2D>& UV1, TFunction<FColor(int32 Index)> ColorAccessor, int32 NumColors,
+	const TArray<FRuntimeMeshTangent>& Tangents, bool bCreateCollision, EUpdateFrequency UpdateFrequency, ESectionUpdateFlags UpdateFlags,
+	bool bUseHighPrecisionTangents, bool bUseHighPrecisionUVs, bool bWantsSecondUV)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_CreateMeshSectionFromComponents);
+
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+
+	// Create the section
+	auto NewSection = CreateOrResetSectionForBlueprint(SectionIndex, bWantsSecondUV, bUseHighPrecisionTangents, bUseHighPrecisionUVs, UpdateFrequency);
+
+	FillSectionFromComponents(NewSection, LODIndex, Vertices, Triangles, Normals, UV0, UV1, ColorAccessor, NumColors, Tangents, bWantsSecondUV);
 
 	// Track collision status and update collision information if necessary
 	NewSection->SetCollisionEnabled(bCreateCollision);
@@ -428,6 +630,46 @@ void FRuntimeMeshData::CreateMeshSectionFromComponents(int32 SectionIndex, int32
 	CreateSectionInternal(SectionIndex, UpdateFlags);
 }
 
+void FRuntimeMeshData::CreateMeshSections(TArrayView<const FRuntimeMeshSectionBulkDesc> SectionDescs)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_CreateMeshSections);
+
+	// Everything goes out together at the end, one render command for all the sections and one pass over the bounds
+	FRuntimeMeshScopedBatch Batch(*this);
+
+	TArray<FRuntimeMeshSectionPtr> NewSections;
+	NewSections.SetNum(SectionDescs.Num());
+
+	// New sections aren't shared with anything until they're added to the table, so each can be built on its own thread
+	ParallelFor(SectionDescs.Num(), [&](int32 Index)
+	{
+		const FRuntimeMeshSectionBulkDesc& Desc = SectionDescs[Index];
+		const bool bWantsSecondUV = Desc.UV1.Num() > 0;
+
+		FRuntimeMeshSectionPtr Section = MakeShared<FRuntimeMeshSection, ESPMode::ThreadSafe>(Desc.bUseHighPrecisionTangents, Desc.bUseHighPrecisionUVs,
+			bWantsSecondUV ? 2 : 1, true, Desc.UpdateFrequency);
+
+		FillSectionFromComponents(Section, 0, Desc.Vertices, Desc.Triangles, Desc.Normals, Desc.UV0, Desc.UV1,
+			[&Desc](int32 ColorIndex) { return Desc.Colors[ColorIndex]; }, Desc.Colors.Num(), Desc.Tangents, bWantsSecondUV);
+
+		Section->SetCollisionEnabled(Desc.bCreateCollision);
+
+		ERuntimeMeshBuffersToUpdate BuffersToUpdate = ERuntimeMeshBuffersToUpdate::None;
+		HandleCommonSectionUpdateFlags(Section, Desc.SectionId, 0, Desc.UpdateFlags, BuffersToUpdate);
+
+		NewSections[Index] = Section;
+	});
+
+	// In order, so a repeated id ends up as the last one given like it would with separate creates
+	for (int32 Index = 0; Index < SectionDescs.Num(); Index++)
+	{
+		MeshSections.Add(SectionDescs[Index].SectionId, NewSections[Index]);
+		PublishSectionCreation(SectionDescs[Index].SectionId, SectionDescs[Index].UpdateFlags);
+	}
+
+	INC_DWORD_STAT_BY(STAT_RuntimeMesh_SectionsCreatedInBulk, SectionDescs.Num());
+}
+
 void FRuntimeMeshData::UpdateMeshSectionFromComponents(int32 SectionIndex, int32 LODIndex, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, const TArray<FVector>& Normals,
 	const TArray<FVector2D>& UV0, const TArray<FVector2D>& UV1, TFunction<FColor(int32 Index)> ColorAccessor, int32 NumColors, const TArray<FRuntimeMeshTangent>& Tangents, ESectionUpdateFlags UpdateFlags)
 {
@@ -438,7 +680,7 @@ void FRuntimeMeshData::UpdateMeshSectionFromComponents(int32 SectionIndex, int32
 	// We only check stream 0 and 2 since stream 1 can change based on config, this is potentially dangerous to assume but probably not in practice.
 //	CheckUpdate(GetStreamStructure<FVector>(), GetStreamStructure<FRuntimeMeshNullVertex>(), GetStreamStructure<FColor>(), true, SectionIndex, true, true, false, true);
 
-	FRuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	const FRuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
 
 	ERuntimeMeshBuffersToUpdate BuffersToUpdate = ERuntimeMeshBuffersToUpdate::None;
 	if (Vertices.Num() > 0)
@@ -632,7 +874,7 @@ void FRuntimeMeshData::UpdateMeshSectionPacked_Blueprint(int32 SectionIndex, con
 	// We only check stream 0 and 2 since stream 1 can change based on config, this is potentially dangerous to assume but probably not in practice.
 //	CheckUpdate(GetStreamStructure<FVector>(), GetStreamStructure<FRuntimeMeshNullVertex>(), GetStreamStructure<FColor>(), true, SectionIndex, true, true, false, true);
 
-	FRuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
+	const FRuntimeMeshSectionPtr& Section = MeshSections[SectionIndex];
 
 	ERuntimeMeshBuffersToUpdate BuffersToUpdate = ERuntimeMeshBuffersToUpdate::None;
 	if (Vertices.Num() > 0)
@@ -684,7 +926,16 @@ TSharedPtr<const FRuntimeMeshAccessor> FRuntimeMeshData::GetReadonlyMeshAccessor
 	check(DoesSectionExist(SectionId));
 	FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
 
-	return ConstCastSharedPtr<const FRuntimeMeshAccessor, FRuntimeMeshAccessor>(Section->GetSectionMeshAccessor(0));
+	if (!Section->HasCPUData())
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only and no longer has any data to read."), SectionId);
+		return nullptr;
+	}
+
+	// The accessor keeps its own references to the streams, as it outlives the lock, so the section can go straight back to rest
+	TSharedPtr<const FRuntimeMeshAccessor> Accessor = Section->GetSharedReadonlyAccessor(0);
+	EndSectionAccess(SectionId);
+	return Accessor;
 }
 
 void FRuntimeMeshData::ClearMeshSection(int32 SectionId)
@@ -700,18 +951,14 @@ void FRuntimeMeshData::ClearMeshSection(int32 SectionId)
 		bool bHadCollision = Section->IsCollisionEnabled();
 		bool bWasStaticSection = Section->GetUpdateFrequency() == EUpdateFrequency::Infrequent;
 
-		MeshSections[SectionId].Reset();
+		MeshSections.Remove(SectionId);
 
 		if (RenderProxy.IsValid())
 		{
 			RenderProxy->DeleteSection_GameThread(SectionId);
 		}
 
-		// Strip tailing invalid sections
-		int32 LastValidIndex = GetLastSectionIndex();
-		MeshSections.SetNum(LastValidIndex + 1);
-
-		UpdateLocalBounds();
+		UpdateSectionBounds(SectionId);
 		MarkRenderStateDirty();
 
 		if (bHadCollision)
@@ -763,6 +1010,9 @@ void FRuntimeMeshData::SetMeshSectionVisible(int32 SectionIndex, bool bNewVisibi
 	{
 		MeshSections[SectionIndex]->SetVisible(bNewVisibility);
 
+		// Hidden sections don't count towards the bounds
+		UpdateSectionBounds(SectionIndex);
+
 		// Finish the update
 		UpdateSectionPropertiesInternal(SectionIndex, false);
 	}
@@ -823,6 +1073,12 @@ void FRuntimeMeshData::SetMeshSectionCollisionEnabled(int32 SectionIndex, bool b
 	{
 		bool bWasCollisionEnabled = MeshSections[SectionIndex]->IsCollisionEnabled();
 
+		if (bNewCollisionEnabled && MeshSections[SectionIndex]->IsRenderOnly())
+		{
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only so it can't have collision."), SectionIndex);
+			return;
+		}
+
 		if (bWasCollisionEnabled != bNewCollisionEnabled)
 		{
 			MeshSections[SectionIndex]->SetCollisionEnabled(bNewCollisionEnabled);
@@ -851,14 +1107,14 @@ int32 FRuntimeMeshData::GetNumSections() const
 {
 	FRuntimeMeshScopeLock Lock(SyncRoot);
 
-	return MeshSections.Num();
+	return MeshSections.GetMaxId();
 }
 
 bool FRuntimeMeshData::DoesSectionExist(int32 SectionIndex) const
 {
 	FRuntimeMeshScopeLock Lock(SyncRoot);
 
-	return MeshSections.IsValidIndex(SectionIndex) && MeshSections[SectionIndex].IsValid();
+	return MeshSections.Contains(SectionIndex);
 }
 
 int32 FRuntimeMeshData::GetAvailableSectionIndex() const
@@ -867,28 +1123,14 @@ int32 FRuntimeMeshData::GetAvailableSectionIndex() const
 
 	FRuntimeMeshScopeLock Lock(SyncRoot);
 
-	// TODO: Make this faster. We could do this by tracking a minimum index to search from.
-	for (int32 Index = 0; Index < 10000; Index++)
-	{
-		if (!DoesSectionExist(Index))
-		{
-			return Index;
-		}
-	}
-	return INDEX_NONE;
+	return MeshSections.GetAvailableId();
 }
 
 
 int32 FRuntimeMeshData::GetLastSectionIndex() const
 {
-	for (int32 Index = MeshSections.Num() - 1; Index >= 0; Index--)
-	{
-		if (MeshSections[Index].IsValid())
-		{
-			return Index;
-		}
-	}
-	return INDEX_NONE;
+	// The table never has trailing free ids, so this is always the last section
+	return MeshSections.GetMaxId() - 1;
 }
 
 TArray<int32> FRuntimeMeshData::GetSectionIds() const
@@ -897,15 +1139,10 @@ TArray<int32> FRuntimeMeshData::GetSectionIds() const
 
 	FRuntimeMeshScopeLock Lock(SyncRoot);
 
-	TArray<int32> Sections;
-	for (int32 SectionId = 0; SectionId < MeshSections.Num(); SectionId++)
-	{
-		if (MeshSections[SectionId].IsValid())
-		{
-			Sections.Add(SectionId);
-		}
-	}
-	return Sections;
+	// Callers have always gotten these in order
+	TArray<int32> SectionIds = MeshSections.GetIds();
+	SectionIds.Sort();
+	return SectionIds;
 }
 
 
@@ -1129,11 +1366,7 @@ FRuntimeMeshSectionPtr FRuntimeMeshData::CreateOrResetSection(int32 SectionId, b
 	FRuntimeMeshSectionPtr NewSection = MakeShared<FRuntimeMeshSection, ESPMode::ThreadSafe>(bInUseHighPrecisionTangents, bInUseHighPrecisionUVs, InNumUVs, b32BitIndices, UpdateFrequency/*, LockFactory()*/);
 
 	// Store section at index
-	if (MeshSections.Num() <= SectionId)
-	{
-		MeshSections.SetNum(SectionId + 1);
-	}
-	MeshSections[SectionId] = NewSection;
+	MeshSections.Add(SectionId, NewSection);
 
 	return NewSection;
 }
@@ -1153,26 +1386,39 @@ void FRuntimeMeshData::CreateSectionInternal(int32 SectionId, ESectionUpdateFlag
 	check(DoesSectionExist(SectionId));
 	FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
 
+	// Do any additional processing on the section for this update. This has to happen before
+	// the render thread data is captured so it includes any generated tangents/indices.
+	ERuntimeMeshBuffersToUpdate BuffersToUpdate = ERuntimeMeshBuffersToUpdate::None; // This is ignored for creation as all buffers are updated.
+	HandleCommonSectionUpdateFlags(Section, SectionId, 0, UpdateFlags, BuffersToUpdate);
+
+	PublishSectionCreation(SectionId, UpdateFlags);
+}
+
+void FRuntimeMeshData::PublishSectionCreation(int32 SectionId, ESectionUpdateFlags UpdateFlags)
+{
+	const FRuntimeMeshSectionPtr& Section = MeshSections[SectionId];
+
+	if (!!(UpdateFlags & ESectionUpdateFlags::RenderOnly))
+	{
+		MarkSectionRenderOnly(SectionId);
+	}
+	if (!!(UpdateFlags & ESectionUpdateFlags::CompressCPUData))
+	{
+		Section->SetCompressCPUData(true);
+	}
+
 	// Send section creation to render thread
 	if (RenderProxy.IsValid())
 	{
 		RenderProxy->CreateSection_GameThread(SectionId, Section->GetSectionCreationParams());
 	}
 
-	// Update the combined local bounds		
-	UpdateLocalBounds();
-
-	// Do any additional processing on the section for this update.
-	ERuntimeMeshBuffersToUpdate BuffersToUpdate; // This is ignored for creation as all buffers are updated.
-	HandleCommonSectionUpdateFlags(SectionId, 0, UpdateFlags, BuffersToUpdate);
+	// Update the combined local bounds
+	UpdateSectionBounds(SectionId);
 
 
 	// Send the section creation notification to all linked RMC's
-	DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda(
-		[SectionId](URuntimeMesh* Mesh)
-	{
-		Mesh->SendSectionCreation(SectionId);
-	}));
+	SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications::SectionsCreated, SectionId);
 
 	// Update collision if necessary
 	if (Section->IsCollisionEnabled())
@@ -1180,33 +1426,96 @@ void FRuntimeMeshData::CreateSectionInternal(int32 SectionId, ESectionUpdateFlag
 		MarkCollisionDirty(true);
 	}
 
+	ReleaseOrCompressSectionData(SectionId);
+
 	MarkChanged();
 }
 
-void FRuntimeMeshData::UpdateSectionInternal(int32 SectionId, int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate, ESectionUpdateFlags UpdateFlags)
+void FRuntimeMeshData::UpdateSectionInternal(int32 SectionId, int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate, ESectionUpdateFlags UpdateFlags,
+	const FRuntimeMeshStreamRange& VertexRange /*= FRuntimeMeshStreamRange::All()*/, const FRuntimeMeshStreamRange& IndexRange /*= FRuntimeMeshStreamRange::All()*/)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSectionInternal);
 
 	check(DoesSectionExist(SectionId));
 	FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
 
+	// Whatever was just written only went into a scratch copy, the render thread data can't be partially updated from it
+	if (!Section->HasCPUData())
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only and can't be updated once its data has been released. Recreate the section instead."), SectionId);
+		Section->ReleaseCPUData();
+		return;
+	}
+
+	if (!!(UpdateFlags & ESectionUpdateFlags::RenderOnly))
+	{
+		MarkSectionRenderOnly(SectionId);
+	}
+	if (!!(UpdateFlags & ESectionUpdateFlags::CompressCPUData))
+	{
+		Section->SetCompressCPUData(true);
+	}
+
+	// Do any additional processing on the section for this update. This has to happen before
+	// the render thread data is captured so it includes any generated tangents/indices.
+	HandleCommonSectionUpdateFlags(Section, SectionId, LODIndex, UpdateFlags, BuffersToUpdate);
+
+	// Generated tangents cover the whole mesh, so the dirty range no longer applies
+	const bool bRecalculatedTangents = !!(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangent) || !!(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangentHard);
+
+	// Same for reordering or welding, which move every vertex and triangle
+	const bool bReorderedStreams = !!(UpdateFlags & ESectionUpdateFlags::OptimizeVertexCache) || !!(UpdateFlags & ESectionUpdateFlags::OptimizeOverdraw) ||
+		!!(UpdateFlags & ESectionUpdateFlags::WeldVertices) || !!(UpdateFlags & ESectionUpdateFlags::BuildClusters);
+
 	// Send section update to render thread
 	if (RenderProxy.IsValid())
 	{
-		RenderProxy->UpdateSection_GameThread(SectionId, Section->GetSectionUpdateData(LODIndex, BuffersToUpdate));
+		ERuntimeMeshBuffersToUpdate RenderBuffersToUpdate = BuffersToUpdate;
+		FRuntimeMeshStreamRange RenderVertexRange = (bRecalculatedTangents || bReorderedStreams) ? FRuntimeMeshStreamRange::All() : VertexRange;
+		FRuntimeMeshStreamRange RenderIndexRange = bReorderedStreams ? FRuntimeMeshStreamRange::All() : IndexRange;
+
+		// The render thread may hold the indices re-encoded as 16 bit, if the changed ones no longer fit that they all have to be sent again
+		if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer) && !Section->CanUpdateIndexRangeInPlace(LODIndex, RenderIndexRange))
+		{
+			RenderIndexRange = FRuntimeMeshStreamRange::All();
+		}
+
+		// Locking part of a buffer doesn't keep the rest of it on every RHI (D3D11 discards dynamic buffers, and uploads static ones whole
+		// from fresh scratch memory), so sections with their own buffers always get whole streams. The streams are shared with the update rather
+		// than copied, so this only costs upload bandwidth. Sections in shared buffers are merged into a render thread copy of their page instead.
+		if (!RenderProxy->IsUsingSharedSectionBuffers())
+		{
+			RenderVertexRange = FRuntimeMeshStreamRange::All();
+			RenderIndexRange = FRuntimeMeshStreamRange::All();
+		}
+
+		// Sections in shared buffers may have to move when resized, which needs all their data. So
+		// anything other than a partial update of existing vertices/indices sends the whole LOD.
+		if (RenderProxy->IsUsingSharedSectionBuffers())
+		{
+			const bool bFullVertexUpdate = !!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::AllVertexBuffers) && RenderVertexRange.Covers(Section->GetNumVertices(LODIndex));
+			const bool bFullIndexUpdate = (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer) && RenderIndexRange.Covers(Section->GetNumIndices(LODIndex))) ||
+				!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer);
+
+			if (bFullVertexUpdate || bFullIndexUpdate)
+			{
+				RenderBuffersToUpdate = ERuntimeMeshBuffersToUpdate::AllVertexBuffers | ERuntimeMeshBuffersToUpdate::IndexBuffer | ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer;
+				RenderVertexRange = FRuntimeMeshStreamRange::All();
+				RenderIndexRange = FRuntimeMeshStreamRange::All();
+			}
+		}
+
+		RenderProxy->UpdateSection_GameThread(SectionId, Section->GetSectionUpdateData(LODIndex, RenderBuffersToUpdate, RenderVertexRange, RenderIndexRange));
 	}
 
 	bool bUpdatedLOD0Positions = LODIndex == 0 && (BuffersToUpdate & ERuntimeMeshBuffersToUpdate::PositionBuffer) != ERuntimeMeshBuffersToUpdate::None;
 
-	// Update the combined local bounds		
-	if (true)
+	// Only LOD0 positions feed the bounds, but an index update can also change whether the section renders at all
+	if (bUpdatedLOD0Positions || (LODIndex == 0 && !!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer)))
 	{
-		UpdateLocalBounds();
+		UpdateSectionBounds(SectionId);
 	}
 
-	// Do any additional processing on the section for this update.
-	HandleCommonSectionUpdateFlags(SectionId, LODIndex, UpdateFlags, BuffersToUpdate);
-
 	bool bRequireProxyRecreate = Section->GetUpdateFrequency() == EUpdateFrequency::Infrequent;
 	if (bRequireProxyRecreate)
 	{
@@ -1220,25 +1529,118 @@ void FRuntimeMeshData::UpdateSectionInternal(int32 SectionId, int32 LODIndex, ER
 		MarkCollisionDirty(true);
 	}
 
+	ReleaseOrCompressSectionData(SectionId);
+
 	MarkChanged();
 }
 
-void FRuntimeMeshData::HandleCommonSectionUpdateFlags(int32 SectionIndex, int32 LODIndex, ESectionUpdateFlags UpdateFlags, ERuntimeMeshBuffersToUpdate& BuffersToUpdate)
+void FRuntimeMeshData::MarkSectionRenderOnly(int32 SectionId)
+{
+	FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
+
+	// Collision is cooked from the CPU copy later on, so it can't be kept for a section that's about to drop it
+	if (Section->IsCollisionEnabled())
+	{
+		UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only so it can't have collision. Disabling collision for it."), SectionId);
+		Section->SetCollisionEnabled(false);
+		MarkCollisionDirty(true);
+	}
+
+	Section->SetRenderOnly(true);
+}
+
+void FRuntimeMeshData::ReleaseOrCompressSectionData(int32 SectionId)
+{
+	FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
+
+	if (Section->IsRenderOnly())
+	{
+		// Without a proxy nothing has been sent yet, so hold on to the data until Initialize sends it
+		if (Section->HasCPUData() && RenderProxy.IsValid())
+		{
+			Section->ReleaseCPUData();
+		}
+	}
+	else
+	{
+		Section->CompressData();
+	}
+}
+
+void FRuntimeMeshData::EndSectionAccess(int32 SectionId)
+{
+	if (DoesSectionExist(SectionId))
+	{
+		ReleaseOrCompressSectionData(SectionId);
+	}
+}
+
+void FRuntimeMeshData::HandleCommonSectionUpdateFlags(const FRuntimeMeshSectionPtr& Section, int32 SectionIndex, int32 LODIndex, ESectionUpdateFlags UpdateFlags, ERuntimeMeshBuffersToUpdate& BuffersToUpdate)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_HandleCommonSectionUpdateFlags);
 
-	check(DoesSectionExist(SectionIndex));
+	const bool bCalculateTangents = !!(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangent) || !!(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangentHard);
+	bool bCalculateTessellationIndices = !!(UpdateFlags & ESectionUpdateFlags::CalculateTessellationIndices);
 
-	FRuntimeMeshSectionPtr Section = MeshSections[SectionIndex];
+	// First, so tangents are calculated and vertices reordered on the welded mesh
+	if (!!(UpdateFlags & ESectionUpdateFlags::WeldVertices))
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_WeldVertices);
+
+		FRuntimeMeshVertexWeldSettings Settings = VertexWeldSettings;
+		Settings.bIgnoreTangents = bCalculateTangents;
+
+		const bool bHadTessellationIndices = Section->GetNumAdjacencyIndices(LODIndex) > 0;
+		const FRuntimeMeshVertexWeldResult Result = Section->WeldVertices(LODIndex, Settings);
+		if (Result.ChangedMesh())
+		{
+			UE_LOG(RuntimeMeshLog, Verbose, TEXT("Welded mesh section %d LOD %d from %d to %d vertices, dropping %d degenerate and %d duplicate triangles."),
+				SectionIndex, LODIndex, Result.NumVerticesBefore, Result.NumVerticesAfter, Result.NumDegenerateTriangles, Result.NumDuplicateTriangles);
 
-	if (!!(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangent) || !!(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangentHard))
+			BuffersToUpdate |= ERuntimeMeshBuffersToUpdate::AllVertexBuffers | ERuntimeMeshBuffersToUpdate::IndexBuffer | ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer;
+
+			// Welding drops the tessellation indices as they no longer match the triangles, so rebuild them if there were any
+			bCalculateTessellationIndices |= bHadTessellationIndices;
+		}
+	}
+
+	if (bCalculateTangents)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_CalculateTangents);
 		URuntimeMeshLibrary::CalculateTangentsForMesh(Section->GetSectionMeshAccessor(LODIndex), !(UpdateFlags & ESectionUpdateFlags::CalculateNormalTangentHard));
 		BuffersToUpdate |= ERuntimeMeshBuffersToUpdate::AllVertexBuffers;
 	}
 
-	if (!!(UpdateFlags & ESectionUpdateFlags::CalculateTessellationIndices))
+	// Before the tessellation indices, so they're built from the reordered mesh
+	if (!!(UpdateFlags & ESectionUpdateFlags::OptimizeVertexCache) || !!(UpdateFlags & ESectionUpdateFlags::OptimizeOverdraw))
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_OptimizeVertexCache);
+
+		// Render only sections drop their data once it's sent, so there'd be nothing to apply a late result to. New sections
+		// only get marked render only after this, so the flag has to be checked as well.
+		const bool bAllowAsync = !(UpdateFlags & ESectionUpdateFlags::RenderOnly) && !Section->IsRenderOnly();
+		OptimizeSectionVertexCache(Section, SectionIndex, LODIndex, !!(UpdateFlags & ESectionUpdateFlags::OptimizeOverdraw), bAllowAsync, BuffersToUpdate);
+	}
+
+	if (!!(UpdateFlags & ESectionUpdateFlags::BuildClusters))
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_BuildClusters);
+		if (Section->BuildClusters(LODIndex))
+		{
+			BuffersToUpdate |= ERuntimeMeshBuffersToUpdate::IndexBuffer;
+		}
+		else
+		{
+			Section->ClearClusters(LODIndex);
+		}
+	}
+	else if (!!(BuffersToUpdate & (ERuntimeMeshBuffersToUpdate::PositionBuffer | ERuntimeMeshBuffersToUpdate::IndexBuffer)))
+	{
+		// Whatever changed may have moved triangles out of their clusters
+		Section->ClearClusters(LODIndex);
+	}
+
+	if (bCalculateTessellationIndices)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_HandleCommonSectionUpdateFlags_CalculateTessellationIndices);
 		URuntimeMeshLibrary::GenerateTessellationIndexBuffer(Section->GetSectionMeshAccessor(LODIndex), Section->GetTessellationIndexAccessor(LODIndex));
@@ -1246,6 +1648,133 @@ void FRuntimeMeshData::HandleCommonSectionUpdateFlags(int32 SectionIndex, int32
 	}
 }
 
+void FRuntimeMeshData::OptimizeSectionVertexCache(const FRuntimeMeshSectionPtr& Section, int32 SectionId, int32 LODIndex, bool bOptimizeOverdraw, bool bAllowAsync, ERuntimeMeshBuffersToUpdate& BuffersToUpdate)
+{
+	TSharedRef<FRuntimeMeshVertexCacheOptimizationInput, ESPMode::ThreadSafe> Input = MakeShared<FRuntimeMeshVertexCacheOptimizationInput, ESPMode::ThreadSafe>();
+	Section->GatherVertexCacheOptimizationInput(LODIndex, bOptimizeOverdraw, *Input);
+
+	if (Input->Indices.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 AsyncThreshold = CVarRuntimeMeshVertexCacheAsyncThreshold.GetValueOnAnyThread();
+	const bool bRunAsync = bAllowAsync && AsyncThreshold > 0 && Input->Indices.Num() / 3 >= AsyncThreshold;
+
+	if (!bRunAsync)
+	{
+		FRuntimeMeshVertexCacheOptimization Optimization;
+		if (!FRuntimeMeshVertexCacheOptimizer::Optimize(*Input, bOptimizeOverdraw, Optimization))
+		{
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d LOD %d isn't a valid triangle list, skipping vertex cache optimization."), SectionId, LODIndex);
+			return;
+		}
+
+		if (ApplySectionVertexCacheOptimization(Section, SectionId, LODIndex, *Input, Optimization))
+		{
+			BuffersToUpdate |= ERuntimeMeshBuffersToUpdate::AllVertexBuffers | ERuntimeMeshBuffersToUpdate::IndexBuffer | ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer;
+		}
+		return;
+	}
+
+	// Big sections go out as they are for now, and are sent again once the worker thread is done with them
+	TWeakPtr<FRuntimeMeshData, ESPMode::ThreadSafe> WeakMeshData = AsShared();
+	FFunctionGraphTask::CreateAndDispatchWhenReady([WeakMeshData, SectionId, LODIndex, bOptimizeOverdraw, Input]()
+	{
+		TSharedRef<FRuntimeMeshVertexCacheOptimization, ESPMode::ThreadSafe> Optimization = MakeShared<FRuntimeMeshVertexCacheOptimization, ESPMode::ThreadSafe>();
+		if (!FRuntimeMeshVertexCacheOptimizer::Optimize(*Input, bOptimizeOverdraw, *Optimization))
+		{
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d LOD %d isn't a valid triangle list, skipping vertex cache optimization."), SectionId, LODIndex);
+			return;
+		}
+
+		FFunctionGraphTask::CreateAndDispatchWhenReady([WeakMeshData, SectionId, LODIndex, Input, Optimization]()
+		{
+			TSharedPtr<FRuntimeMeshData, ESPMode::ThreadSafe> MeshData = WeakMeshData.Pin();
+			if (MeshData.IsValid())
+			{
+				MeshData->FinishAsyncVertexCacheOptimization(SectionId, LODIndex, *Input, *Optimization);
+			}
+		}, TStatId(), nullptr, ENamedThreads::GameThread);
+	}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
+
+bool FRuntimeMeshData::ApplySectionVertexCacheOptimization(const FRuntimeMeshSectionPtr& Section, int32 SectionId, int32 LODIndex, const FRuntimeMeshVertexCacheOptimizationInput& Input, const FRuntimeMeshVertexCacheOptimization& Optimization)
+{
+	if (!Section->ApplyVertexCacheOptimization(LODIndex, Input, Optimization))
+	{
+		UE_LOG(RuntimeMeshLog, Verbose, TEXT("Mesh section %d LOD %d changed while it was being optimized for the vertex cache, dropping the result."), SectionId, LODIndex);
+		return false;
+	}
+
+	UE_LOG(RuntimeMeshLog, Verbose, TEXT("Optimized mesh section %d LOD %d for the vertex cache, ACMR %.3f -> %.3f"), SectionId, LODIndex, Optimization.ACMRBefore, Optimization.ACMRAfter);
+	return true;
+}
+
+void FRuntimeMeshData::FinishAsyncLODGeneration(int32 SectionId, uint32 SourceTopologyCrc, const TArray<FRuntimeMeshBuilderPtr>& GeneratedLODs)
+{
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+
+	if (!DoesSectionExist(SectionId) || !MeshSections[SectionId]->HasCPUData())
+	{
+		return;
+	}
+
+	if (MeshSections[SectionId]->GetLODTopologyCrc(0) != SourceTopologyCrc)
+	{
+		UE_LOG(RuntimeMeshLog, Verbose, TEXT("Mesh section %d LOD 0 changed while its LODs were being generated, dropping them."), SectionId);
+		ReleaseOrCompressSectionData(SectionId);
+		return;
+	}
+
+	// LODs left over from an earlier generation with more ratios would otherwise still be drawn. The render thread's
+	// copy of the section can only lose LODs by being created again, so it's resent before the new LODs go over it.
+	const FRuntimeMeshSectionPtr& Section = MeshSections[SectionId];
+	const int32 NumLODs = GeneratedLODs.Num() + 1;
+	if (Section->GetNumLODs() > NumLODs)
+	{
+		Section->RemoveLODsAbove(NumLODs);
+
+		if (RenderProxy.IsValid())
+		{
+			RenderProxy->CreateSection_GameThread(SectionId, Section->GetSectionCreationParams());
+		}
+
+		if (Section->IsCollisionEnabled() && LODForCollision >= NumLODs)
+		{
+			MarkCollisionDirty();
+		}
+	}
+
+	for (int32 Index = 0; Index < GeneratedLODs.Num(); Index++)
+	{
+		UpdateMeshSectionLOD(SectionId, Index + 1, GeneratedLODs[Index]);
+	}
+}
+
+void FRuntimeMeshData::FinishAsyncVertexCacheOptimization(int32 SectionId, int32 LODIndex, const FRuntimeMeshVertexCacheOptimizationInput& Input, const FRuntimeMeshVertexCacheOptimization& Optimization)
+{
+	FRuntimeMeshScopeLock Lock(SyncRoot);
+
+	if (!DoesSectionExist(SectionId))
+	{
+		return;
+	}
+
+	// The new triangle order breaks up any clusters, so build them again on top of it
+	const ESectionUpdateFlags UpdateFlags = MeshSections[SectionId]->HasClusters(LODIndex) ? ESectionUpdateFlags::BuildClusters : ESectionUpdateFlags::None;
+
+	if (!ApplySectionVertexCacheOptimization(MeshSections[SectionId], SectionId, LODIndex, Input, Optimization))
+	{
+		// Checking for changes may have unpacked the section
+		ReleaseOrCompressSectionData(SectionId);
+		return;
+	}
+
+	UpdateSectionInternal(SectionId, LODIndex, ERuntimeMeshBuffersToUpdate::AllVertexBuffers | ERuntimeMeshBuffersToUpdate::IndexBuffer |
+		ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer, UpdateFlags);
+}
+
 void FRuntimeMeshData::UpdateSectionPropertiesInternal(int32 SectionIndex, bool bUpdateRequiresProxyRecreateIfStatic)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSectionPropertiesInternal);
@@ -1285,7 +1814,7 @@ void FRuntimeMeshData::UpdateLODDataInternal()
 	bool bRequiresRecreate = false;
 	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
 	{
-		if (MeshSections[Index]->GetUpdateFrequency() == EUpdateFrequency::Infrequent)
+		if (MeshSections.GetAt(Index)->GetUpdateFrequency() == EUpdateFrequency::Infrequent)
 		{
 			bRequiresRecreate = true;
 		}
@@ -1301,32 +1830,67 @@ void FRuntimeMeshData::UpdateLocalBounds()
 {
 	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateLocalBounds);
 
-	FBox LocalBox(EForceInit::ForceInitToZero);
-
-	for (int32 SectionId = 0; SectionId < MeshSections.Num(); SectionId++)
+	SectionBounds.Empty();
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
 	{
-		FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
-		if (Section.IsValid() && Section->ShouldRender())
+		const FRuntimeMeshSectionPtr& Section = MeshSections.GetAt(Index);
+		if (Section->ShouldRender())
 		{
-			LocalBox += Section->GetBoundingBox();
+			SectionBounds.Set(MeshSections.GetIdAt(Index), Section->GetBoundingBox());
 		}
 	}
 
-	LocalBounds = LocalBox.IsValid ? FBoxSphereBounds(LocalBox) :
+	SetLocalBounds(SectionBounds.GetBounds());
+}
+
+void FRuntimeMeshData::UpdateSectionBounds(int32 SectionId)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateSectionBounds);
+
+	const bool bShouldContribute = MeshSections.Contains(SectionId) && MeshSections[SectionId]->ShouldRender();
+	const bool bChanged = bShouldContribute ? SectionBounds.Set(SectionId, MeshSections[SectionId]->GetBoundingBox()) : SectionBounds.Clear(SectionId);
+
+	if (bChanged)
+	{
+		SetLocalBounds(SectionBounds.GetBounds());
+	}
+}
+
+void FRuntimeMeshData::SetLocalBounds(const FBox& LocalBox)
+{
+	// The section bounds are kept up to date, only the combined bounds wait for the end of the batch
+	if (IsBatching())
+	{
+		bBatchBoundsDirty = true;
+		return;
+	}
+
+	const FBoxSphereBounds NewBounds = LocalBox.IsValid ? FBoxSphereBounds(LocalBox) :
 		FBoxSphereBounds(FVector(0, 0, 0), FVector(0, 0, 0), 0); // fall back to reset box sphere bounds
 
-	DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda(
-		[](URuntimeMesh* Mesh)
+	// Components only need to hear about it when the combined bounds actually moved
+	if (NewBounds.Origin == LocalBounds.Origin && NewBounds.BoxExtent == LocalBounds.BoxExtent && NewBounds.SphereRadius == LocalBounds.SphereRadius)
 	{
-		Mesh->UpdateLocalBounds();
-	}));
+		return;
+	}
+
+	LocalBounds = NewBounds;
+
+	INC_DWORD_STAT(STAT_RuntimeMesh_BoundsNotifications);
+	SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications::BoundsChanged);
 }
 
-FRuntimeMeshProxyPtr FRuntimeMeshData::EnsureProxyCreated(ERHIFeatureLevel::Type InFeatureLevel)
+FRuntimeMeshProxyPtr FRuntimeMeshData::EnsureProxyCreated(ERHIFeatureLevel::Type InFeatureLevel, bool bUseSharedSectionBuffers)
 {
+	// Switching in or out of shared buffers needs a fresh proxy, anything still holding the old one is being recreated
+	if (RenderProxy.IsValid() && RenderProxy->IsUsingSharedSectionBuffers() != bUseSharedSectionBuffers)
+	{
+		RenderProxy.Reset();
+	}
+
 	if (!RenderProxy.IsValid())
 	{
-		RenderProxy = MakeShareable(new FRuntimeMeshProxy(InFeatureLevel), FRuntimeMeshRenderThreadDeleter<FRuntimeMeshProxy>());
+		RenderProxy = MakeShareable(new FRuntimeMeshProxy(InFeatureLevel, bUseSharedSectionBuffers), FRuntimeMeshRenderThreadDeleter<FRuntimeMeshProxy>());
 		Initialize();
 	}
 
@@ -1346,12 +1910,19 @@ void FRuntimeMeshData::Initialize()
 	UpdateLODDataInternal();
 
 	check(RenderProxy.IsValid());
-	for (int32 SectionId = 0; SectionId < MeshSections.Num(); SectionId++)
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
 	{
-		if (MeshSections[SectionId].IsValid())
+		const int32 SectionId = MeshSections.GetIdAt(Index);
+		const FRuntimeMeshSectionPtr& Section = MeshSections.GetAt(Index);
+
+		if (!Section->HasCPUData())
 		{
-			RenderProxy->CreateSection_GameThread(SectionId, MeshSections[SectionId]->GetSectionCreationParams());
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only and can't be sent to a new render proxy. It won't be drawn until it's recreated."), SectionId);
+			continue;
 		}
+
+		RenderProxy->CreateSection_GameThread(SectionId, Section->GetSectionCreationParams());
+		ReleaseOrCompressSectionData(SectionId);
 	}
 }
 
@@ -1361,10 +1932,10 @@ bool FRuntimeMeshData::ContainsPhysicsTriMeshData(bool InUseAllTriData) const
 
 	FRuntimeMeshScopeLock Lock(SyncRoot);
 
-	for (int32 SectionId = 0; SectionId < MeshSections.Num(); SectionId++)
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
 	{
-		FRuntimeMeshSectionPtr Section = MeshSections[SectionId];
-		if (Section.IsValid() && Section->HasValidMeshData() && Section->IsCollisionEnabled())
+		const FRuntimeMeshSectionPtr& Section = MeshSections.GetAt(Index);
+		if (Section->HasCPUData() && Section->HasValidMeshData() && Section->IsCollisionEnabled())
 		{
 			return true;
 		}
@@ -1394,12 +1965,19 @@ bool FRuntimeMeshData::GetPhysicsTriMeshData(struct FTriMeshCollisionData* Colli
 	// See if we should copy UVs
 	bool bCopyUVs = UPhysicsSettings::Get()->bSupportUVFromHitResults;
 
-	for (int32 SectionId = 0; SectionId < MeshSections.Num(); SectionId++)
+	// Remember where each section's faces land so hit faces can be mapped back to sections
+	CollisionSectionFaceRanges.Reset();
+	int32 TotalFaceCount = 0;
+
+	for (int32 SectionIndex = 0; SectionIndex < MeshSections.Num(); SectionIndex++)
 	{
-		if (MeshSections[SectionId].IsValid() && MeshSections[SectionId]->IsCollisionEnabled())
+		const int32 SectionId = MeshSections.GetIdAt(SectionIndex);
+		const FRuntimeMeshSectionPtr& Section = MeshSections.GetAt(SectionIndex);
+		if (Section->IsCollisionEnabled() && Section->HasCPUData())
 		{
 			TArray<FVector2D> UVs;
-			int32 NumTriangles = MeshSections[SectionId]->GetCollisionData(LODForCollision, CollisionData->Vertices, CollisionData->Indices, UVs);
+			int32 NumTriangles = Section->GetCollisionData(LODForCollision, CollisionData->Vertices, CollisionData->Indices, UVs);
+			Section->CompressData();
 
 			if (bCopyUVs)
 			{
@@ -1411,6 +1989,9 @@ bool FRuntimeMeshData::GetPhysicsTriMeshData(struct FTriMeshCollisionData* Colli
 				CollisionData->MaterialIndices.Add(SectionId);
 			}
 
+			TotalFaceCount += NumTriangles;
+			CollisionSectionFaceRanges.Add(TPair<int32, int32>(SectionId, TotalFaceCount));
+
 			// Update the vertex base index
 			bHadCollision = true;
 		}
@@ -1502,42 +2083,19 @@ void FRuntimeMeshData::CopyCollisionElementsToBodySetup(UBodySetup* Setup)
 
 void FRuntimeMeshData::MarkCollisionDirty(bool bSkipChangedFlag)
 {
-	if (bSkipChangedFlag)
-	{
-		DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda(
-			[](URuntimeMesh* Mesh)
-		{
-			Mesh->MarkCollisionDirty();
-		}));
-	}
-	else
-	{
-		DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda(
-			[](URuntimeMesh* Mesh)
-		{
-			Mesh->MarkCollisionDirty();
-			Mesh->MarkChanged();
-		}));
-	}
+	SendGameThreadNotifications(bSkipChangedFlag ? ERuntimeMeshGameThreadNotifications::CollisionDirty :
+		ERuntimeMeshGameThreadNotifications::CollisionDirty | ERuntimeMeshGameThreadNotifications::Changed);
 }
 
 
 void FRuntimeMeshData::MarkRenderStateDirty()
 {
-	DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda(
-		[](URuntimeMesh* Mesh)
-	{
-		Mesh->ForceProxyRecreate();
-	}));
+	SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications::ProxyRecreate);
 }
 
 void FRuntimeMeshData::SendSectionPropertiesUpdate(int32 SectionIndex)
 {
-	DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda(
-		[SectionIndex](URuntimeMesh* Mesh)
-	{
-		Mesh->SendSectionPropertiesUpdate(SectionIndex);
-	}));
+	SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications::SectionsChanged, SectionIndex);
 }
 
 int32 FRuntimeMeshData::GetSectionFromCollisionFaceIndex(int32 FaceIndex) const
@@ -1556,33 +2114,27 @@ int32 FRuntimeMeshData::GetSectionAndFaceFromCollisionFaceIndex(int32& FaceIndex
 
 	FRuntimeMeshScopeLock Lock(SyncRoot);
 
-	int32 SectionIndex = 0;
-
-	// Look for element that corresponds to the supplied face
-	int32 TotalFaceCount = 0;
-
-	for (int32 SectionIdx = 0; SectionIdx < MeshSections.Num(); SectionIdx++)
+	// Find the first section whose faces end past the supplied face
+	int32 Low = 0;
+	int32 High = CollisionSectionFaceRanges.Num();
+	while (Low < High)
 	{
-		const FRuntimeMeshSectionPtr& Section = MeshSections[SectionIdx];
-
-		if (Section.IsValid() && Section->IsCollisionEnabled())
+		const int32 Middle = (Low + High) / 2;
+		if (CollisionSectionFaceRanges[Middle].Value <= FaceIndex)
 		{
-			if (Section->GetNumLODs() == 0) {
-				continue;
-			}
-			int32 NumFaces = Section->GetNumIndices(
-				FMath::Min(LODForCollision, Section->GetNumLODs()-1)
-			) / 3;
-
-			if (FaceIndex < TotalFaceCount + NumFaces)
-			{
-				// Grab the material
-				FaceIndex -= TotalFaceCount;
-				return SectionIdx;
-			}
-			TotalFaceCount += NumFaces;
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
 		}
 	}
+
+	if (FaceIndex >= 0 && Low < CollisionSectionFaceRanges.Num())
+	{
+		FaceIndex -= Low > 0 ? CollisionSectionFaceRanges[Low - 1].Value : 0;
+		return CollisionSectionFaceRanges[Low].Key;
+	}
 	return -1;
 }
 
@@ -1622,31 +2174,172 @@ public:
 };
 
 
-void FRuntimeMeshData::DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate Func)
+void FRuntimeMeshData::SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications Notifications, int32 SectionId)
 {
+	// Batches hold everything back for EndBatch to send
+	if (IsBatching())
+	{
+		QueueGameThreadNotifications(Notifications, SectionId, false);
+		return;
+	}
+
 	if (IsInGameThread())
 	{
-		if (URuntimeMesh* Comp = ParentMeshObject.Get())
+		URuntimeMesh* Mesh = ParentMeshObject.Get();
+		check(Mesh);
+
+		if (!!(Notifications & ERuntimeMeshGameThreadNotifications::ProxyRecreate))
 		{
-			Func.Execute(Comp);
+			Mesh->ForceProxyRecreate();
 		}
-		else
+		if (!!(Notifications & ERuntimeMeshGameThreadNotifications::SectionsCreated))
+		{
+			Mesh->SendSectionCreation(SectionId);
+		}
+		if (!!(Notifications & ERuntimeMeshGameThreadNotifications::SectionsChanged))
+		{
+			Mesh->SendSectionPropertiesUpdate(SectionId);
+		}
+		if (!!(Notifications & ERuntimeMeshGameThreadNotifications::BoundsChanged))
+		{
+			Mesh->UpdateLocalBounds();
+		}
+		if (!!(Notifications & ERuntimeMeshGameThreadNotifications::CollisionDirty))
+		{
+			Mesh->MarkCollisionDirty();
+		}
+		if (!!(Notifications & ERuntimeMeshGameThreadNotifications::Changed))
+		{
+			Mesh->MarkChanged();
+		}
+		return;
+	}
+
+	QueueGameThreadNotifications(Notifications, SectionId, true);
+}
+
+void FRuntimeMeshData::QueueGameThreadNotifications(ERuntimeMeshGameThreadNotifications Notifications, int32 SectionId, bool bScheduleFlush)
+{
+	if (Notifications != ERuntimeMeshGameThreadNotifications::None)
+	{
+		INC_DWORD_STAT(STAT_RuntimeMesh_GameThreadNotificationsQueued);
+	}
+
+	// Sections go in before their flag is set, so any flush that sees the flag also finds them
+	if (!!(Notifications & ERuntimeMeshGameThreadNotifications::SectionsCreated))
+	{
+		PendingCreatedSections.Enqueue(SectionId);
+	}
+	if (!!(Notifications & ERuntimeMeshGameThreadNotifications::SectionsChanged))
+	{
+		PendingChangedSections.Enqueue(SectionId);
+	}
+
+	const int32 NewFlags = (int32)(bScheduleFlush ? Notifications | ERuntimeMeshGameThreadNotifications::FlushScheduled : Notifications);
+	int32 CurrentFlags = PendingNotifications;
+	while (true)
+	{
+		const int32 PreviousFlags = FPlatformAtomics::InterlockedCompareExchange(&PendingNotifications, CurrentFlags | NewFlags, CurrentFlags);
+		if (PreviousFlags == CurrentFlags)
 		{
-			check(false);
+			break;
 		}
+		CurrentFlags = PreviousFlags;
+	}
+
+	// Only whoever sets the scheduled flag dispatches a task, everyone else's notifications ride along with it
+	if (bScheduleFlush && (CurrentFlags & (int32)ERuntimeMeshGameThreadNotifications::FlushScheduled) == 0)
+	{
+		INC_DWORD_STAT(STAT_RuntimeMesh_GameThreadNotificationFlushes);
+
+		TWeakPtr<FRuntimeMeshData, ESPMode::ThreadSafe> WeakMeshData = AsShared();
+		TGraphTask<FRuntimeMeshGameThreadTask>::CreateTask().ConstructAndDispatchWhenReady(ParentMeshObject,
+			FRuntimeMeshGameThreadTaskDelegate::CreateLambda([WeakMeshData](URuntimeMesh* Mesh)
+		{
+			TSharedPtr<FRuntimeMeshData, ESPMode::ThreadSafe> MeshData = WeakMeshData.Pin();
+			if (MeshData.IsValid())
+			{
+				MeshData->FlushGameThreadNotifications();
+			}
+		}));
+	}
+}
+
+void FRuntimeMeshData::FlushGameThreadNotifications()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_FlushGameThreadNotifications);
+	check(IsInGameThread());
+
+	// Anything queued from here on schedules another flush
+	const ERuntimeMeshGameThreadNotifications Notifications = (ERuntimeMeshGameThreadNotifications)FPlatformAtomics::InterlockedExchange(&PendingNotifications, 0);
+
+	TSet<int32> CreatedSections;
+	TSet<int32> ChangedSections;
+	int32 SectionId;
+	while (PendingCreatedSections.Dequeue(SectionId))
+	{
+		CreatedSections.Add(SectionId);
+	}
+	while (PendingChangedSections.Dequeue(SectionId))
+	{
+		ChangedSections.Add(SectionId);
+	}
+
+	URuntimeMesh* Mesh = ParentMeshObject.Get();
+	if (Mesh == nullptr)
+	{
+		return;
+	}
+
+	// Recreating the proxy picks up every section as it is now, so there's nothing to add per section
+	if (!!(Notifications & ERuntimeMeshGameThreadNotifications::ProxyRecreate))
+	{
+		Mesh->ForceProxyRecreate();
 	}
 	else
 	{
-		TGraphTask<FRuntimeMeshGameThreadTask>::CreateTask().ConstructAndDispatchWhenReady(ParentMeshObject, Func);
+		for (int32 CreatedSectionId : CreatedSections)
+		{
+			Mesh->SendSectionCreation(CreatedSectionId);
+		}
+		for (int32 ChangedSectionId : ChangedSections)
+		{
+			if (!CreatedSections.Contains(ChangedSectionId))
+			{
+				Mesh->SendSectionPropertiesUpdate(ChangedSectionId);
+			}
+		}
+	}
+
+	if (!!(Notifications & ERuntimeMeshGameThreadNotifications::BoundsChanged))
+	{
+		Mesh->UpdateLocalBounds();
+	}
+	if (!!(Notifications & ERuntimeMeshGameThreadNotifications::CollisionDirty))
+	{
+		Mesh->MarkCollisionDirty();
+	}
+	if (!!(Notifications & ERuntimeMeshGameThreadNotifications::Changed))
+	{
+		Mesh->MarkChanged();
 	}
 }
 
 void FRuntimeMeshData::MarkChanged()
 {
 #if WITH_EDITOR
-	DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate::CreateLambda([](URuntimeMesh* Mesh)
-	{
-		Mesh->MarkChanged();
-	}));
+	SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications::Changed);
 #endif
 }
+
+void FRuntimeMeshData::WarnOfSectionsThatCantBeSaved() const
+{
+	for (int32 Index = 0; Index < MeshSections.Num(); Index++)
+	{
+		if (!MeshSections.GetAt(Index)->HasCPUData())
+		{
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh section %d is render only and has released its data, so it can't be saved. It will be missing when this mesh is loaded."),
+				MeshSections.GetIdAt(Index));
+		}
+	}
+}
@@ -0,0 +1,367 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshGeometryKernels.h"
+#include "RuntimeMeshComponentPlugin.h"
+#include "Async/ParallelFor.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("RM - Kernels - Bounding Box"), STAT_RuntimeMesh_Kernels_BoundingBox, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Kernels - Bounding Sphere"), STAT_RuntimeMesh_Kernels_BoundingSphere, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Kernels - Transform Positions"), STAT_RuntimeMesh_Kernels_TransformPositions, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Kernels - Plane Distances"), STAT_RuntimeMesh_Kernels_PlaneDistances, STATGROUP_RuntimeMesh);
+
+// Inputs at least this big are split up and run in parallel
+static const int32 RuntimeMeshKernelParallelThreshold = 64 * 1024;
+
+// Number of positions each parallel task handles, kept a multiple of 4 so only the last chunk has a remainder
+static const int32 RuntimeMeshKernelChunkSize = 16 * 1024;
+
+/*
+*	Runs Kernel(Start, Num) across the whole range, in parallel chunks if it's big enough.
+*	Returns the number of chunks so callers with per chunk results know how many there were.
+*/
+template<typename KernelType>
+static int32 RunChunked(int32 NumPositions, KernelType Kernel)
+{
+	if (NumPositions < RuntimeMeshKernelParallelThreshold)
+	{
+		Kernel(0, 0, NumPositions);
+		return 1;
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumPositions, RuntimeMeshKernelChunkSize);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 Start = ChunkIndex * RuntimeMeshKernelChunkSize;
+		Kernel(ChunkIndex, Start, FMath::Min(RuntimeMeshKernelChunkSize, NumPositions - Start));
+	});
+	return NumChunks;
+}
+
+/*
+*	Loads 4 packed positions as 3 registers, laid out as
+*		A = x0 y0 z0 x1,  B = y1 z1 x2 y2,  C = z2 x3 y3 z3
+*/
+FORCEINLINE static void LoadPositions4(const float* Data, VectorRegister& A, VectorRegister& B, VectorRegister& C)
+{
+	A = VectorLoad(Data);
+	B = VectorLoad(Data + 4);
+	C = VectorLoad(Data + 8);
+}
+
+/** Loads 4 packed positions and transposes them into one register per component */
+FORCEINLINE static void LoadPositions4SoA(const float* Data, VectorRegister& X, VectorRegister& Y, VectorRegister& Z)
+{
+	VectorRegister A, B, C;
+	LoadPositions4(Data, A, B, C);
+
+	X = VectorShuffle(A, VectorShuffle(B, C, 2, 2, 1, 1), 0, 3, 0, 2);
+	Y = VectorShuffle(VectorShuffle(A, B, 1, 1, 0, 0), VectorShuffle(B, C, 3, 3, 2, 2), 0, 2, 0, 2);
+	Z = VectorShuffle(VectorShuffle(A, B, 2, 2, 1, 1), VectorShuffle(C, C, 0, 3, 0, 3), 0, 2, 0, 1);
+}
+
+/** Min/max over a run of positions */
+static void ComputeMinMax(const FVector* Positions, int32 NumPositions, FVector& OutMin, FVector& OutMax)
+{
+	// Each lane always sees the same component, following the layout from LoadPositions4
+	VectorRegister MinA = VectorSetFloat1(MAX_flt), MinB = MinA, MinC = MinA;
+	VectorRegister MaxA = VectorSetFloat1(-MAX_flt), MaxB = MaxA, MaxC = MaxA;
+
+	const float* Data = &Positions[0].X;
+	int32 Index = 0;
+	for (; Index + 4 <= NumPositions; Index += 4, Data += 12)
+	{
+		VectorRegister A, B, C;
+		LoadPositions4(Data, A, B, C);
+		MinA = VectorMin(MinA, A); MaxA = VectorMax(MaxA, A);
+		MinB = VectorMin(MinB, B); MaxB = VectorMax(MaxB, B);
+		MinC = VectorMin(MinC, C); MaxC = VectorMax(MaxC, C);
+	}
+
+	// Leftovers go into A, with x copied into the last lane to match its layout
+	for (; Index < NumPositions; Index++, Data += 3)
+	{
+		const VectorRegister V = VectorSwizzle(VectorLoadFloat3(Data), 0, 1, 2, 0);
+		MinA = VectorMin(MinA, V);
+		MaxA = VectorMax(MaxA, V);
+	}
+
+	float Mins[12], Maxs[12];
+	VectorStore(MinA, Mins); VectorStore(MinB, Mins + 4); VectorStore(MinC, Mins + 8);
+	VectorStore(MaxA, Maxs); VectorStore(MaxB, Maxs + 4); VectorStore(MaxC, Maxs + 8);
+
+	// Lane 0 + 3n is x, 1 + 3n is y, 2 + 3n is z
+	OutMin = FVector(Mins[0], Mins[1], Mins[2]);
+	OutMax = FVector(Maxs[0], Maxs[1], Maxs[2]);
+	for (int32 Lane = 3; Lane < 12; Lane += 3)
+	{
+		OutMin = OutMin.ComponentMin(FVector(Mins[Lane], Mins[Lane + 1], Mins[Lane + 2]));
+		OutMax = OutMax.ComponentMax(FVector(Maxs[Lane], Maxs[Lane + 1], Maxs[Lane + 2]));
+	}
+}
+
+/** Largest squared distance from a point over a run of positions */
+static float ComputeMaxDistSquared(const FVector& Center, const FVector* Positions, int32 NumPositions)
+{
+	const VectorRegister CenterX = VectorSetFloat1(Center.X);
+	const VectorRegister CenterY = VectorSetFloat1(Center.Y);
+	const VectorRegister CenterZ = VectorSetFloat1(Center.Z);
+	VectorRegister MaxDistSq = VectorZero();
+
+	const float* Data = &Positions[0].X;
+	int32 Index = 0;
+	for (; Index + 4 <= NumPositions; Index += 4, Data += 12)
+	{
+		VectorRegister X, Y, Z;
+		LoadPositions4SoA(Data, X, Y, Z);
+
+		const VectorRegister DX = VectorSubtract(X, CenterX);
+		const VectorRegister DY = VectorSubtract(Y, CenterY);
+		const VectorRegister DZ = VectorSubtract(Z, CenterZ);
+		const VectorRegister DistSq = VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+		MaxDistSq = VectorMax(MaxDistSq, DistSq);
+	}
+
+	float Lanes[4];
+	VectorStore(MaxDistSq, Lanes);
+	float Result = FMath::Max(FMath::Max(Lanes[0], Lanes[1]), FMath::Max(Lanes[2], Lanes[3]));
+
+	for (; Index < NumPositions; Index++)
+	{
+		Result = FMath::Max(Result, FVector::DistSquared(Positions[Index], Center));
+	}
+	return Result;
+}
+
+
+FBox FRuntimeMeshGeometryKernels::ComputeBoundingBox(const FVector* Positions, int32 NumPositions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Kernels_BoundingBox);
+
+	if (NumPositions <= 0)
+	{
+		return FBox(EForceInit::ForceInitToZero);
+	}
+
+	TArray<FVector, TInlineAllocator<32>> ChunkMins, ChunkMaxs;
+	const int32 MaxChunks = FMath::DivideAndRoundUp(NumPositions, RuntimeMeshKernelChunkSize);
+	ChunkMins.SetNumUninitialized(MaxChunks);
+	ChunkMaxs.SetNumUninitialized(MaxChunks);
+
+	const int32 NumChunks = RunChunked(NumPositions, [&](int32 ChunkIndex, int32 Start, int32 Num)
+	{
+		ComputeMinMax(Positions + Start, Num, ChunkMins[ChunkIndex], ChunkMaxs[ChunkIndex]);
+	});
+
+	FBox Result(ChunkMins[0], ChunkMaxs[0]);
+	for (int32 ChunkIndex = 1; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		Result += FBox(ChunkMins[ChunkIndex], ChunkMaxs[ChunkIndex]);
+	}
+	return Result;
+}
+
+FSphere FRuntimeMeshGeometryKernels::ComputeBoundingSphere(const FVector* Positions, int32 NumPositions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Kernels_BoundingSphere);
+
+	if (NumPositions <= 0)
+	{
+		return FSphere(FVector::ZeroVector, 0.0f);
+	}
+
+	const FVector Center = ComputeBoundingBox(Positions, NumPositions).GetCenter();
+
+	TArray<float, TInlineAllocator<32>> ChunkMaxDistSq;
+	ChunkMaxDistSq.SetNumUninitialized(FMath::DivideAndRoundUp(NumPositions, RuntimeMeshKernelChunkSize));
+
+	const int32 NumChunks = RunChunked(NumPositions, [&](int32 ChunkIndex, int32 Start, int32 Num)
+	{
+		ChunkMaxDistSq[ChunkIndex] = ComputeMaxDistSquared(Center, Positions + Start, Num);
+	});
+
+	float MaxDistSq = 0.0f;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		MaxDistSq = FMath::Max(MaxDistSq, ChunkMaxDistSq[ChunkIndex]);
+	}
+	return FSphere(Center, FMath::Sqrt(MaxDistSq));
+}
+
+void FRuntimeMeshGeometryKernels::TransformPositions(const FMatrix& Matrix, const FVector* InPositions, FVector* OutPositions, int32 NumPositions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Kernels_TransformPositions);
+
+	RunChunked(NumPositions, [&](int32 ChunkIndex, int32 Start, int32 Num)
+	{
+		const float* InData = &InPositions[Start].X;
+		float* OutData = &OutPositions[Start].X;
+		for (int32 Index = 0; Index < Num; Index++, InData += 3, OutData += 3)
+		{
+			// Stores only 3 floats so this never writes into the next position before it's read
+			const VectorRegister Position = VectorLoadFloat3_W1(InData);
+			VectorStoreFloat3(VectorTransformVector(Position, &Matrix), OutData);
+		}
+	});
+}
+
+void FRuntimeMeshGeometryKernels::ComputePlaneDistances(const FPlane& Plane, const FVector* Positions, float* OutDistances, int32 NumPositions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Kernels_PlaneDistances);
+
+	const VectorRegister PlaneX = VectorSetFloat1(Plane.X);
+	const VectorRegister PlaneY = VectorSetFloat1(Plane.Y);
+	const VectorRegister PlaneZ = VectorSetFloat1(Plane.Z);
+	const VectorRegister PlaneW = VectorSetFloat1(-Plane.W);
+
+	RunChunked(NumPositions, [&](int32 ChunkIndex, int32 Start, int32 Num)
+	{
+		const float* Data = &Positions[Start].X;
+		float* OutData = OutDistances + Start;
+
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4, Data += 12)
+		{
+			VectorRegister X, Y, Z;
+			LoadPositions4SoA(Data, X, Y, Z);
+
+			// Same as FPlane::PlaneDot, X*Nx + Y*Ny + Z*Nz - W
+			const VectorRegister Distance = VectorMultiplyAdd(X, PlaneX, VectorMultiplyAdd(Y, PlaneY, VectorMultiplyAdd(Z, PlaneZ, PlaneW)));
+			VectorStore(Distance, OutData + Index);
+		}
+
+		for (; Index < Num; Index++)
+		{
+			OutData[Index] = Plane.PlaneDot(Positions[Start + Index]);
+		}
+	});
+}
+
+
+
+#if !UE_BUILD_SHIPPING
+
+/*
+*	RuntimeMesh.BenchmarkKernels [NumPositions] [Iterations]
+*	Times each kernel against the plain scalar loop it replaces, over the same random positions, and checks they agree.
+*/
+static void BenchmarkRuntimeMeshKernels(const TArray<FString>& Args)
+{
+	const int32 NumPositions = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000003;
+	const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+
+	FRandomStream Random(0x52554E4D);
+	TArray<FVector> Positions;
+	Positions.SetNumUninitialized(NumPositions);
+	for (FVector& Position : Positions)
+	{
+		Position = FVector(Random.FRandRange(-1000.0f, 1000.0f), Random.FRandRange(-1000.0f, 1000.0f), Random.FRandRange(-1000.0f, 1000.0f));
+	}
+
+	const FMatrix Matrix = FTransform(FRotator(30.0f, 45.0f, 60.0f), FVector(10.0f, -20.0f, 30.0f), FVector(1.5f, 0.5f, 2.0f)).ToMatrixWithScale();
+	const FPlane Plane(FVector(1.0f, 2.0f, 3.0f).GetSafeNormal(), 25.0f);
+
+	// Orders of operations differ, so only matching to float precision for the size of the values
+	auto NearlyEqual = [](float A, float B)
+	{
+		return FMath::Abs(A - B) <= 1.0e-5f * FMath::Max(1.0f, FMath::Max(FMath::Abs(A), FMath::Abs(B)));
+	};
+
+	auto Time = [Iterations](TFunctionRef<void()> Function)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Function();
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+	};
+
+	auto Report = [](const TCHAR* Name, double ScalarMs, double KernelMs, bool bMatches)
+	{
+		UE_LOG(RuntimeMeshLog, Display, TEXT("%-20s scalar %8.3f ms  kernel %8.3f ms  (%5.2fx)  %s"), Name, ScalarMs, KernelMs,
+			KernelMs > 0.0 ? ScalarMs / KernelMs : 0.0, bMatches ? TEXT("matches") : TEXT("MISMATCH"));
+	};
+
+	UE_LOG(RuntimeMeshLog, Display, TEXT("Benchmarking geometry kernels over %d positions, %d iterations"), NumPositions, Iterations);
+
+	// Bounding box, min and max are exact so these have to be identical
+	{
+		FBox ScalarBox(EForceInit::ForceInitToZero), KernelBox(EForceInit::ForceInitToZero);
+		const double ScalarMs = Time([&]() { ScalarBox = FBox(Positions.GetData(), NumPositions); });
+		const double KernelMs = Time([&]() { KernelBox = FRuntimeMeshGeometryKernels::ComputeBoundingBox(Positions.GetData(), NumPositions); });
+		Report(TEXT("ComputeBoundingBox"), ScalarMs, KernelMs, ScalarBox.Min == KernelBox.Min && ScalarBox.Max == KernelBox.Max);
+	}
+
+	// Bounding sphere
+	{
+		FSphere ScalarSphere(0), KernelSphere(0);
+		const double ScalarMs = Time([&]()
+		{
+			const FVector Center = FBox(Positions.GetData(), NumPositions).GetCenter();
+			float MaxDistSq = 0.0f;
+			for (const FVector& Position : Positions)
+			{
+				MaxDistSq = FMath::Max(MaxDistSq, FVector::DistSquared(Position, Center));
+			}
+			ScalarSphere = FSphere(Center, FMath::Sqrt(MaxDistSq));
+		});
+		const double KernelMs = Time([&]() { KernelSphere = FRuntimeMeshGeometryKernels::ComputeBoundingSphere(Positions.GetData(), NumPositions); });
+		Report(TEXT("ComputeBoundingSphere"), ScalarMs, KernelMs, ScalarSphere.Center == KernelSphere.Center && NearlyEqual(ScalarSphere.W, KernelSphere.W));
+	}
+
+	// Transform
+	{
+		TArray<FVector> ScalarOut, KernelOut;
+		ScalarOut.SetNumUninitialized(NumPositions);
+		KernelOut.SetNumUninitialized(NumPositions);
+		const double ScalarMs = Time([&]()
+		{
+			for (int32 Index = 0; Index < NumPositions; Index++)
+			{
+				ScalarOut[Index] = Matrix.TransformPosition(Positions[Index]);
+			}
+		});
+		const double KernelMs = Time([&]() { FRuntimeMeshGeometryKernels::TransformPositions(Matrix, Positions.GetData(), KernelOut.GetData(), NumPositions); });
+
+		// Components can cancel down to near zero, so compare against the size of the terms rather than the result
+		const float MaxScale = Matrix.GetMaximumAxisScale();
+		const float MaxOffset = Matrix.GetOrigin().GetAbsMax();
+		bool bMatches = true;
+		for (int32 Index = 0; Index < NumPositions && bMatches; Index++)
+		{
+			bMatches = ScalarOut[Index].Equals(KernelOut[Index], 1.0e-5f * (Positions[Index].GetAbsMax() * MaxScale * 3.0f + MaxOffset));
+		}
+		Report(TEXT("TransformPositions"), ScalarMs, KernelMs, bMatches);
+	}
+
+	// Plane distances
+	{
+		TArray<float> ScalarOut, KernelOut;
+		ScalarOut.SetNumUninitialized(NumPositions);
+		KernelOut.SetNumUninitialized(NumPositions);
+		const double ScalarMs = Time([&]()
+		{
+			for (int32 Index = 0; Index < NumPositions; Index++)
+			{
+				ScalarOut[Index] = Plane.PlaneDot(Positions[Index]);
+			}
+		});
+		const double KernelMs = Time([&]() { FRuntimeMeshGeometryKernels::ComputePlaneDistances(Plane, Positions.GetData(), KernelOut.GetData(), NumPositions); });
+
+		// Same for the distances
+		bool bMatches = true;
+		for (int32 Index = 0; Index < NumPositions && bMatches; Index++)
+		{
+			bMatches = FMath::Abs(ScalarOut[Index] - KernelOut[Index]) <= 1.0e-5f * (Positions[Index].GetAbsMax() * 3.0f + FMath::Abs(Plane.W));
+		}
+		Report(TEXT("ComputePlaneDistances"), ScalarMs, KernelMs, bMatches);
+	}
+}
+
+static FAutoConsoleCommand CmdRuntimeMeshBenchmarkKernels(
+	TEXT("RuntimeMesh.BenchmarkKernels"),
+	TEXT("Times the geometry kernels against the equivalent scalar loops and checks the results match. Args: [NumPositions] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkRuntimeMeshKernels));
+
+#endif
@@ -4,9 +4,75 @@
 #include "RuntimeMeshComponentPlugin.h"
 #include "RuntimeMesh.h"
 
-FRuntimeMeshProxy::FRuntimeMeshProxy(ERHIFeatureLevel::Type InFeatureLevel)
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Section Updates Superseded"), STAT_RuntimeMesh_SectionUpdatesSuperseded, STATGROUP_RuntimeMesh);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RM - Batched Section Commands"), STAT_RuntimeMesh_BatchedSectionCommands, STATGROUP_RuntimeMesh);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshCoalesceSectionUpdates(
+	TEXT("r.RuntimeMesh.CoalesceSectionUpdates"),
+	1,
+	TEXT("Whether a section update waiting for the render thread is dropped when a newer one replaces all of its buffers."),
+	ECVF_Default);
+
+
+void FRuntimeMeshPendingSectionCommands::Add(FRuntimeMeshPendingSectionCommand&& Command)
+{
+	check(Command.Type != ERuntimeMeshPendingSectionCommandType::Update);
+	Commands.Add(MoveTemp(Command));
+}
+
+int32 FRuntimeMeshPendingSectionCommands::AddUpdate(int32 SectionId, const FRuntimeMeshSectionUpdateParamsPtr& Update, bool bSupersede)
+{
+	int32 NumSuperseded = 0;
+	for (int32 Index = Commands.Num() - 1; Index >= 0 && bSupersede; Index--)
+	{
+		FRuntimeMeshPendingSectionCommand& Pending = Commands[Index];
+
+		// Anything before the section was last created or deleted belongs to a different section
+		const bool bIsCreateOrDelete = Pending.Type == ERuntimeMeshPendingSectionCommandType::Create || Pending.Type == ERuntimeMeshPendingSectionCommandType::Delete;
+		if (bIsCreateOrDelete && (Pending.SectionId == SectionId || Pending.SectionId == INDEX_NONE))
+		{
+			break;
+		}
+
+		if (Pending.Type == ERuntimeMeshPendingSectionCommandType::Update && Pending.SectionId == SectionId && Pending.UpdateParams.IsValid() &&
+			Pending.UpdateParams->LODIndex == Update->LODIndex && Supersedes(*Update, *Pending.UpdateParams))
+		{
+			Pending.UpdateParams.Reset();
+			NumSuperseded++;
+		}
+	}
+
+	FRuntimeMeshPendingSectionCommand& Command = Commands[Commands.Emplace(ERuntimeMeshPendingSectionCommandType::Update, SectionId)];
+	Command.UpdateParams = Update;
+	return NumSuperseded;
+}
+
+bool FRuntimeMeshPendingSectionCommands::Supersedes(const FRuntimeMeshSectionUpdateParams& Newer, const FRuntimeMeshSectionUpdateParams& Older)
+{
+	if ((Older.BuffersToUpdate & ~Newer.BuffersToUpdate) != ERuntimeMeshBuffersToUpdate::None)
+	{
+		return false;
+	}
+
+	// Partial updates only hold part of a buffer, so they need whatever came before them
+	const ERuntimeMeshBuffersToUpdate Buffers = Newer.BuffersToUpdate;
+	return !(!!(Buffers & ERuntimeMeshBuffersToUpdate::PositionBuffer) && Newer.PositionVertexBuffer.bIsPartialUpdate) &&
+		!(!!(Buffers & ERuntimeMeshBuffersToUpdate::TangentBuffer) && Newer.TangentsVertexBuffer.bIsPartialUpdate) &&
+		!(!!(Buffers & ERuntimeMeshBuffersToUpdate::UVBuffer) && Newer.UVsVertexBuffer.bIsPartialUpdate) &&
+		!(!!(Buffers & ERuntimeMeshBuffersToUpdate::ColorBuffer) && Newer.ColorVertexBuffer.bIsPartialUpdate) &&
+		!(!!(Buffers & ERuntimeMeshBuffersToUpdate::IndexBuffer) && Newer.IndexBuffer.bIsPartialUpdate);
+}
+
+
+FRuntimeMeshProxy::FRuntimeMeshProxy(ERHIFeatureLevel::Type InFeatureLevel, bool bInUseSharedSectionBuffers)
 	: FeatureLevel(InFeatureLevel)
+	, bUseSharedSectionBuffers(bInUseSharedSectionBuffers)
+	, BatchDepth(0)
 {
+	if (bUseSharedSectionBuffers)
+	{
+		Arena = MakeShareable(new FRuntimeMeshArena(InFeatureLevel));
+	}
 }
 
 FRuntimeMeshProxy::~FRuntimeMeshProxy()
@@ -33,6 +99,17 @@ float FRuntimeMeshProxy::GetScreenSize(int32 LODIndex) const
 
 void FRuntimeMeshProxy::CreateSection_GameThread(int32 SectionId, const FRuntimeMeshSectionCreationParamsPtr& SectionData)
 {
+	if (IsBatching_GameThread())
+	{
+		FRuntimeMeshPendingSectionCommand Command(ERuntimeMeshPendingSectionCommandType::Create, SectionId);
+		Command.CreationParams = SectionData;
+		PendingCommands->Add(MoveTemp(Command));
+		return;
+	}
+
+	// Updates sent after this are for the new section, so they can't go in ahead of it with the pending ones
+	PendingCommands.Reset();
+
 	ENQUEUE_UNIQUE_RENDER_COMMAND_THREEPARAMETER(
 		FRuntimeMeshProxyCreateSection,
 		FRuntimeMeshProxy*, MeshProxy, this,
@@ -40,6 +117,7 @@ void FRuntimeMeshProxy::CreateSection_GameThread(int32 SectionId, const FRuntime
 		FRuntimeMeshSectionCreationParamsPtr, SectionData, SectionData,
 		{
 			MeshProxy->CreateSection_RenderThread(SectionId, SectionData);
+			MeshProxy->FlushArena_RenderThread();
 		}
 	);
 }
@@ -49,7 +127,7 @@ void FRuntimeMeshProxy::CreateSection_RenderThread(int32 SectionId, const FRunti
 	check(IsInRenderingThread());
 	check(SectionData.IsValid());
 
-	FRuntimeMeshSectionProxyPtr NewSection = MakeShareable(new FRuntimeMeshSectionProxy(FeatureLevel, SectionData),
+	FRuntimeMeshSectionProxyPtr NewSection = MakeShareable(new FRuntimeMeshSectionProxy(FeatureLevel, SectionData, Arena),
 		FRuntimeMeshRenderThreadDeleter<FRuntimeMeshSectionProxy>());
 
 	// Add the section to the map, destroying any one that existed
@@ -61,13 +139,50 @@ void FRuntimeMeshProxy::CreateSection_RenderThread(int32 SectionId, const FRunti
 
 void FRuntimeMeshProxy::UpdateSection_GameThread(int32 SectionId, const FRuntimeMeshSectionUpdateParamsPtr& SectionData)
 {
-	ENQUEUE_UNIQUE_RENDER_COMMAND_THREEPARAMETER(
-		FRuntimeMeshProxyUpdateSection,
+	const bool bCoalesce = CVarRuntimeMeshCoalesceSectionUpdates.GetValueOnAnyThread() != 0;
+
+	if (IsBatching_GameThread())
+	{
+		INC_DWORD_STAT_BY(STAT_RuntimeMesh_SectionUpdatesSuperseded, PendingCommands->AddUpdate(SectionId, SectionData, bCoalesce));
+		return;
+	}
+
+	if (!bCoalesce)
+	{
+		PendingCommands.Reset();
+		ENQUEUE_UNIQUE_RENDER_COMMAND_THREEPARAMETER(
+			FRuntimeMeshProxyUpdateSection,
+			FRuntimeMeshProxy*, MeshProxy, this,
+			int32, SectionId, SectionId,
+			FRuntimeMeshSectionUpdateParamsPtr, SectionData, SectionData,
+			{
+				MeshProxy->UpdateSection_RenderThread(SectionId, SectionData);
+				MeshProxy->FlushArena_RenderThread();
+			}
+		);
+		return;
+	}
+
+	// Join the commands already on their way if the render thread hasn't taken them yet
+	if (PendingCommands.IsValid())
+	{
+		FScopeLock Lock(&PendingCommands->Lock);
+		if (!PendingCommands->bDrained)
+		{
+			INC_DWORD_STAT_BY(STAT_RuntimeMesh_SectionUpdatesSuperseded, PendingCommands->AddUpdate(SectionId, SectionData, true));
+			return;
+		}
+	}
+
+	PendingCommands = MakeShared<FRuntimeMeshPendingSectionCommands, ESPMode::ThreadSafe>();
+	PendingCommands->AddUpdate(SectionId, SectionData, true);
+
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FRuntimeMeshProxyApplyPendingCommands,
 		FRuntimeMeshProxy*, MeshProxy, this,
-		int32, SectionId, SectionId,
-		FRuntimeMeshSectionUpdateParamsPtr, SectionData, SectionData,
+		FRuntimeMeshPendingSectionCommandsPtr, Commands, PendingCommands,
 		{
-			MeshProxy->UpdateSection_RenderThread(SectionId, SectionData);
+			MeshProxy->ApplyPendingCommands_RenderThread(Commands);
 		}
 	);
 }
@@ -87,8 +202,55 @@ void FRuntimeMeshProxy::UpdateSection_RenderThread(int32 SectionId, const FRunti
 	}
 }
 
+void FRuntimeMeshProxy::ApplyPendingCommands_RenderThread(const FRuntimeMeshPendingSectionCommandsPtr& Commands)
+{
+	check(IsInRenderingThread());
+
+	TArray<FRuntimeMeshPendingSectionCommand> CommandsToApply;
+	{
+		FScopeLock Lock(&Commands->Lock);
+		Commands->bDrained = true;
+		CommandsToApply = MoveTemp(Commands->Commands);
+	}
+
+	for (const FRuntimeMeshPendingSectionCommand& Command : CommandsToApply)
+	{
+		switch (Command.Type)
+		{
+		case ERuntimeMeshPendingSectionCommandType::Create:
+			CreateSection_RenderThread(Command.SectionId, Command.CreationParams);
+			break;
+		case ERuntimeMeshPendingSectionCommandType::Update:
+			if (!Command.IsSuperseded())
+			{
+				UpdateSection_RenderThread(Command.SectionId, Command.UpdateParams);
+			}
+			break;
+		case ERuntimeMeshPendingSectionCommandType::UpdateProperties:
+			UpdateSectionProperties_RenderThread(Command.SectionId, Command.PropertyParams);
+			break;
+		case ERuntimeMeshPendingSectionCommandType::Delete:
+			DeleteSection_RenderThread(Command.SectionId);
+			break;
+		}
+	}
+
+	FlushArena_RenderThread();
+}
+
 void FRuntimeMeshProxy::UpdateSectionProperties_GameThread(int32 SectionId, const FRuntimeMeshSectionPropertyUpdateParamsPtr& SectionData)
 {
+	if (IsBatching_GameThread())
+	{
+		FRuntimeMeshPendingSectionCommand Command(ERuntimeMeshPendingSectionCommandType::UpdateProperties, SectionId);
+		Command.PropertyParams = SectionData;
+		PendingCommands->Add(MoveTemp(Command));
+		return;
+	}
+
+	// Sent on its own, so updates after it can't join pending commands that would apply ahead of it
+	PendingCommands.Reset();
+
 	ENQUEUE_UNIQUE_RENDER_COMMAND_THREEPARAMETER(
 		FRuntimeMeshProxyUpdateSectionProperties,
 		FRuntimeMeshProxy*, MeshProxy, this,
@@ -117,6 +279,15 @@ void FRuntimeMeshProxy::UpdateSectionProperties_RenderThread(int32 SectionId, co
 
 void FRuntimeMeshProxy::DeleteSection_GameThread(int32 SectionId)
 {
+	if (IsBatching_GameThread())
+	{
+		PendingCommands->Add(FRuntimeMeshPendingSectionCommand(ERuntimeMeshPendingSectionCommandType::Delete, SectionId));
+		return;
+	}
+
+	// Same as creation, later updates have to apply after the delete
+	PendingCommands.Reset();
+
 	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
 		FRuntimeMeshProxyDeleteSection,
 		FRuntimeMeshProxy*, MeshProxy, this,
@@ -153,6 +324,52 @@ void FRuntimeMeshProxy::DeleteSection_RenderThread(int32 SectionId)
 	}
 }
 
+void FRuntimeMeshProxy::FlushArena_RenderThread()
+{
+	check(IsInRenderingThread());
+
+	if (Arena.IsValid())
+	{
+		Arena->Flush();
+	}
+}
+
+void FRuntimeMeshProxy::BeginBatch_GameThread()
+{
+	// A fresh set of commands, so nothing in the batch can slip out early with ones already sent
+	if (BatchDepth++ == 0)
+	{
+		PendingCommands = MakeShared<FRuntimeMeshPendingSectionCommands, ESPMode::ThreadSafe>();
+	}
+}
+
+void FRuntimeMeshProxy::EndBatch_GameThread()
+{
+	check(BatchDepth > 0);
+	if (--BatchDepth > 0)
+	{
+		return;
+	}
+
+	if (PendingCommands->Commands.Num() == 0)
+	{
+		PendingCommands.Reset();
+		return;
+	}
+
+	INC_DWORD_STAT_BY(STAT_RuntimeMesh_BatchedSectionCommands, PendingCommands->Commands.Num());
+
+	// Left open afterwards so updates made before the render thread gets to it can still join
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FRuntimeMeshProxyApplyBatchedCommands,
+		FRuntimeMeshProxy*, MeshProxy, this,
+		FRuntimeMeshPendingSectionCommandsPtr, Commands, PendingCommands,
+		{
+			MeshProxy->ApplyPendingCommands_RenderThread(Commands);
+		}
+	);
+}
+
 void FRuntimeMeshProxy::UpdateLODData_GameThread(FRuntimeMeshLODDataUpdateParamsPtr UpdateParams)
 {
 	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
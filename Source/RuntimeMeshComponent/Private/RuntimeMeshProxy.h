@@ -30,6 +30,63 @@ struct FRuntimeMeshRenderThreadDeleter
 	}
 };
 
+enum class ERuntimeMeshPendingSectionCommandType : uint8
+{
+	Create,
+	Update,
+	UpdateProperties,
+	Delete,
+};
+
+/** One section change waiting in FRuntimeMeshPendingSectionCommands, only the params for its type are set */
+struct FRuntimeMeshPendingSectionCommand
+{
+	ERuntimeMeshPendingSectionCommandType Type;
+	int32 SectionId;
+
+	FRuntimeMeshSectionCreationParamsPtr CreationParams;
+	FRuntimeMeshSectionUpdateParamsPtr UpdateParams;
+	FRuntimeMeshSectionPropertyUpdateParamsPtr PropertyParams;
+
+	FRuntimeMeshPendingSectionCommand(ERuntimeMeshPendingSectionCommandType InType, int32 InSectionId)
+		: Type(InType), SectionId(InSectionId)
+	{ }
+
+	/** Has a newer update replaced this one */
+	bool IsSuperseded() const { return Type == ERuntimeMeshPendingSectionCommandType::Update && !UpdateParams.IsValid(); }
+};
+
+/**
+*	Section changes sent to the render thread but not yet applied, in the order they were made. A newer update of a
+*	section LOD drops any older one it fully replaces, so a section changed several times in a frame is only uploaded once.
+*/
+struct FRuntimeMeshPendingSectionCommands
+{
+	FCriticalSection Lock;
+
+	/** Commands in the order they were sent, with superseded updates reset */
+	TArray<FRuntimeMeshPendingSectionCommand> Commands;
+
+	/** Set once the render thread has taken the commands, after which nothing more can be added */
+	bool bDrained;
+
+	FRuntimeMeshPendingSectionCommands() : bDrained(false) { }
+
+	/** Adds a create, property update or delete */
+	void Add(FRuntimeMeshPendingSectionCommand&& Command);
+
+	/**
+	*	Adds an update, if bSupersede is set dropping older ones for the same LOD that it covers, back to the
+	*	section's last create or delete. Returns how many were dropped
+	*/
+	int32 AddUpdate(int32 SectionId, const FRuntimeMeshSectionUpdateParamsPtr& Update, bool bSupersede);
+
+private:
+	/** Does the newer update send all the buffers of the older one in full */
+	static bool Supersedes(const FRuntimeMeshSectionUpdateParams& Newer, const FRuntimeMeshSectionUpdateParams& Older);
+};
+using FRuntimeMeshPendingSectionCommandsPtr = TSharedPtr<FRuntimeMeshPendingSectionCommands, ESPMode::ThreadSafe>;
+
 /**
  *
  */
@@ -37,16 +94,30 @@ class FRuntimeMeshProxy
 {
 	ERHIFeatureLevel::Type FeatureLevel;
 
+	const bool bUseSharedSectionBuffers;
+
+	/** Shared buffers all sections are suballocated from, only created if the mesh opted in */
+	FRuntimeMeshArenaPtr Arena;
+
 	TMap<int32, FRuntimeMeshSectionProxyPtr> Sections;
 
 	TArray<float, TInlineAllocator<8>> LODScreenSizes;
 
+	/** Section commands that can still be added to before the render thread picks them up. Only touched by the thread sending updates */
+	FRuntimeMeshPendingSectionCommandsPtr PendingCommands;
+
+	/** Depth of BeginBatch_GameThread calls, while above 0 every section command waits in PendingCommands */
+	int32 BatchDepth;
+
 public:
-	FRuntimeMeshProxy(ERHIFeatureLevel::Type InFeatureLevel);
+	FRuntimeMeshProxy(ERHIFeatureLevel::Type InFeatureLevel, bool bInUseSharedSectionBuffers = false);
 	~FRuntimeMeshProxy();
 
 	ERHIFeatureLevel::Type GetFeatureLevel() const { return FeatureLevel; }
 
+	/** Are sections suballocated from shared buffers. This is fixed for the life of the proxy so is safe to call from any thread */
+	bool IsUsingSharedSectionBuffers() const { return bUseSharedSectionBuffers; }
+
 
 	float GetScreenSize(int32 LODIndex) const;
 
@@ -54,11 +125,23 @@ public:
 	void CreateSection_RenderThread(int32 SectionId, const FRuntimeMeshSectionCreationParamsPtr& SectionData);
 	void UpdateSection_GameThread(int32 SectionId, const FRuntimeMeshSectionUpdateParamsPtr& SectionData);
 	void UpdateSection_RenderThread(int32 SectionId, const FRuntimeMeshSectionUpdateParamsPtr& SectionData);
+	void ApplyPendingCommands_RenderThread(const FRuntimeMeshPendingSectionCommandsPtr& Commands);
 	void UpdateSectionProperties_GameThread(int32 SectionId, const FRuntimeMeshSectionPropertyUpdateParamsPtr& SectionData);
 	void UpdateSectionProperties_RenderThread(int32 SectionId, const FRuntimeMeshSectionPropertyUpdateParamsPtr& SectionData);
 	void DeleteSection_GameThread(int32 SectionId);
 	void DeleteSection_RenderThread(int32 SectionId);
 
+	/** Uploads the arena pages written by the section commands just applied, so a batch uploads each page once */
+	void FlushArena_RenderThread();
+
+	/**
+	*	Holds back section creates, updates and deletes until the matching EndBatch_GameThread, then sends them all
+	*	in one render command. Batches nest, only the outermost end sends anything.
+	*/
+	void BeginBatch_GameThread();
+	void EndBatch_GameThread();
+	bool IsBatching_GameThread() const { return BatchDepth > 0; }
+
 	void UpdateLODData_GameThread(FRuntimeMeshLODDataUpdateParamsPtr UpdateParams);
 	void UpdateLODData_RenderThread(FRuntimeMeshLODDataUpdateParamsPtr UpdateParams);
 
@@ -3,12 +3,34 @@
 #include "RuntimeMeshRendering.h"
 #include "RuntimeMeshComponentPlugin.h"
 #include "RuntimeMeshSectionProxy.h"
+#include "RuntimeMeshBufferPool.h"
+
+
+/*
+ *	Buffers grow by half again their size so a mesh that grows a little each update doesn't reallocate every time,
+ *	and only shrink once less than a quarter of the allocation is in use so we don't thrash around a boundary.
+ */
+static int32 CalculateBufferCapacity(int32 CurrentCapacity, int32 NewCount)
+{
+	if (NewCount > CurrentCapacity)
+	{
+		return CurrentCapacity > 0 ? FMath::Max(NewCount, CurrentCapacity + CurrentCapacity / 2) : NewCount;
+	}
+
+	if (NewCount < CurrentCapacity / 4)
+	{
+		return NewCount;
+	}
+
+	return CurrentCapacity;
+}
 
 
 FRuntimeMeshVertexBuffer::FRuntimeMeshVertexBuffer(EUpdateFrequency InUpdateFrequency, int32 InVertexSize)
 	: UsageFlags(InUpdateFrequency == EUpdateFrequency::Frequent? BUF_Dynamic : BUF_Static)
 	, VertexSize(InVertexSize)
 	, NumVertices(0)
+	, Capacity(0)
 	, ShaderResourceView(nullptr)
 {
 }
@@ -16,17 +38,19 @@ FRuntimeMeshVertexBuffer::FRuntimeMeshVertexBuffer(EUpdateFrequency InUpdateFreq
 void FRuntimeMeshVertexBuffer::Reset(int32 InNumVertices)
 {
 	NumVertices = InNumVertices;
+	Capacity = InNumVertices;
 	ReleaseResource();
 	InitResource();
 }
 
 void FRuntimeMeshVertexBuffer::InitRHI()
 {
-	if (VertexSize > 0 && NumVertices > 0)
+	if (VertexSize > 0 && Capacity > 0)
 	{
-		// Create the vertex buffer
-		FRHIResourceCreateInfo CreateInfo;
-		VertexBufferRHI = RHICreateVertexBuffer(GetBufferSize(), UsageFlags | BUF_ShaderResource, CreateInfo);
+		// Grab a vertex buffer from the pool, it may be bigger than requested so use all of it
+		uint32 PooledSize;
+		VertexBufferRHI = GRuntimeMeshBufferPool.AcquireVertexBuffer(GetAllocatedSize(), UsageFlags | BUF_ShaderResource, PooledSize);
+		Capacity = PooledSize / VertexSize;
 
 
 #if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 19
@@ -38,18 +62,32 @@ void FRuntimeMeshVertexBuffer::InitRHI()
 	}
 }
 
+void FRuntimeMeshVertexBuffer::ReleaseRHI()
+{
+	// Release the view first so the pool holds the only reference to the buffer
+	ShaderResourceView.SafeRelease();
+	GRuntimeMeshBufferPool.ReleaseVertexBuffer(VertexBufferRHI);
+
+	FVertexBuffer::ReleaseRHI();
+}
+
 /* Set the size of the vertex buffer */
-void FRuntimeMeshVertexBuffer::SetNum(int32 NewVertexCount)
+bool FRuntimeMeshVertexBuffer::SetNum(int32 NewVertexCount)
 {
-	// Make sure we're not already the right size
-	if (NewVertexCount != NumVertices)
+	NumVertices = NewVertexCount;
+
+	// Only rebuild the resource if the allocation needs to change
+	const int32 NewCapacity = CalculateBufferCapacity(Capacity, NewVertexCount);
+	if (NewCapacity != Capacity)
 	{
-		NumVertices = NewVertexCount;
+		Capacity = NewCapacity;
 
 		// Rebuild resource
 		ReleaseResource();
 		InitResource();
+		return true;
 	}
+	return false;
 }
 
 /* Set the data for the vertex buffer */
@@ -74,12 +112,12 @@ void FRuntimeMeshVertexBuffer::SetData(const TArray<uint8>& Data)
 
 
 FRuntimeMeshIndexBuffer::FRuntimeMeshIndexBuffer()
-	: NumIndices(0), IndexSize(-1), UsageFlags(EBufferUsageFlags::BUF_None)
+	: NumIndices(0), Capacity(0), IndexSize(-1), UsageFlags(EBufferUsageFlags::BUF_None)
 {
 }
 
 FRuntimeMeshIndexBuffer::FRuntimeMeshIndexBuffer(EUpdateFrequency InUpdateFrequency, bool bUseFullPrecisionIndices)
-	: NumIndices(0), IndexSize(bUseFullPrecisionIndices? 4 : 2), UsageFlags(InUpdateFrequency == EUpdateFrequency::Frequent ? BUF_Dynamic : BUF_Static)
+	: NumIndices(0), Capacity(0), IndexSize(bUseFullPrecisionIndices? 4 : 2), UsageFlags(InUpdateFrequency == EUpdateFrequency::Frequent ? BUF_Dynamic : BUF_Static)
 {
 
 }
@@ -88,33 +126,61 @@ void FRuntimeMeshIndexBuffer::Reset(int32 InIndexSize, int32 InNumIndices, EUpda
 {
 	IndexSize = InIndexSize;
 	NumIndices = InNumIndices;
+	Capacity = InNumIndices;
 	UsageFlags = InUpdateFrequency == EUpdateFrequency::Frequent ? BUF_Dynamic : BUF_Static;
 	ReleaseResource();
 	InitResource();
 }
 
+bool FRuntimeMeshIndexBuffer::Resize(int32 InIndexSize, int32 InNumIndices, EUpdateFrequency InUpdateFrequency)
+{
+	const EBufferUsageFlags NewUsageFlags = InUpdateFrequency == EUpdateFrequency::Frequent ? BUF_Dynamic : BUF_Static;
+
+	// A change in format can't reuse the existing allocation
+	if (InIndexSize != IndexSize || NewUsageFlags != UsageFlags)
+	{
+		Reset(InIndexSize, InNumIndices, InUpdateFrequency);
+		return true;
+	}
+
+	return SetNum(InNumIndices);
+}
+
 void FRuntimeMeshIndexBuffer::InitRHI()
 {
-	if (IndexSize > 0 && NumIndices > 0)
+	if (IndexSize > 0 && Capacity > 0)
 	{
-		// Create the index buffer
-		FRHIResourceCreateInfo CreateInfo;
-		IndexBufferRHI = RHICreateIndexBuffer(IndexSize, GetBufferSize(), BUF_Dynamic, CreateInfo);
+		// Grab an index buffer from the pool, it may be bigger than requested so use all of it
+		uint32 PooledSize;
+		IndexBufferRHI = GRuntimeMeshBufferPool.AcquireIndexBuffer(IndexSize, GetAllocatedSize(), UsageFlags, PooledSize);
+		Capacity = PooledSize / IndexSize;
 	}
 }
 
+void FRuntimeMeshIndexBuffer::ReleaseRHI()
+{
+	GRuntimeMeshBufferPool.ReleaseIndexBuffer(IndexBufferRHI);
+
+	FIndexBuffer::ReleaseRHI();
+}
+
 /* Set the size of the index buffer */
-void FRuntimeMeshIndexBuffer::SetNum(int32 NewIndexCount)
+bool FRuntimeMeshIndexBuffer::SetNum(int32 NewIndexCount)
 {
-	// Make sure we're not already the right size
-	if (NewIndexCount != NumIndices)
+	NumIndices = NewIndexCount;
+
+	// Only rebuild the resource if the allocation needs to change
+	const int32 NewCapacity = CalculateBufferCapacity(Capacity, NewIndexCount);
+	if (NewCapacity != Capacity)
 	{
-		NumIndices = NewIndexCount;
+		Capacity = NewCapacity;
 
 		// Rebuild resource
 		ReleaseResource();
 		InitResource();
+		return true;
 	}
+	return false;
 }
 
 /* Set the data for the index buffer */
@@ -179,5 +245,14 @@ uint64 FRuntimeMeshVertexFactory::GetStaticBatchElementVisibility(const class FS
 uint64 FRuntimeMeshVertexFactory::GetStaticBatchElementVisibility(const class FSceneView& View, const struct FMeshBatch* Batch) const
 #endif
 {
-	return SectionParent->ShouldRender();
+	// Vertex factories shared by a whole arena page don't have a parent, the batch carries the section instead
+	FRuntimeMeshSectionProxy* Section = SectionParent ? SectionParent : (FRuntimeMeshSectionProxy*)Batch->Elements[0].UserData;
+	if (Section && !Section->ShouldRender())
+	{
+		return 0;
+	}
+
+	// One bit per element, sections with segmented indices have more than one
+	const int32 NumElements = FMath::Clamp(Batch->Elements.Num(), 1, 64);
+	return MAX_uint64 >> (64 - NumElements);
 }
\ No newline at end of file
@@ -21,9 +21,12 @@ protected:
 	/** Size of a single vertex */
 	const int32 VertexSize;
 
-	/** The number of vertices this buffer is currently allocated to hold */
+	/** The number of vertices currently in use in this buffer */
 	int32 NumVertices;
 
+	/** The number of vertices this buffer is currently allocated to hold */
+	int32 Capacity;
+
 	/** Shader Resource View for this buffer */
 	FShaderResourceViewRHIRef ShaderResourceView;
 
@@ -33,18 +36,31 @@ public:
 
 	~FRuntimeMeshVertexBuffer() {}
 
+	/* Resets the buffer to hold exactly InNumVertices, dropping any spare capacity */
 	void Reset(int32 InNumVertices);
 
 	virtual void InitRHI() override;
 
+	/** Returns the RHI buffer to the shared buffer pool */
+	virtual void ReleaseRHI() override;
+
 	/** Get the size of the vertex buffer */
 	int32 Num() { return NumVertices; }
 
-	/** Gets the full allocated size of the buffer (Equal to VertexSize * NumVertices) */
+	/** Gets the size of a single vertex */
+	int32 GetVertexSize() const { return VertexSize; }
+
+	/** Gets the number of vertices the buffer can hold without reallocating */
+	int32 GetCapacity() const { return Capacity; }
+
+	/** Gets the used size of the buffer (Equal to VertexSize * NumVertices) */
 	int32 GetBufferSize() const { return NumVertices * VertexSize; }
 
-	/* Set the size of the vertex buffer */
-	void SetNum(int32 NewVertexCount);
+	/** Gets the full allocated size of the buffer (Equal to VertexSize * Capacity) */
+	int32 GetAllocatedSize() const { return Capacity * VertexSize; }
+
+	/* Set the size of the vertex buffer, returns true if the RHI buffer had to be reallocated */
+	bool SetNum(int32 NewVertexCount);
 
 	/* Set the data for the vertex buffer */
 	void SetData(const TArray<uint8>& Data);
@@ -271,9 +287,12 @@ protected:
 class FRuntimeMeshIndexBuffer : public FIndexBuffer
 {
 private:
-	/* The number of indices this buffer is currently allocated to hold */
+	/* The number of indices currently in use in this buffer */
 	int32 NumIndices;
 
+	/* The number of indices this buffer is currently allocated to hold */
+	int32 Capacity;
+
 	/* The size of a single index*/
 	int32 IndexSize;
 
@@ -288,18 +307,35 @@ public:
 
 	~FRuntimeMeshIndexBuffer() {}
 
+	/* Resets the buffer to hold exactly InNumIndices, dropping any spare capacity */
 	void Reset(int32 InIndexSize, int32 InNumIndices, EUpdateFrequency InUpdateFrequency);
 
+	/* Resizes the buffer, keeping the existing allocation when the index size and usage match and the indices fit.
+	 * Returns true if the RHI buffer had to be reallocated */
+	bool Resize(int32 InIndexSize, int32 InNumIndices, EUpdateFrequency InUpdateFrequency);
+
 	virtual void InitRHI() override;
 
+	/* Returns the RHI buffer to the shared buffer pool */
+	virtual void ReleaseRHI() override;
+
 	/* Get the size of the index buffer */
 	int32 Num() { return NumIndices; }
 
-	/** Gets the full allocated size of the buffer (Equal to IndexSize * NumIndices) */
+	/* Gets the size of a single index */
+	int32 GetIndexSize() const { return IndexSize; }
+
+	/** Gets the number of indices the buffer can hold without reallocating */
+	int32 GetCapacity() const { return Capacity; }
+
+	/** Gets the used size of the buffer (Equal to IndexSize * NumIndices) */
 	int32 GetBufferSize() const { return NumIndices * IndexSize; }
 
-	/* Set the size of the index buffer */
-	void SetNum(int32 NewIndexCount);
+	/** Gets the full allocated size of the buffer (Equal to IndexSize * Capacity) */
+	int32 GetAllocatedSize() const { return Capacity * IndexSize; }
+
+	/* Set the size of the index buffer, returns true if the RHI buffer had to be reallocated */
+	bool SetNum(int32 NewIndexCount);
 
 	/* Set the data for the index buffer */
 	void SetData(const TArray<uint8>& Data);
@@ -323,6 +359,6 @@ public:
 #endif
 
 private:
-	/* Interface to the parent section for checking visibility.*/
+	/* Interface to the parent section for checking visibility. Null when shared by an arena page */
 	FRuntimeMeshSectionProxy * SectionParent;
 };
\ No newline at end of file
@@ -4,6 +4,21 @@
 #include "RuntimeMeshComponentPlugin.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 #include "RuntimeMeshUpdateCommands.h"
+#include "RuntimeMeshGeometryKernels.h"
+
+DECLARE_CYCLE_STAT(TEXT("RM - Encode Indices"), STAT_RuntimeMesh_EncodeIndices, STATGROUP_RuntimeMesh);
+
+static TAutoConsoleVariable<int32> CVarRuntimeMeshIndexEncoding(
+	TEXT("r.RuntimeMesh.IndexEncoding"),
+	2,
+	TEXT("How 32 bit section indices are sent to the GPU.\n")
+	TEXT(" 0: As is\n")
+	TEXT(" 1: As 16 bit when every index fits\n")
+	TEXT(" 2: As 16 bit, splitting bigger sections into segments that each draw from their own base vertex (default)"),
+	ECVF_Default);
+
+// Past this many segments the extra draws cost more than the smaller indices save
+static const int32 RuntimeMeshMaxIndexSegments = 16;
 
 template<typename Type>
 struct FRuntimeMeshStreamAccessor
@@ -87,30 +102,260 @@ public:
 };
 
 
-void FRuntimeMeshSectionVertexBuffer::FillUpdateParams(FRuntimeMeshSectionVertexBufferParams& Params)
+// Gets the data to send for a range of a stream. The whole stream is shared, but a partial range is copied out so the
+// update doesn't hold a reference to the full stream that would force it to be duplicated on the next write.
+static FRuntimeMeshSharedStreamDataPtr GetStreamDataForRange(const FRuntimeMeshSharedStream& Data, int32 Stride, int32 NumElements, const FRuntimeMeshStreamRange& Range, int32& OutStart, bool& bOutIsPartial)
+{
+	if (Range.Covers(NumElements))
+	{
+		OutStart = 0;
+		bOutIsPartial = false;
+		return Data.Share();
+	}
+
+	FRuntimeMeshStreamRange ClampedRange = Range.Clamp(NumElements);
+	OutStart = ClampedRange.Start;
+	bOutIsPartial = true;
+	return MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(Data.Get().GetData() + ClampedRange.Start * Stride, ClampedRange.Count * Stride);
+}
+
+void FRuntimeMeshSectionVertexBuffer::FillUpdateParams(FRuntimeMeshSectionVertexBufferParams& Params, const FRuntimeMeshStreamRange& Range)
 {
-	Params.Data = Data;
 	Params.NumVertices = GetNumVertices();
+	Params.Data = GetStreamDataForRange(Data, Stride, Params.NumVertices, Range, Params.StartVertex, Params.bIsPartialUpdate);
 }
 
-void FRuntimeMeshSectionIndexBuffer::FillUpdateParams(FRuntimeMeshSectionIndexBufferParams& Params)
+// Splits 32 bit indices into runs of whole primitives that each span at most 64k vertices.
+// Returns false if that would take too many segments, or a single primitive spans too much.
+static bool BuildIndexSegments(const uint32* Indices, int32 NumIndices, int32 IndicesPerPrimitive, TArray<FRuntimeMeshIndexSegment>& OutSegments)
 {
+	OutSegments.Reset();
+
+	int32 SegmentStart = 0;
+	uint32 SegmentMin = MAX_uint32;
+	uint32 SegmentMax = 0;
+
+	for (int32 PrimitiveStart = 0; PrimitiveStart < NumIndices; PrimitiveStart += IndicesPerPrimitive)
+	{
+		uint32 PrimitiveMin = MAX_uint32;
+		uint32 PrimitiveMax = 0;
+		const int32 PrimitiveEnd = FMath::Min(PrimitiveStart + IndicesPerPrimitive, NumIndices);
+		for (int32 Index = PrimitiveStart; Index < PrimitiveEnd; Index++)
+		{
+			PrimitiveMin = FMath::Min(PrimitiveMin, Indices[Index]);
+			PrimitiveMax = FMath::Max(PrimitiveMax, Indices[Index]);
+		}
+
+		if (PrimitiveMax - PrimitiveMin > MAX_uint16)
+		{
+			return false;
+		}
+
+		const uint32 NewMin = FMath::Min(SegmentMin, PrimitiveMin);
+		const uint32 NewMax = FMath::Max(SegmentMax, PrimitiveMax);
+		if (NewMax - NewMin > MAX_uint16)
+		{
+			if (OutSegments.Num() + 1 >= RuntimeMeshMaxIndexSegments)
+			{
+				return false;
+			}
+
+			OutSegments.Emplace(SegmentStart, PrimitiveStart - SegmentStart, (int32)SegmentMin);
+			SegmentStart = PrimitiveStart;
+			SegmentMin = PrimitiveMin;
+			SegmentMax = PrimitiveMax;
+		}
+		else
+		{
+			SegmentMin = NewMin;
+			SegmentMax = NewMax;
+		}
+	}
+
+	OutSegments.Emplace(SegmentStart, NumIndices - SegmentStart, (int32)SegmentMin);
+	return true;
+}
+
+// Segments are contiguous and in order, so this is the last one starting at or before Index
+static int32 FindIndexSegment(const TArray<FRuntimeMeshIndexSegment>& Segments, int32 Index)
+{
+	int32 SegmentIndex = 0;
+	while (SegmentIndex + 1 < Segments.Num() && Segments[SegmentIndex + 1].FirstIndex <= Index)
+	{
+		SegmentIndex++;
+	}
+	return SegmentIndex;
+}
+
+// Writes a range of 32 bit indices as 16 bit offsets from the base vertex of their segment, or from 0 without segments
+static void EncodeIndices16(const uint32* Indices, int32 Start, int32 Num, const TArray<FRuntimeMeshIndexSegment>& Segments, TArray<uint8>& OutData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_EncodeIndices);
+
+	OutData.SetNumUninitialized(Num * sizeof(uint16));
+	uint16* OutIndices = reinterpret_cast<uint16*>(OutData.GetData());
+
+	int32 SegmentIndex = FindIndexSegment(Segments, Start);
+	for (int32 Index = Start; Index < Start + Num; Index++)
+	{
+		while (SegmentIndex + 1 < Segments.Num() && Segments[SegmentIndex + 1].FirstIndex <= Index)
+		{
+			SegmentIndex++;
+		}
+
+		const uint32 BaseVertex = Segments.Num() > 0 ? (uint32)Segments[SegmentIndex].BaseVertexIndex : 0;
+		checkSlow(Indices[Index] >= BaseVertex && Indices[Index] - BaseVertex <= MAX_uint16);
+		OutIndices[Index - Start] = (uint16)(Indices[Index] - BaseVertex);
+	}
+}
+
+void FRuntimeMeshSectionIndexBuffer::FillUpdateParams(FRuntimeMeshSectionIndexBufferParams& Params, const FRuntimeMeshStreamRange& Range, int32 IndicesPerPrimitive, bool bAllowEncoding)
+{
+	const int32 NumIndices = GetNumIndices();
+	const uint32* Indices = reinterpret_cast<const uint32*>(Data.Get().GetData());
+
+	Params.NumIndices = NumIndices;
+	Params.Segments.Reset();
+
+	if (!Range.Covers(NumIndices))
+	{
+		// Partial updates go into the existing render thread buffer, so they have to match its format
+		check(CanUpdateRangeInPlace(Range));
+
+		if (Encoding == ERuntimeMeshIndexEncoding::Packed16 || Encoding == ERuntimeMeshIndexEncoding::Segmented16)
+		{
+			const FRuntimeMeshStreamRange ClampedRange = Range.Clamp(NumIndices);
+			TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> EncodedData = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+			EncodeIndices16(Indices, ClampedRange.Start, ClampedRange.Count, EncodedSegments, *EncodedData);
+
+			Params.b32BitIndices = false;
+			Params.bIsPartialUpdate = true;
+			Params.StartIndex = ClampedRange.Start;
+			Params.Data = EncodedData;
+			return;
+		}
+
+		Params.b32BitIndices = b32BitIndices;
+		Params.Data = GetStreamDataForRange(Data, GetStride(), NumIndices, Range, Params.StartIndex, Params.bIsPartialUpdate);
+		return;
+	}
+
+	// Full update, so pick the smallest format the indices fit
+	Encoding = ERuntimeMeshIndexEncoding::None;
+	EncodedNumIndices = NumIndices;
+	EncodedSegments.Reset();
+
+	const int32 EncodingMode = (bAllowEncoding && b32BitIndices && NumIndices > 0) ? CVarRuntimeMeshIndexEncoding.GetValueOnAnyThread() : 0;
+	if (EncodingMode > 0)
+	{
+		uint32 MaxIndex = 0;
+		for (int32 Index = 0; Index < NumIndices; Index++)
+		{
+			MaxIndex = FMath::Max(MaxIndex, Indices[Index]);
+		}
+
+		if (MaxIndex <= MAX_uint16)
+		{
+			Encoding = ERuntimeMeshIndexEncoding::Packed16;
+		}
+		else if (EncodingMode > 1 && BuildIndexSegments(Indices, NumIndices, IndicesPerPrimitive, EncodedSegments))
+		{
+			Encoding = ERuntimeMeshIndexEncoding::Segmented16;
+		}
+		else
+		{
+			EncodedSegments.Reset();
+		}
+	}
+
+	if (Encoding != ERuntimeMeshIndexEncoding::None)
+	{
+		TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> EncodedData = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+		EncodeIndices16(Indices, 0, NumIndices, EncodedSegments, *EncodedData);
+
+		Params.b32BitIndices = false;
+		Params.bIsPartialUpdate = false;
+		Params.StartIndex = 0;
+		Params.Data = EncodedData;
+		Params.Segments = EncodedSegments;
+		return;
+	}
+
 	Params.b32BitIndices = b32BitIndices;
-	Params.Data = Data;
-	Params.NumIndices = GetNumIndices();
+	Params.Data = GetStreamDataForRange(Data, GetStride(), NumIndices, Range, Params.StartIndex, Params.bIsPartialUpdate);
 }
 
-void FRuntimeMeshSectionTangentsVertexBuffer::FillUpdateParams(FRuntimeMeshSectionTangentVertexBufferParams& Params)
+bool FRuntimeMeshSectionIndexBuffer::CanUpdateRangeInPlace(const FRuntimeMeshStreamRange& Range) const
+{
+	const int32 NumIndices = GetNumIndices();
+	if (Range.Covers(NumIndices) || Encoding == ERuntimeMeshIndexEncoding::None)
+	{
+		return true;
+	}
+
+	if (Encoding == ERuntimeMeshIndexEncoding::Unknown || EncodedNumIndices != NumIndices)
+	{
+		return false;
+	}
+
+	// Every changed index still has to fit in 16 bits from the base vertex of its segment
+	const FRuntimeMeshStreamRange ClampedRange = Range.Clamp(NumIndices);
+	const uint32* Indices = reinterpret_cast<const uint32*>(Data.Get().GetData());
+
+	int32 SegmentIndex = FindIndexSegment(EncodedSegments, ClampedRange.Start);
+	for (int32 Index = ClampedRange.Start; Index < ClampedRange.Start + ClampedRange.Count; Index++)
+	{
+		while (SegmentIndex + 1 < EncodedSegments.Num() && EncodedSegments[SegmentIndex + 1].FirstIndex <= Index)
+		{
+			SegmentIndex++;
+		}
+
+		const uint32 BaseVertex = EncodedSegments.Num() > 0 ? (uint32)EncodedSegments[SegmentIndex].BaseVertexIndex : 0;
+		if (Indices[Index] < BaseVertex || Indices[Index] - BaseVertex > MAX_uint16)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FRuntimeMeshSectionLODData::FillIndexUpdateParams(FRuntimeMeshSectionIndexBufferParams* IndexParams, FRuntimeMeshSectionIndexBufferParams* AdjacencyParams, const FRuntimeMeshStreamRange& IndexRange)
+{
+	if (IndexParams)
+	{
+		IndexBuffer.FillUpdateParams(*IndexParams, IndexRange, 3);
+	}
+
+	if (AdjacencyParams)
+	{
+		AdjacencyIndexBuffer.FillUpdateParams(*AdjacencyParams, FRuntimeMeshStreamRange::All(), 12);
+
+		// Shared section buffers keep both in one format, so if only one of them could be made 16 bit send both as is
+		if (IndexParams && AdjacencyParams->NumIndices > 0 && IndexParams->b32BitIndices != AdjacencyParams->b32BitIndices)
+		{
+			if (IndexParams->b32BitIndices)
+			{
+				AdjacencyIndexBuffer.FillUpdateParams(*AdjacencyParams, FRuntimeMeshStreamRange::All(), 12, false);
+			}
+			else
+			{
+				IndexBuffer.FillUpdateParams(*IndexParams, FRuntimeMeshStreamRange::All(), 3, false);
+			}
+		}
+	}
+}
+
+void FRuntimeMeshSectionTangentsVertexBuffer::FillUpdateParams(FRuntimeMeshSectionTangentVertexBufferParams& Params, const FRuntimeMeshStreamRange& Range)
 {
 	Params.bUsingHighPrecision = bUseHighPrecision;
-	FRuntimeMeshSectionVertexBuffer::FillUpdateParams(Params);
+	FRuntimeMeshSectionVertexBuffer::FillUpdateParams(Params, Range);
 }
 
-void FRuntimeMeshSectionUVsVertexBuffer::FillUpdateParams(FRuntimeMeshSectionUVVertexBufferParams& Params)
+void FRuntimeMeshSectionUVsVertexBuffer::FillUpdateParams(FRuntimeMeshSectionUVVertexBufferParams& Params, const FRuntimeMeshStreamRange& Range)
 {
 	Params.bUsingHighPrecision = bUseHighPrecision;
 	Params.NumUVs = UVCount;
-	FRuntimeMeshSectionVertexBuffer::FillUpdateParams(Params);
+	FRuntimeMeshSectionVertexBuffer::FillUpdateParams(Params, Range);
 }
 
 
@@ -121,6 +366,11 @@ FRuntimeMeshSection::FRuntimeMeshSection(bool bInUseHighPrecisionTangents, bool
 	, bCollisionEnabled(false)
 	, bIsVisible(true)
 	, bCastsShadow(true)
+	, bIsRenderOnly(false)
+	, bHasReleasedData(false)
+	, bHadValidMeshData(false)
+	, bCompressCPUData(false)
+	, bIsCompressed(false)
 {
 	LODs.Emplace(bInUseHighPrecisionTangents, bInUseHighPrecisionUVs, InNumUVs, b32BitIndices);	
 }
@@ -131,12 +381,27 @@ FRuntimeMeshSection::FRuntimeMeshSection(FArchive& Ar)
 	, bCollisionEnabled(false)
 	, bIsVisible(true)
 	, bCastsShadow(true)
+	, bIsRenderOnly(false)
+	, bHasReleasedData(false)
+	, bHadValidMeshData(false)
+	, bCompressCPUData(false)
+	, bIsCompressed(false)
 {
 	Ar << *this;
 }
 
+FRuntimeMeshSection::~FRuntimeMeshSection()
+{
+	for (FRuntimeMeshCompressedLODData& CompressedLOD : CompressedLODs)
+	{
+		FRuntimeMeshSectionCompression::DiscardCompressedLOD(CompressedLOD);
+	}
+}
+
 FRuntimeMeshSectionCreationParamsPtr FRuntimeMeshSection::GetSectionCreationParams()
 {
+	DecompressData();
+
 	FRuntimeMeshSectionCreationParamsPtr CreationParams = MakeShared<FRuntimeMeshSectionCreationParams, ESPMode::NotThreadSafe>();
 
 	CreationParams->UpdateFrequency = UpdateFrequency;
@@ -149,8 +414,13 @@ FRuntimeMeshSectionCreationParamsPtr FRuntimeMeshSection::GetSectionCreationPara
 		LODs[Index].UVsBuffer.FillUpdateParams(CreationParams->LODs[Index].UVsVertexBuffer);
 		LODs[Index].ColorBuffer.FillUpdateParams(CreationParams->LODs[Index].ColorVertexBuffer);
 
-		LODs[Index].IndexBuffer.FillUpdateParams(CreationParams->LODs[Index].IndexBuffer);
-		LODs[Index].AdjacencyIndexBuffer.FillUpdateParams(CreationParams->LODs[Index].AdjacencyIndexBuffer);
+		LODs[Index].FillIndexUpdateParams(&CreationParams->LODs[Index].IndexBuffer, &CreationParams->LODs[Index].AdjacencyIndexBuffer);
+
+		CreationParams->LODs[Index].LocalBounds = GetLODBoundingBox(Index);
+		if (HasClusters(Index))
+		{
+			CreationParams->LODs[Index].Clusters = LODClusters[Index];
+		}
 	}
 
 	CreationParams->bIsVisible = bIsVisible;
@@ -159,8 +429,10 @@ FRuntimeMeshSectionCreationParamsPtr FRuntimeMeshSection::GetSectionCreationPara
 	return CreationParams;
 }
 
-FRuntimeMeshSectionUpdateParamsPtr FRuntimeMeshSection::GetSectionUpdateData(int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate)
+FRuntimeMeshSectionUpdateParamsPtr FRuntimeMeshSection::GetSectionUpdateData(int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FRuntimeMeshStreamRange& VertexRange, const FRuntimeMeshStreamRange& IndexRange)
 {
+	DecompressData();
+
 	FRuntimeMeshSectionUpdateParamsPtr UpdateParams = MakeShared<FRuntimeMeshSectionUpdateParams, ESPMode::NotThreadSafe>();
 
 	UpdateParams->LODIndex = LODIndex;
@@ -168,37 +440,130 @@ FRuntimeMeshSectionUpdateParamsPtr FRuntimeMeshSection::GetSectionUpdateData(int
 
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::PositionBuffer))
 	{
-		LODs[LODIndex].PositionBuffer.FillUpdateParams(UpdateParams->PositionVertexBuffer);
+		LODs[LODIndex].PositionBuffer.FillUpdateParams(UpdateParams->PositionVertexBuffer, VertexRange);
+
+		// Partial updates still send the bounds of the whole LOD
+		UpdateParams->LocalBounds = GetLODBoundingBox(LODIndex);
 	}
 
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::TangentBuffer))
 	{
-		LODs[LODIndex].TangentsBuffer.FillUpdateParams(UpdateParams->TangentsVertexBuffer);
+		LODs[LODIndex].TangentsBuffer.FillUpdateParams(UpdateParams->TangentsVertexBuffer, VertexRange);
 	}
 
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::UVBuffer))
 	{
-		LODs[LODIndex].UVsBuffer.FillUpdateParams(UpdateParams->UVsVertexBuffer);
+		LODs[LODIndex].UVsBuffer.FillUpdateParams(UpdateParams->UVsVertexBuffer, VertexRange);
 	}
 
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::ColorBuffer))
 	{
-		LODs[LODIndex].ColorBuffer.FillUpdateParams(UpdateParams->ColorVertexBuffer);
+		LODs[LODIndex].ColorBuffer.FillUpdateParams(UpdateParams->ColorVertexBuffer, VertexRange);
 	}
 
-	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer))
+	// Clusters go with the positions and indices they were built from, an empty list clears them
+	if (!!(BuffersToUpdate & (ERuntimeMeshBuffersToUpdate::PositionBuffer | ERuntimeMeshBuffersToUpdate::IndexBuffer)) && HasClusters(LODIndex))
 	{
-		LODs[LODIndex].IndexBuffer.FillUpdateParams(UpdateParams->IndexBuffer);
+		UpdateParams->Clusters = LODClusters[LODIndex];
 	}
 
-	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer))
+	const bool bUpdateIndices = !!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer);
+	const bool bUpdateAdjacencyIndices = !!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer);
+	if (bUpdateIndices || bUpdateAdjacencyIndices)
 	{
-		LODs[LODIndex].AdjacencyIndexBuffer.FillUpdateParams(UpdateParams->AdjacencyIndexBuffer);
+		LODs[LODIndex].FillIndexUpdateParams(bUpdateIndices ? &UpdateParams->IndexBuffer : nullptr,
+			bUpdateAdjacencyIndices ? &UpdateParams->AdjacencyIndexBuffer : nullptr, IndexRange);
 	}
 
 	return UpdateParams;
 }
 
+void FRuntimeMeshSection::GatherVertexCacheOptimizationInput(int32 LODIndex, bool bOptimizeOverdraw, FRuntimeMeshVertexCacheOptimizationInput& OutInput)
+{
+	DecompressData();
+
+	FRuntimeMeshVertexCacheOptimizer::GatherInput(LODs[LODIndex], bOptimizeOverdraw, OutInput);
+}
+
+bool FRuntimeMeshSection::ApplyVertexCacheOptimization(int32 LODIndex, const FRuntimeMeshVertexCacheOptimizationInput& Input, const FRuntimeMeshVertexCacheOptimization& Optimization)
+{
+	if (!HasCPUData() || !LODs.IsValidIndex(LODIndex))
+	{
+		return false;
+	}
+
+	DecompressData();
+
+	// Only the triangles and vertex count matter, other changes to the vertices are moved along with them
+	FRuntimeMeshVertexCacheOptimizationInput CurrentInput;
+	FRuntimeMeshVertexCacheOptimizer::GatherInput(LODs[LODIndex], false, CurrentInput);
+	if (CurrentInput.NumVertices != Input.NumVertices || CurrentInput.Indices != Input.Indices)
+	{
+		return false;
+	}
+
+	FRuntimeMeshVertexCacheOptimizer::Apply(Optimization, LODs[LODIndex]);
+	return true;
+}
+
+bool FRuntimeMeshSection::BuildClusters(int32 LODIndex, int32 MaxTriangles)
+{
+	DecompressData();
+
+	if (LODClusters.Num() <= LODIndex)
+	{
+		LODClusters.SetNum(LODIndex + 1);
+	}
+
+	return FRuntimeMeshClusterBuilder::ClusterLOD(LODs[LODIndex], MaxTriangles, LODClusters[LODIndex]);
+}
+
+FRuntimeMeshVertexWeldResult FRuntimeMeshSection::WeldVertices(int32 LODIndex, const FRuntimeMeshVertexWeldSettings& Settings)
+{
+	DecompressData();
+
+	return FRuntimeMeshVertexWelder::WeldLOD(LODs[LODIndex], Settings);
+}
+
+FRuntimeMeshBuilderRef FRuntimeMeshSection::CopyLODToBuilder(int32 LODIndex)
+{
+	DecompressData();
+
+	const FRuntimeMeshSectionLODData& LOD = LODs[LODIndex];
+	FRuntimeMeshBuilderRef Builder = MakeRuntimeMeshBuilder(LOD.TangentsBuffer.IsUsingHighPrecision(), LOD.UVsBuffer.IsUsingHighPrecision(), LOD.UVsBuffer.NumUVs(), LOD.IndexBuffer.Is32BitIndices());
+
+	const int32 NumVertices = LOD.PositionBuffer.GetNumVertices();
+	auto CopyStream = [NumVertices](const FRuntimeMeshSectionVertexBuffer& Buffer, TArray<uint8>& OutStream)
+	{
+		OutStream = Buffer.GetData();
+		OutStream.SetNumZeroed(NumVertices * Buffer.GetStride());
+	};
+
+	CopyStream(LOD.PositionBuffer, Builder->GetPositionStream());
+	CopyStream(LOD.TangentsBuffer, Builder->GetTangentStream());
+	CopyStream(LOD.UVsBuffer, Builder->GetUVStream());
+	CopyStream(LOD.ColorBuffer, Builder->GetColorStream());
+	Builder->GetIndexStream() = LOD.IndexBuffer.GetData();
+
+	return Builder;
+}
+
+uint32 FRuntimeMeshSection::GetLODTopologyCrc(int32 LODIndex)
+{
+	DecompressData();
+
+	const FRuntimeMeshSectionLODData& LOD = LODs[LODIndex];
+	const int32 NumVertices = LOD.PositionBuffer.GetNumVertices();
+	return FCrc::MemCrc32(LOD.IndexBuffer.GetData().GetData(), LOD.IndexBuffer.GetData().Num(), FCrc::MemCrc32(&NumVertices, sizeof(NumVertices)));
+}
+
+bool FRuntimeMeshSection::CanUpdateIndexRangeInPlace(int32 LODIndex, const FRuntimeMeshStreamRange& IndexRange)
+{
+	DecompressData();
+
+	return LODs[LODIndex].IndexBuffer.CanUpdateRangeInPlace(IndexRange);
+}
+
 TSharedPtr<struct FRuntimeMeshSectionPropertyUpdateParams, ESPMode::NotThreadSafe> FRuntimeMeshSection::GetSectionPropertyUpdateData()
 {
 	FRuntimeMeshSectionPropertyUpdateParamsPtr UpdateParams = MakeShared<FRuntimeMeshSectionPropertyUpdateParams, ESPMode::NotThreadSafe>();
@@ -211,18 +576,119 @@ TSharedPtr<struct FRuntimeMeshSectionPropertyUpdateParams, ESPMode::NotThreadSaf
 
 void FRuntimeMeshSection::UpdateBoundingBox()
 {
-	FBox NewBoundingBox(reinterpret_cast<FVector*>(LODs[0].PositionBuffer.GetData().GetData()), LODs[0].PositionBuffer.GetNumVertices());
-	
-	LocalBoundingBox = NewBoundingBox;
+	DecompressData();
+
+	LocalBoundingBox = FRuntimeMeshGeometryKernels::ComputeBoundingBox(
+		reinterpret_cast<const FVector*>(LODs[0].PositionBuffer.GetData().GetData()), LODs[0].PositionBuffer.GetNumVertices());
+}
+
+FBox FRuntimeMeshSection::GetLODBoundingBox(int32 LODIndex)
+{
+	if (LODIndex == 0)
+	{
+		return LocalBoundingBox;
+	}
+
+	DecompressData();
+
+	return FRuntimeMeshGeometryKernels::ComputeBoundingBox(
+		reinterpret_cast<const FVector*>(LODs[LODIndex].PositionBuffer.GetData().GetData()), LODs[LODIndex].PositionBuffer.GetNumVertices());
+}
+
+void FRuntimeMeshSection::RemoveLODsAbove(int32 NumLODsToKeep)
+{
+	NumLODsToKeep = FMath::Max(NumLODsToKeep, 1);
+	if (LODs.Num() <= NumLODsToKeep)
+	{
+		return;
+	}
+
+	// Compressed copies go with their LODs, keeping the stats in sync
+	for (int32 Index = NumLODsToKeep; Index < CompressedLODs.Num(); Index++)
+	{
+		FRuntimeMeshSectionCompression::DiscardCompressedLOD(CompressedLODs[Index]);
+	}
+	if (CompressedLODs.Num() > NumLODsToKeep)
+	{
+		CompressedLODs.SetNum(NumLODsToKeep);
+	}
+	if (LODPositionGrids.Num() > NumLODsToKeep)
+	{
+		LODPositionGrids.SetNum(NumLODsToKeep);
+	}
+	if (LODClusters.Num() > NumLODsToKeep)
+	{
+		LODClusters.SetNum(NumLODsToKeep);
+	}
+
+	LODs.SetNum(NumLODsToKeep);
+}
+
+void FRuntimeMeshSection::ReleaseCPUData()
+{
+	bHadValidMeshData = HasValidMeshData();
+	bHasReleasedData = true;
+
+	// Nothing to unpack into any more
+	for (FRuntimeMeshCompressedLODData& CompressedLOD : CompressedLODs)
+	{
+		FRuntimeMeshSectionCompression::DiscardCompressedLOD(CompressedLOD);
+	}
+	CompressedLODs.Empty();
+	LODPositionGrids.Empty();
+	bIsCompressed = false;
+
+	for (FRuntimeMeshSectionLODData& LOD : LODs)
+	{
+		LOD.EmptyData();
+	}
+}
+
+void FRuntimeMeshSection::CompressData()
+{
+	if (!bCompressCPUData || bIsCompressed || bHasReleasedData)
+	{
+		return;
+	}
+
+	bHadValidMeshData = HasValidMeshData();
+	bIsCompressed = true;
+
+	CompressedLODs.SetNum(LODs.Num());
+	for (int32 Index = 0; Index < LODs.Num(); Index++)
+	{
+		FRuntimeMeshSectionCompression::CompressLOD(LODs[Index], CompressedLODs[Index],
+			LODPositionGrids.IsValidIndex(Index) ? LODPositionGrids[Index] : FRuntimeMeshPositionGrid());
+	}
+	LODPositionGrids.Empty();
+}
+
+void FRuntimeMeshSection::DecompressData()
+{
+	if (!bIsCompressed)
+	{
+		return;
+	}
+
+	LODPositionGrids.SetNum(LODs.Num());
+	for (int32 Index = 0; Index < LODs.Num(); Index++)
+	{
+		LODPositionGrids[Index] = CompressedLODs[Index].PositionGrid;
+		FRuntimeMeshSectionCompression::DecompressLOD(CompressedLODs[Index], LODs[Index]);
+	}
+	CompressedLODs.Empty();
+	bIsCompressed = false;
 }
 
 int32 FRuntimeMeshSection::GetCollisionData(int32 LODIndex, TArray<FVector>& OutPositions, TArray<FTriIndices>& OutIndices, TArray<FVector2D>& OutUVs)
 { 
+	DecompressData();
+
  	int32 StartVertexPosition = OutPositions.Num();
 
 	FRuntimeMeshSectionLODData& LODData = LODs[FMath::Clamp(LODIndex, 0, LODs.Num()-1)];
 
-	OutPositions.Append(reinterpret_cast<FVector*>(LODData.PositionBuffer.GetData().GetData()), LODData.PositionBuffer.GetNumVertices());
+	OutPositions.Append(reinterpret_cast<const FVector*>(LODData.PositionBuffer.GetData().GetData()), LODData.PositionBuffer.GetNumVertices());
   
  	bool bCopyUVs = UPhysicsSettings::Get()->bSupportUVFromHitResults;
  
@@ -271,7 +737,7 @@ int32 FRuntimeMeshSection::GetCollisionData(int32 LODIndex, TArray<FVector>& Out
  	//	}
  	//}
  
- 	TArray<uint8>& IndexData = LODData.IndexBuffer.GetData();
+ 	const TArray<uint8>& IndexData = LODData.IndexBuffer.GetData();
  
  	if (LODData.IndexBuffer.Is32BitIndices())
  	{
@@ -280,9 +746,9 @@ int32 FRuntimeMeshSection::GetCollisionData(int32 LODIndex, TArray<FVector>& Out
  		{
  			// Add the triangle
  			FTriIndices& Triangle = *new (OutIndices) FTriIndices;
- 			Triangle.v0 = (*((int32*)&IndexData[(Index + 0) * 4])) + StartVertexPosition;
- 			Triangle.v1 = (*((int32*)&IndexData[(Index + 1) * 4])) + StartVertexPosition;
- 			Triangle.v2 = (*((int32*)&IndexData[(Index + 2) * 4])) + StartVertexPosition;
+ 			Triangle.v0 = (*((const int32*)&IndexData[(Index + 0) * 4])) + StartVertexPosition;
+ 			Triangle.v1 = (*((const int32*)&IndexData[(Index + 1) * 4])) + StartVertexPosition;
+ 			Triangle.v2 = (*((const int32*)&IndexData[(Index + 2) * 4])) + StartVertexPosition;
  		}
  	}
  	else
@@ -292,9 +758,9 @@ int32 FRuntimeMeshSection::GetCollisionData(int32 LODIndex, TArray<FVector>& Out
  		{
  			// Add the triangle
  			FTriIndices& Triangle = *new (OutIndices) FTriIndices;
- 			Triangle.v0 = (*((uint16*)&IndexData[(Index + 0) * 2])) + StartVertexPosition;
- 			Triangle.v1 = (*((uint16*)&IndexData[(Index + 1) * 2])) + StartVertexPosition;
- 			Triangle.v2 = (*((uint16*)&IndexData[(Index + 2) * 2])) + StartVertexPosition;
+ 			Triangle.v0 = (*((const uint16*)&IndexData[(Index + 0) * 2])) + StartVertexPosition;
+ 			Triangle.v1 = (*((const uint16*)&IndexData[(Index + 1) * 2])) + StartVertexPosition;
+ 			Triangle.v2 = (*((const uint16*)&IndexData[(Index + 2) * 2])) + StartVertexPosition;
  		}
  	}
 
@@ -7,6 +7,11 @@
 
 bool FRuntimeMeshSectionProxyLODData::CanRender()
 {
+	if (ArenaAllocation.IsValid())
+	{
+		return bArenaStreamsValid && ArenaAllocation.NumVertices > 0;
+	}
+
 	if (PositionBuffer.Num() <= 0)
 	{
 		return false;
@@ -31,6 +36,12 @@ void FRuntimeMeshSectionProxyLODData::BuildVertexDataType(FLocalVertexFactory::F
 
 void FRuntimeMeshSectionProxyLODData::CreateMeshBatch(FMeshBatch& MeshBatch, bool bCastsShadow, bool bWantsAdjacencyInfo)
 {
+	if (ArenaAllocation.IsValid())
+	{
+		CreateArenaMeshBatch(MeshBatch, bCastsShadow, bWantsAdjacencyInfo);
+		return;
+	}
+
 	MeshBatch.VertexFactory = &VertexFactory;
 
 	MeshBatch.Type = bWantsAdjacencyInfo ? PT_12_ControlPointPatchList : PT_TriangleList;
@@ -52,14 +63,94 @@ void FRuntimeMeshSectionProxyLODData::CreateMeshBatch(FMeshBatch& MeshBatch, boo
 	BatchElement.NumPrimitives = NumPrimitives;
 	BatchElement.MinVertexIndex = 0;
 	BatchElement.MaxVertexIndex = PositionBuffer.Num() - 1;
+
+	ApplyIndexSegments(MeshBatch, bWantsAdjacencyInfo ? AdjacencyIndexSegments : IndexSegments, NumIndicesPerTriangle, 0, 0, PositionBuffer.Num());
 }
 
+void FRuntimeMeshSectionProxyLODData::CreateArenaMeshBatch(FMeshBatch& MeshBatch, bool bCastsShadow, bool bWantsAdjacencyInfo)
+{
+	FRuntimeMeshArenaPage* Page = ArenaAllocation.Page;
+
+	MeshBatch.VertexFactory = &Page->VertexFactory;
+
+	MeshBatch.Type = bWantsAdjacencyInfo ? PT_12_ControlPointPatchList : PT_TriangleList;
+
+	MeshBatch.DepthPriorityGroup = SDPG_World;
+	MeshBatch.CastShadow = bCastsShadow;
+
+	// Make sure that if the material wants adjacency information, that you supply it
+	check(!bWantsAdjacencyInfo || ArenaAllocation.NumAdjacencyIndices > 0);
 
-FRuntimeMeshSectionProxy::FRuntimeMeshSectionProxy(ERHIFeatureLevel::Type InFeatureLevel, FRuntimeMeshSectionCreationParamsPtr CreationData)
+	int32 NumIndicesPerTriangle = bWantsAdjacencyInfo ? 12 : 3;
+	int32 NumIndices = bWantsAdjacencyInfo ? ArenaAllocation.NumAdjacencyIndices : ArenaAllocation.NumIndices;
+
+	// Indices are local to the section, so draw from the section's slice of the page with them offset by its first vertex
+	FMeshBatchElement& BatchElement = MeshBatch.Elements[0];
+	BatchElement.IndexBuffer = bWantsAdjacencyInfo ? &Page->AdjacencyIndexBuffer : &Page->IndexBuffer;
+	BatchElement.FirstIndex = bWantsAdjacencyInfo ? ArenaAllocation.AdjacencyIndexStart : ArenaAllocation.IndexStart;
+	BatchElement.NumPrimitives = NumIndices / NumIndicesPerTriangle;
+	BatchElement.BaseVertexIndex = ArenaAllocation.VertexStart;
+	BatchElement.MinVertexIndex = 0;
+	BatchElement.MaxVertexIndex = ArenaAllocation.NumVertices - 1;
+
+	// The page vertex factory is shared, so static visibility has to find the section through the batch instead
+	BatchElement.UserData = SectionParent;
+
+	ApplyIndexSegments(MeshBatch, bWantsAdjacencyInfo ? AdjacencyIndexSegments : IndexSegments, NumIndicesPerTriangle,
+		BatchElement.FirstIndex, BatchElement.BaseVertexIndex, ArenaAllocation.NumVertices);
+}
+
+void FRuntimeMeshSectionProxyLODData::ApplyIndexSegments(FMeshBatch& MeshBatch, const TArray<FRuntimeMeshIndexSegment>& Segments, int32 NumIndicesPerPrimitive,
+	int32 FirstIndexOffset, int32 BaseVertexOffset, int32 NumVertices)
+{
+	if (Segments.Num() == 0)
+	{
+		return;
+	}
+
+	// Copy it out first, the elements array is about to be resized
+	const FMeshBatchElement Template = MeshBatch.Elements[0];
+	MeshBatch.Elements.SetNum(Segments.Num());
+
+	for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); SegmentIndex++)
+	{
+		const FRuntimeMeshIndexSegment& Segment = Segments[SegmentIndex];
+
+		FMeshBatchElement& BatchElement = MeshBatch.Elements[SegmentIndex];
+		BatchElement = Template;
+		BatchElement.FirstIndex = FirstIndexOffset + Segment.FirstIndex;
+		BatchElement.NumPrimitives = Segment.NumIndices / NumIndicesPerPrimitive;
+		BatchElement.BaseVertexIndex = BaseVertexOffset + Segment.BaseVertexIndex;
+		BatchElement.MinVertexIndex = 0;
+		BatchElement.MaxVertexIndex = FMath::Clamp(NumVertices - 1 - Segment.BaseVertexIndex, 0, (int32)MAX_uint16);
+	}
+}
+
+
+void FRuntimeMeshSectionProxyLODData::ApplyClusterRanges(FMeshBatch& MeshBatch, const FRuntimeMeshClusterRanges& Ranges)
+{
+	check(Ranges.Num() > 0);
+
+	// Copy it out first, the elements array is about to be resized. Its first index is where the LOD starts in the buffer
+	const FMeshBatchElement Template = MeshBatch.Elements[0];
+	MeshBatch.Elements.SetNum(Ranges.Num());
+
+	for (int32 RangeIndex = 0; RangeIndex < Ranges.Num(); RangeIndex++)
+	{
+		FMeshBatchElement& BatchElement = MeshBatch.Elements[RangeIndex];
+		BatchElement = Template;
+		BatchElement.FirstIndex = Template.FirstIndex + Ranges[RangeIndex].FirstIndex;
+		BatchElement.NumPrimitives = Ranges[RangeIndex].NumIndices / 3;
+	}
+}
+
+
+FRuntimeMeshSectionProxy::FRuntimeMeshSectionProxy(ERHIFeatureLevel::Type InFeatureLevel, FRuntimeMeshSectionCreationParamsPtr CreationData, const FRuntimeMeshArenaPtr& InArena)
 	: FeatureLevel(InFeatureLevel)
 	, UpdateFrequency(CreationData->UpdateFrequency)
 	, bIsVisible(CreationData->bIsVisible)
 	, bCastsShadow(CreationData->bCastsShadow)
+	, Arena(InArena)
 {
 	check(IsInRenderingThread());
 
@@ -70,24 +161,35 @@ FRuntimeMeshSectionProxy::FRuntimeMeshSectionProxy(ERHIFeatureLevel::Type InFeat
 			CreationData->LODs[Index].UVsVertexBuffer.bUsingHighPrecision, CreationData->LODs[Index].UVsVertexBuffer.NumUVs);
 
 		FRuntimeMeshSectionProxyLODData& LODData = LODs[LODs.Num() - 1];
+		LODData.LocalBounds = CreationData->LODs[Index].LocalBounds;
+		LODData.Clusters = CreationData->LODs[Index].Clusters;
+
+		if (Arena.IsValid())
+		{
+			UpdateArenaLOD_RenderThread(LODData, CreationData->LODs[Index], ERuntimeMeshBuffersToUpdate::AllVertexBuffers | 
+				ERuntimeMeshBuffersToUpdate::IndexBuffer | ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer);
+			continue;
+		}
 
-		LODData.PositionBuffer.Reset(CreationData->LODs[0].PositionVertexBuffer.NumVertices);
-		LODData.PositionBuffer.SetData(CreationData->LODs[0].PositionVertexBuffer.Data);
+		LODData.PositionBuffer.Reset(CreationData->LODs[Index].PositionVertexBuffer.NumVertices);
+		LODData.PositionBuffer.SetData(*CreationData->LODs[Index].PositionVertexBuffer.Data);
 
-		LODData.TangentsBuffer.Reset(CreationData->LODs[0].TangentsVertexBuffer.NumVertices);
-		LODData.TangentsBuffer.SetData(CreationData->LODs[0].TangentsVertexBuffer.Data);
+		LODData.TangentsBuffer.Reset(CreationData->LODs[Index].TangentsVertexBuffer.NumVertices);
+		LODData.TangentsBuffer.SetData(*CreationData->LODs[Index].TangentsVertexBuffer.Data);
 
-		LODData.UVsBuffer.Reset(CreationData->LODs[0].UVsVertexBuffer.NumVertices);
-		LODData.UVsBuffer.SetData(CreationData->LODs[0].UVsVertexBuffer.Data);
+		LODData.UVsBuffer.Reset(CreationData->LODs[Index].UVsVertexBuffer.NumVertices);
+		LODData.UVsBuffer.SetData(*CreationData->LODs[Index].UVsVertexBuffer.Data);
 
-		LODData.ColorBuffer.Reset(CreationData->LODs[0].ColorVertexBuffer.NumVertices);
-		LODData.ColorBuffer.SetData(CreationData->LODs[0].ColorVertexBuffer.Data);
+		LODData.ColorBuffer.Reset(CreationData->LODs[Index].ColorVertexBuffer.NumVertices);
+		LODData.ColorBuffer.SetData(*CreationData->LODs[Index].ColorVertexBuffer.Data);
 
-		LODData.IndexBuffer.Reset(CreationData->LODs[0].IndexBuffer.b32BitIndices ? 4 : 2, CreationData->LODs[0].IndexBuffer.NumIndices, UpdateFrequency);
-		LODData.IndexBuffer.SetData(CreationData->LODs[0].IndexBuffer.Data);
+		LODData.IndexBuffer.Reset(CreationData->LODs[Index].IndexBuffer.b32BitIndices ? 4 : 2, CreationData->LODs[Index].IndexBuffer.NumIndices, UpdateFrequency);
+		LODData.IndexBuffer.SetData(*CreationData->LODs[Index].IndexBuffer.Data);
+		LODData.IndexSegments = CreationData->LODs[Index].IndexBuffer.Segments;
 
-		LODData.AdjacencyIndexBuffer.Reset(CreationData->LODs[0].IndexBuffer.b32BitIndices ? 4 : 2, CreationData->LODs[0].AdjacencyIndexBuffer.NumIndices, UpdateFrequency);
-		LODData.AdjacencyIndexBuffer.SetData(CreationData->LODs[0].AdjacencyIndexBuffer.Data);
+		LODData.AdjacencyIndexBuffer.Reset(CreationData->LODs[Index].AdjacencyIndexBuffer.b32BitIndices ? 4 : 2, CreationData->LODs[Index].AdjacencyIndexBuffer.NumIndices, UpdateFrequency);
+		LODData.AdjacencyIndexBuffer.SetData(*CreationData->LODs[Index].AdjacencyIndexBuffer.Data);
+		LODData.AdjacencyIndexSegments = CreationData->LODs[Index].AdjacencyIndexBuffer.Segments;
 
 #if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 19
 		if (CanRender())
@@ -106,7 +208,13 @@ FRuntimeMeshSectionProxy::FRuntimeMeshSectionProxy(ERHIFeatureLevel::Type InFeat
 
 FRuntimeMeshSectionProxy::~FRuntimeMeshSectionProxy()
 {
-
+	if (Arena.IsValid())
+	{
+		for (FRuntimeMeshSectionProxyLODData& LODData : LODs)
+		{
+			Arena->Free(LODData.ArenaAllocation);
+		}
+	}
 }
 
 void FRuntimeMeshSectionProxy::EnsureHasLOD(int32 LODIndex)
@@ -158,6 +266,11 @@ void FRuntimeMeshSectionProxy::FinishUpdate_RenderThread(FRuntimeMeshSectionUpda
 		int32 CurrentIndex = LODs.Emplace(FeatureLevel, this, UpdateFrequency, UpdateData->TangentsVertexBuffer.bUsingHighPrecision,
 			UpdateData->UVsVertexBuffer.bUsingHighPrecision, UpdateData->UVsVertexBuffer.NumUVs);
 
+		// Arena LODs draw with their page's vertex factory
+		if (Arena.IsValid())
+		{
+			continue;
+		}
 
 #if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 19
 		if (CanRender())
@@ -176,51 +289,79 @@ void FRuntimeMeshSectionProxy::FinishUpdate_RenderThread(FRuntimeMeshSectionUpda
 
 	FRuntimeMeshSectionProxyLODData& LODData = LODs[UpdateData->LODIndex];
 
+	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::PositionBuffer))
+	{
+		LODData.LocalBounds = UpdateData->LocalBounds;
+	}
+
+	if (!!(BuffersToUpdate & (ERuntimeMeshBuffersToUpdate::PositionBuffer | ERuntimeMeshBuffersToUpdate::IndexBuffer)))
+	{
+		LODData.Clusters = UpdateData->Clusters;
+	}
+
+	if (Arena.IsValid())
+	{
+		UpdateArenaLOD_RenderThread(LODData, *UpdateData, BuffersToUpdate);
+		return;
+	}
+
+	// Locking part of a buffer doesn't keep the rest of it on every RHI, so sections with their own buffers are only sent whole streams
+	// (see FRuntimeMeshData::UpdateSectionInternal). Buffers keep their allocation while the new data fits, so track whether any vertex
+	// buffer was actually recreated
+	bool bRecreatedBuffers = false;
+
 	// Update position buffer
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::PositionBuffer))
 	{
-		LODData.PositionBuffer.Reset(UpdateData->PositionVertexBuffer.NumVertices);
-		LODData.PositionBuffer.SetData(UpdateData->PositionVertexBuffer.Data);
+		check(!UpdateData->PositionVertexBuffer.bIsPartialUpdate);
+		bRecreatedBuffers |= LODData.PositionBuffer.SetNum(UpdateData->PositionVertexBuffer.NumVertices);
+		LODData.PositionBuffer.SetData(*UpdateData->PositionVertexBuffer.Data);
 	}
 
 	// Update tangent buffer
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::TangentBuffer))
 	{
-		LODData.TangentsBuffer.SetNum(UpdateData->TangentsVertexBuffer.NumVertices);
-		LODData.TangentsBuffer.SetData(UpdateData->TangentsVertexBuffer.Data);
+		check(!UpdateData->TangentsVertexBuffer.bIsPartialUpdate);
+		bRecreatedBuffers |= LODData.TangentsBuffer.SetNum(UpdateData->TangentsVertexBuffer.NumVertices);
+		LODData.TangentsBuffer.SetData(*UpdateData->TangentsVertexBuffer.Data);
 	}
 
 	// Update uv buffer
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::UVBuffer))
 	{
-		LODData.UVsBuffer.SetNum(UpdateData->UVsVertexBuffer.NumVertices);
-		LODData.UVsBuffer.SetData(UpdateData->UVsVertexBuffer.Data);
+		check(!UpdateData->UVsVertexBuffer.bIsPartialUpdate);
+		bRecreatedBuffers |= LODData.UVsBuffer.SetNum(UpdateData->UVsVertexBuffer.NumVertices);
+		LODData.UVsBuffer.SetData(*UpdateData->UVsVertexBuffer.Data);
 	}
 
 	// Update color buffer
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::ColorBuffer))
 	{
-		LODData.ColorBuffer.SetNum(UpdateData->ColorVertexBuffer.NumVertices);
-		LODData.ColorBuffer.SetData(UpdateData->ColorVertexBuffer.Data);
+		check(!UpdateData->ColorVertexBuffer.bIsPartialUpdate);
+		bRecreatedBuffers |= LODData.ColorBuffer.SetNum(UpdateData->ColorVertexBuffer.NumVertices);
+		LODData.ColorBuffer.SetData(*UpdateData->ColorVertexBuffer.Data);
 	}
 
 	// Update index buffer
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer))
 	{
-		LODData.IndexBuffer.Reset(UpdateData->IndexBuffer.b32BitIndices ? 4 : 2, UpdateData->IndexBuffer.NumIndices, UpdateFrequency);
-		LODData.IndexBuffer.SetData(UpdateData->IndexBuffer.Data);
+		check(!UpdateData->IndexBuffer.bIsPartialUpdate);
+		LODData.IndexBuffer.Resize(UpdateData->IndexBuffer.b32BitIndices ? 4 : 2, UpdateData->IndexBuffer.NumIndices, UpdateFrequency);
+		LODData.IndexBuffer.SetData(*UpdateData->IndexBuffer.Data);
+		LODData.IndexSegments = UpdateData->IndexBuffer.Segments;
 	}
 
 	// Update index buffer
 	if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer))
 	{
-		LODData.AdjacencyIndexBuffer.Reset(UpdateData->AdjacencyIndexBuffer.b32BitIndices ? 4 : 2, UpdateData->AdjacencyIndexBuffer.NumIndices, UpdateFrequency);
-		LODData.AdjacencyIndexBuffer.SetData(UpdateData->AdjacencyIndexBuffer.Data);
+		LODData.AdjacencyIndexBuffer.Resize(UpdateData->AdjacencyIndexBuffer.b32BitIndices ? 4 : 2, UpdateData->AdjacencyIndexBuffer.NumIndices, UpdateFrequency);
+		LODData.AdjacencyIndexBuffer.SetData(*UpdateData->AdjacencyIndexBuffer.Data);
+		LODData.AdjacencyIndexSegments = UpdateData->AdjacencyIndexBuffer.Segments;
 	}
 
 #if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 19
 	// If this platform uses manual vertex fetch, we need to update the SRVs
-	if (RHISupportsManualVertexFetch(GMaxRHIShaderPlatform))
+	if (bRecreatedBuffers && RHISupportsManualVertexFetch(GMaxRHIShaderPlatform))
 	{
 		FLocalVertexFactory::FDataType DataType;
 		LODData.BuildVertexDataType(DataType);
@@ -238,3 +379,92 @@ void FRuntimeMeshSectionProxy::FinishPropertyUpdate_RenderThread(FRuntimeMeshSec
 	bIsVisible = UpdateData->bIsVisible;
 	bCastsShadow = UpdateData->bCastsShadow;
 }
+
+void FRuntimeMeshSectionProxy::UpdateArenaLOD_RenderThread(FRuntimeMeshSectionProxyLODData& LODData, const FRuntimeMeshSectionLODUpdateParams& UpdateData, ERuntimeMeshBuffersToUpdate BuffersToUpdate)
+{
+	check(IsInRenderingThread());
+	check(Arena.IsValid());
+
+	FRuntimeMeshArenaAllocation& Allocation = LODData.ArenaAllocation;
+
+	const ERuntimeMeshBuffersToUpdate AllBuffers = ERuntimeMeshBuffersToUpdate::AllVertexBuffers | ERuntimeMeshBuffersToUpdate::IndexBuffer | ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer;
+
+	// Anything other than a partial update sends every buffer, since the LOD may have to move within the arena
+	if (BuffersToUpdate != AllBuffers)
+	{
+		check(Allocation.IsValid());
+
+		auto WritePartialVertices = [&](ERuntimeMeshBuffersToUpdate Stream, const FRuntimeMeshSectionVertexBufferParams& Params)
+		{
+			check(Params.bIsPartialUpdate && Params.NumVertices == Allocation.NumVertices);
+			Allocation.Page->WriteVertices(Stream, *Params.Data, Allocation.VertexStart + Params.StartVertex);
+		};
+
+		if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::PositionBuffer))
+		{
+			WritePartialVertices(ERuntimeMeshBuffersToUpdate::PositionBuffer, UpdateData.PositionVertexBuffer);
+		}
+		if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::TangentBuffer))
+		{
+			WritePartialVertices(ERuntimeMeshBuffersToUpdate::TangentBuffer, UpdateData.TangentsVertexBuffer);
+		}
+		if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::UVBuffer))
+		{
+			WritePartialVertices(ERuntimeMeshBuffersToUpdate::UVBuffer, UpdateData.UVsVertexBuffer);
+		}
+		if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::ColorBuffer))
+		{
+			WritePartialVertices(ERuntimeMeshBuffersToUpdate::ColorBuffer, UpdateData.ColorVertexBuffer);
+		}
+		if (!!(BuffersToUpdate & ERuntimeMeshBuffersToUpdate::IndexBuffer))
+		{
+			check(UpdateData.IndexBuffer.bIsPartialUpdate && UpdateData.IndexBuffer.NumIndices == Allocation.NumIndices);
+			Allocation.Page->WriteIndices(ERuntimeMeshBuffersToUpdate::IndexBuffer, *UpdateData.IndexBuffer.Data, Allocation.IndexStart + UpdateData.IndexBuffer.StartIndex);
+		}
+		return;
+	}
+
+	const int32 NumVertices = UpdateData.PositionVertexBuffer.NumVertices;
+	const int32 NumIndices = UpdateData.IndexBuffer.NumIndices;
+	const int32 NumAdjacencyIndices = UpdateData.AdjacencyIndexBuffer.NumIndices;
+
+	const FRuntimeMeshArenaFormat Format(UpdateFrequency, UpdateData.TangentsVertexBuffer.bUsingHighPrecision, UpdateData.UVsVertexBuffer.bUsingHighPrecision,
+		UpdateData.UVsVertexBuffer.NumUVs, UpdateData.IndexBuffer.b32BitIndices ? 4 : 2);
+
+	// Keep the existing space if the LOD is still the same shape, otherwise move it
+	if (!Allocation.IsValid() || !(Allocation.Page->Format == Format) || Allocation.NumVertices != NumVertices ||
+		Allocation.NumIndices != NumIndices || Allocation.NumAdjacencyIndices != NumAdjacencyIndices)
+	{
+		Arena->Free(Allocation);
+		Allocation = Arena->Allocate(Format, NumVertices, NumIndices, NumAdjacencyIndices);
+	}
+
+	FRuntimeMeshArenaPage* Page = Allocation.Page;
+
+	// Streams share a single vertex range, so only write the ones that actually fit it
+	LODData.bArenaStreamsValid = UpdateData.TangentsVertexBuffer.NumVertices == NumVertices && UpdateData.UVsVertexBuffer.NumVertices == NumVertices;
+
+	Page->WriteVertices(ERuntimeMeshBuffersToUpdate::PositionBuffer, *UpdateData.PositionVertexBuffer.Data, Allocation.VertexStart);
+	if (LODData.bArenaStreamsValid)
+	{
+		Page->WriteVertices(ERuntimeMeshBuffersToUpdate::TangentBuffer, *UpdateData.TangentsVertexBuffer.Data, Allocation.VertexStart);
+		Page->WriteVertices(ERuntimeMeshBuffersToUpdate::UVBuffer, *UpdateData.UVsVertexBuffer.Data, Allocation.VertexStart);
+	}
+
+	if (UpdateData.ColorVertexBuffer.NumVertices == NumVertices)
+	{
+		Page->WriteVertices(ERuntimeMeshBuffersToUpdate::ColorBuffer, *UpdateData.ColorVertexBuffer.Data, Allocation.VertexStart);
+	}
+	else if (NumVertices > 0)
+	{
+		// The range may hold another section's old colors, so default it to white
+		TArray<uint8> DefaultColors;
+		DefaultColors.Init(0xFF, NumVertices * sizeof(FColor));
+		Page->WriteVertices(ERuntimeMeshBuffersToUpdate::ColorBuffer, DefaultColors, Allocation.VertexStart);
+	}
+
+	Page->WriteIndices(ERuntimeMeshBuffersToUpdate::IndexBuffer, *UpdateData.IndexBuffer.Data, Allocation.IndexStart);
+	Page->WriteIndices(ERuntimeMeshBuffersToUpdate::AdjacencyIndexBuffer, *UpdateData.AdjacencyIndexBuffer.Data, Allocation.AdjacencyIndexStart);
+	LODData.IndexSegments = UpdateData.IndexBuffer.Segments;
+	LODData.AdjacencyIndexSegments = UpdateData.AdjacencyIndexBuffer.Segments;
+}
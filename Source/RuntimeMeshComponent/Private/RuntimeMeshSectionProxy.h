@@ -6,6 +6,7 @@
 #include "Components/MeshComponent.h"
 #include "RuntimeMeshRendering.h"
 #include "RuntimeMeshUpdateCommands.h"
+#include "RuntimeMeshArena.h"
 
 
 struct FRuntimeMeshSectionNullBufferElement
@@ -23,6 +24,14 @@ struct FRuntimeMeshSectionNullBufferElement
 	{ }
 };
 
+/** Run of indices of visible clusters within a LOD's index buffer */
+struct FRuntimeMeshClusterRange
+{
+	int32 FirstIndex;
+	int32 NumIndices;
+};
+using FRuntimeMeshClusterRanges = TArray<FRuntimeMeshClusterRange, TInlineAllocator<32>>;
+
 class FRuntimeMeshSectionProxyLODData
 {
 public:
@@ -48,6 +57,25 @@ public:
 	/** Index buffer for this section */
 	FRuntimeMeshIndexBuffer AdjacencyIndexBuffer;
 
+	/** Segments of the index buffers when their 16 bit indices are relative to per segment base vertices. Empty for plain indices */
+	TArray<FRuntimeMeshIndexSegment> IndexSegments;
+	TArray<FRuntimeMeshIndexSegment> AdjacencyIndexSegments;
+
+	/** Space in the mesh's shared arena, when it has one. The buffers above are left empty in that case */
+	FRuntimeMeshArenaAllocation ArenaAllocation;
+
+	/** Did the last arena upload have matching position/tangent/uv counts */
+	bool bArenaStreamsValid;
+
+	/** Local space bounds of this LOD, used to frustum cull it on its own. Invalid if unknown */
+	FBox LocalBounds;
+
+	/** Clusters of the index buffer that can be culled on their own, empty if the LOD isn't clustered */
+	TArray<FRuntimeMeshCluster> Clusters;
+
+	/** Section that owns this LOD */
+	FRuntimeMeshSectionProxy* SectionParent;
+
 	FRuntimeMeshSectionProxyLODData(ERHIFeatureLevel::Type InFeatureLevel, FRuntimeMeshSectionProxy* InSectionParent, EUpdateFrequency UpdateFrequency, bool bUseHighPrecisionTangents, bool bUseHighPrecisionUVs, int32 NumUVs)
 		: VertexFactory(InFeatureLevel, InSectionParent)
 		, PositionBuffer(UpdateFrequency)
@@ -56,6 +84,9 @@ public:
 		, ColorBuffer(UpdateFrequency)
 		, IndexBuffer(UpdateFrequency, false)
 		, AdjacencyIndexBuffer(UpdateFrequency, false)
+		, bArenaStreamsValid(false)
+		, LocalBounds(EForceInit::ForceInit)
+		, SectionParent(InSectionParent)
 	{
 
 	}
@@ -75,12 +106,25 @@ public:
 
 
 	bool CanRender();
-	FRuntimeMeshVertexFactory* GetVertexFactory() { return &VertexFactory; }
+	FRuntimeMeshVertexFactory* GetVertexFactory() { return ArenaAllocation.IsValid() ? &ArenaAllocation.Page->VertexFactory : &VertexFactory; }
 	void BuildVertexDataType(FLocalVertexFactory::FDataType& DataType);
 
 
 
 	void CreateMeshBatch(FMeshBatch& MeshBatch, bool bCastsShadow, bool bWantsAdjacencyInfo);
+
+	/** Can the LOD be drawn as ranges of its clusters. Adjacency and segmented indices aren't laid out by cluster */
+	bool CanDrawClusters(bool bWantsAdjacencyInfo) const { return Clusters.Num() > 0 && !bWantsAdjacencyInfo && IndexSegments.Num() == 0; }
+
+	/** Narrows a batch made by CreateMeshBatch down to ranges of the LOD's index buffer, one element each */
+	static void ApplyClusterRanges(FMeshBatch& MeshBatch, const FRuntimeMeshClusterRanges& Ranges);
+
+private:
+	void CreateArenaMeshBatch(FMeshBatch& MeshBatch, bool bCastsShadow, bool bWantsAdjacencyInfo);
+
+	/** Replaces the single batch element with one per index segment, offset by the start of the LOD's indices and vertices */
+	static void ApplyIndexSegments(FMeshBatch& MeshBatch, const TArray<FRuntimeMeshIndexSegment>& Segments, int32 NumIndicesPerPrimitive,
+		int32 FirstIndexOffset, int32 BaseVertexOffset, int32 NumVertices);
 };
 
 
@@ -99,8 +143,11 @@ class FRuntimeMeshSectionProxy : public TSharedFromThis<FRuntimeMeshSectionProxy
 	/** Should this section cast a shadow */
 	bool bCastsShadow;
 
+	/** Shared buffers of the parent mesh this section is suballocated from, null if the section owns its own buffers */
+	FRuntimeMeshArenaPtr Arena;
+
 public:
-	FRuntimeMeshSectionProxy(ERHIFeatureLevel::Type InFeatureLevel, FRuntimeMeshSectionCreationParamsPtr CreationData);
+	FRuntimeMeshSectionProxy(ERHIFeatureLevel::Type InFeatureLevel, FRuntimeMeshSectionCreationParamsPtr CreationData, const FRuntimeMeshArenaPtr& InArena = nullptr);
 
 	~FRuntimeMeshSectionProxy();
 
@@ -121,6 +168,10 @@ public:
 	void FinishUpdate_RenderThread(FRuntimeMeshSectionUpdateParamsPtr UpdateData);
 
 	void FinishPropertyUpdate_RenderThread(FRuntimeMeshSectionPropertyUpdateParamsPtr UpdateData);
+
+private:
+	/** Writes LOD data into its arena page, moving the LOD to new space if its size or format changed. Reaches the GPU when the arena is flushed */
+	void UpdateArenaLOD_RenderThread(FRuntimeMeshSectionProxyLODData& LODData, const FRuntimeMeshSectionLODUpdateParams& UpdateData, ERuntimeMeshBuffersToUpdate BuffersToUpdate);
 };
 
 
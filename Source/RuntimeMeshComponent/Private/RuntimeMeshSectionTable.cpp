@@ -0,0 +1,129 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshSectionTable.h"
+#include "RuntimeMeshComponentPlugin.h"
+
+
+void FRuntimeMeshSectionTable::Add(int32 SectionId, const FRuntimeMeshSectionPtr& Section)
+{
+	check(SectionId >= 0);
+	check(Section.IsValid());
+
+	if (Contains(SectionId))
+	{
+		DenseSections[SparseIndices[SectionId]] = Section;
+		return;
+	}
+
+	// Growing past the end leaves a gap of free ids behind the new one
+	if (SectionId >= SparseIndices.Num())
+	{
+		const int32 OldNum = SparseIndices.Num();
+		SparseIndices.SetNum(SectionId + 1);
+		for (int32 Id = OldNum; Id < SectionId; Id++)
+		{
+			SparseIndices[Id] = INDEX_NONE;
+			FreeIds.HeapPush(Id);
+		}
+	}
+
+	SparseIndices[SectionId] = DenseSections.Add(Section);
+	DenseIds.Add(SectionId);
+
+	// Drop any ids from the top of the heap that are no longer free
+	while (FreeIds.Num() > 0 && FreeIds.HeapTop() < SparseIndices.Num() && SparseIndices[FreeIds.HeapTop()] != INDEX_NONE)
+	{
+		int32 UsedId;
+		FreeIds.HeapPop(UsedId, false);
+	}
+
+	// Ids reused without going through the top stay in the heap, so clean up if they start to pile up
+	if (FreeIds.Num() > SparseIndices.Num() * 2 + 32)
+	{
+		RebuildFreeIds();
+	}
+}
+
+bool FRuntimeMeshSectionTable::Remove(int32 SectionId)
+{
+	if (!Contains(SectionId))
+	{
+		return false;
+	}
+
+	// Move the last live section into the hole
+	const int32 DenseIndex = SparseIndices[SectionId];
+	const int32 LastIndex = DenseSections.Num() - 1;
+	if (DenseIndex != LastIndex)
+	{
+		SparseIndices[DenseIds[LastIndex]] = DenseIndex;
+	}
+	DenseSections.RemoveAtSwap(DenseIndex, 1, false);
+	DenseIds.RemoveAtSwap(DenseIndex, 1, false);
+	SparseIndices[SectionId] = INDEX_NONE;
+
+	// Strip trailing free ids so GetMaxId stays one past the last section
+	int32 NewNum = SparseIndices.Num();
+	while (NewNum > 0 && SparseIndices[NewNum - 1] == INDEX_NONE)
+	{
+		NewNum--;
+	}
+	SparseIndices.SetNum(NewNum, false);
+
+	if (SectionId < NewNum)
+	{
+		FreeIds.HeapPush(SectionId);
+	}
+	return true;
+}
+
+void FRuntimeMeshSectionTable::Empty()
+{
+	SparseIndices.Empty();
+	DenseSections.Empty();
+	DenseIds.Empty();
+	FreeIds.Empty();
+}
+
+void FRuntimeMeshSectionTable::RebuildFreeIds()
+{
+	FreeIds.Reset();
+	for (int32 Id = 0; Id < SparseIndices.Num(); Id++)
+	{
+		if (SparseIndices[Id] == INDEX_NONE)
+		{
+			FreeIds.Add(Id);
+		}
+	}
+	// Ids were added in order, so this is already a valid min heap
+}
+
+FArchive& operator <<(FArchive& Ar, FRuntimeMeshSectionTable& Table)
+{
+	// Keep the same format as the flat array of sections this used to be
+	if (Ar.IsSaving())
+	{
+		TArray<FRuntimeMeshSectionPtr> Sections;
+		Sections.SetNum(Table.GetMaxId());
+		for (int32 Index = 0; Index < Table.Num(); Index++)
+		{
+			Sections[Table.GetIdAt(Index)] = Table.GetAt(Index);
+		}
+		Ar << Sections;
+	}
+	else if (Ar.IsLoading())
+	{
+		TArray<FRuntimeMeshSectionPtr> Sections;
+		Ar << Sections;
+
+		Table.Empty();
+		for (int32 SectionId = 0; SectionId < Sections.Num(); SectionId++)
+		{
+			if (Sections[SectionId].IsValid())
+			{
+				Table.Add(SectionId, Sections[SectionId]);
+			}
+		}
+	}
+	return Ar;
+}
@@ -0,0 +1,610 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshSimplifier.h"
+#include "RuntimeMeshComponentPlugin.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("RM - Simplify"), STAT_RuntimeMesh_Simplify, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Simplify - Build LOD"), STAT_RuntimeMesh_Simplify_BuildLOD, STATGROUP_RuntimeMesh);
+
+
+// Sum of squared distances to a set of planes, as a symmetric 4x4 matrix. Doubles as the sums get large quickly
+struct FRuntimeMeshQuadric
+{
+	double A00, A01, A02, A11, A12, A22;
+	double B0, B1, B2;
+	double C;
+
+	FRuntimeMeshQuadric()
+		: A00(0), A01(0), A02(0), A11(0), A12(0), A22(0), B0(0), B1(0), B2(0), C(0)
+	{ }
+
+	// Plane through Point with the given unit normal
+	FRuntimeMeshQuadric(const FVector& Normal, const FVector& Point, double Weight)
+	{
+		const double X = Normal.X, Y = Normal.Y, Z = Normal.Z;
+		const double D = -FVector::DotProduct(Normal, Point);
+
+		A00 = Weight * X * X; A01 = Weight * X * Y; A02 = Weight * X * Z;
+		A11 = Weight * Y * Y; A12 = Weight * Y * Z;
+		A22 = Weight * Z * Z;
+		B0 = Weight * X * D; B1 = Weight * Y * D; B2 = Weight * Z * D;
+		C = Weight * D * D;
+	}
+
+	FRuntimeMeshQuadric& operator+=(const FRuntimeMeshQuadric& Other)
+	{
+		A00 += Other.A00; A01 += Other.A01; A02 += Other.A02;
+		A11 += Other.A11; A12 += Other.A12;
+		A22 += Other.A22;
+		B0 += Other.B0; B1 += Other.B1; B2 += Other.B2;
+		C += Other.C;
+		return *this;
+	}
+
+	double Evaluate(const FVector& Point) const
+	{
+		const double X = Point.X, Y = Point.Y, Z = Point.Z;
+		return X * X * A00 + Y * Y * A11 + Z * Z * A22 + 2.0 * (X * Y * A01 + X * Z * A02 + Y * Z * A12) + 2.0 * (X * B0 + Y * B1 + Z * B2) + C;
+	}
+};
+
+// Moving all vertices at one position onto a neighboring position
+struct FRuntimeMeshCollapse
+{
+	double Cost;
+	int32 Position;
+	int32 Target;
+	uint32 Version;
+
+	FRuntimeMeshCollapse(double InCost, int32 InPosition, int32 InTarget, uint32 InVersion)
+		: Cost(InCost), Position(InPosition), Target(InTarget), Version(InVersion)
+	{ }
+
+	bool operator<(const FRuntimeMeshCollapse& Other) const { return Cost < Other.Cost; }
+};
+
+// A position connected to the one being looked at, and how the triangles across the edge between them use their vertices
+struct FRuntimeMeshSimplifierNeighbor
+{
+	int32 Position;
+	int32 NumTriangles;
+	int32 Vertex;
+	int32 NeighborVertex;
+	bool bSeam;
+
+	bool IsFeature() const { return NumTriangles == 1 || bSeam; }
+};
+
+
+/*
+*	Vertices are grouped by position, and collapses move all the vertices at a position together so attribute seams
+*	stay closed. Each vertex moves onto the vertex at the target position it shares a triangle with.
+*/
+class FRuntimeMeshSimplifierState
+{
+	const FRuntimeMeshAccessor& Source;
+	const FRuntimeMeshSimplificationSettings& Settings;
+
+	int32 NumUVs;
+
+	// Per vertex
+	TArray<FVector> Normals;
+	TArray<FVector2D> UVs;
+	TArray<int32> VertexPositions;
+	TArray<int32> NextVertexAtPosition;
+
+	// Per position
+	TArray<FVector> Positions;
+	TArray<int32> FirstVertexAtPosition;
+	TArray<FRuntimeMeshQuadric> Quadrics;
+	TArray<TArray<int32>> PositionTriangles;
+	TArray<uint32> Versions;
+	TArray<bool> PositionAlive;
+
+	// Per triangle
+	TArray<int32> Indices;
+	TArray<bool> TriangleAlive;
+	int32 NumAliveTriangles;
+
+	TArray<FRuntimeMeshCollapse> Heap;
+
+	// Scratch space reused between collapses
+	TArray<FRuntimeMeshSimplifierNeighbor> Neighbors;
+	TArray<TPair<int32, int32>> VertexTargets;
+
+public:
+	FRuntimeMeshSimplifierState(const FRuntimeMeshAccessor& InSource, const FRuntimeMeshSimplificationSettings& InSettings)
+		: Source(InSource), Settings(InSettings), NumUVs(InSource.NumUVChannels()), NumAliveTriangles(0)
+	{
+	}
+
+	int32 GetNumAliveTriangles() const { return NumAliveTriangles; }
+
+	bool Initialize()
+	{
+		const int32 NumVertices = Source.NumVertices();
+		const int32 NumIndices = Source.NumIndices();
+		if (NumIndices == 0 || NumIndices % 3 != 0)
+		{
+			return false;
+		}
+
+		Normals.SetNumUninitialized(NumVertices);
+		UVs.SetNumUninitialized(NumVertices * NumUVs);
+		VertexPositions.SetNumUninitialized(NumVertices);
+		NextVertexAtPosition.SetNumUninitialized(NumVertices);
+
+		TMap<FVector, int32> PositionMap;
+		PositionMap.Reserve(NumVertices);
+
+		for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+		{
+			Normals[Vertex] = FVector(Source.GetNormal(Vertex));
+			for (int32 Channel = 0; Channel < NumUVs; Channel++)
+			{
+				UVs[Vertex * NumUVs + Channel] = Source.GetUV(Vertex, Channel);
+			}
+
+			const FVector Position = Source.GetPosition(Vertex);
+			int32* ExistingPosition = PositionMap.Find(Position);
+			if (ExistingPosition)
+			{
+				VertexPositions[Vertex] = *ExistingPosition;
+				NextVertexAtPosition[Vertex] = FirstVertexAtPosition[*ExistingPosition];
+				FirstVertexAtPosition[*ExistingPosition] = Vertex;
+			}
+			else
+			{
+				const int32 NewPosition = Positions.Add(Position);
+				PositionMap.Add(Position, NewPosition);
+				FirstVertexAtPosition.Add(Vertex);
+				VertexPositions[Vertex] = NewPosition;
+				NextVertexAtPosition[Vertex] = INDEX_NONE;
+			}
+		}
+
+		const int32 NumPositions = Positions.Num();
+		Quadrics.SetNum(NumPositions);
+		PositionTriangles.SetNum(NumPositions);
+		Versions.SetNumZeroed(NumPositions);
+		PositionAlive.Init(true, NumPositions);
+
+		Indices.SetNumUninitialized(NumIndices);
+		TriangleAlive.Init(false, NumIndices / 3);
+
+		for (int32 Index = 0; Index < NumIndices; Index++)
+		{
+			Indices[Index] = Source.GetIndex(Index);
+			if (Indices[Index] < 0 || Indices[Index] >= NumVertices)
+			{
+				return false;
+			}
+		}
+
+		// Face quadrics, weighted by area so small triangles don't outweigh big ones
+		for (int32 Triangle = 0; Triangle < NumIndices / 3; Triangle++)
+		{
+			const int32 P0 = VertexPositions[Indices[Triangle * 3 + 0]];
+			const int32 P1 = VertexPositions[Indices[Triangle * 3 + 1]];
+			const int32 P2 = VertexPositions[Indices[Triangle * 3 + 2]];
+			if (P0 == P1 || P1 == P2 || P0 == P2)
+			{
+				continue;
+			}
+
+			TriangleAlive[Triangle] = true;
+			NumAliveTriangles++;
+			PositionTriangles[P0].Add(Triangle);
+			PositionTriangles[P1].Add(Triangle);
+			PositionTriangles[P2].Add(Triangle);
+
+			const FVector Normal = GetTriangleNormal(Triangle);
+			const float DoubleArea = Normal.Size();
+			if (DoubleArea > SMALL_NUMBER)
+			{
+				const FRuntimeMeshQuadric Quadric(Normal / DoubleArea, Positions[P0], DoubleArea * 0.5);
+				Quadrics[P0] += Quadric;
+				Quadrics[P1] += Quadric;
+				Quadrics[P2] += Quadric;
+			}
+		}
+
+		// Planes at right angles to the triangles along borders and seams, so moving off them costs more than moving along them
+		for (int32 Position = 0; Position < NumPositions; Position++)
+		{
+			GatherNeighbors(Position);
+			for (const FRuntimeMeshSimplifierNeighbor& Neighbor : Neighbors)
+			{
+				// Each edge is seen from both ends, only add it once
+				if (!Neighbor.IsFeature() || Neighbor.Position < Position)
+				{
+					continue;
+				}
+
+				for (int32 Triangle : PositionTriangles[Position])
+				{
+					if (!TriangleContainsPosition(Triangle, Neighbor.Position))
+					{
+						continue;
+					}
+
+					const FVector Edge = Positions[Neighbor.Position] - Positions[Position];
+					const FVector BorderNormal = FVector::CrossProduct(Edge, GetTriangleNormal(Triangle)).GetSafeNormal();
+					if (!BorderNormal.IsZero())
+					{
+						const FRuntimeMeshQuadric Quadric(BorderNormal, Positions[Position], Edge.SizeSquared() * Settings.BorderWeight);
+						Quadrics[Position] += Quadric;
+						Quadrics[Neighbor.Position] += Quadric;
+					}
+				}
+			}
+		}
+
+		for (int32 Position = 0; Position < NumPositions; Position++)
+		{
+			UpdateCollapse(Position);
+		}
+
+		return true;
+	}
+
+	/** Collapses the cheapest edges until there are no more than TargetTriangles left, or nothing can be collapsed */
+	void Simplify(int32 TargetTriangles)
+	{
+		while (NumAliveTriangles > TargetTriangles && Heap.Num() > 0)
+		{
+			FRuntimeMeshCollapse Collapse = Heap.HeapTop();
+			Heap.HeapPopDiscard(false);
+
+			// Anything that changed around either position since this was found means it has to be found again
+			if (!PositionAlive[Collapse.Position] || !PositionAlive[Collapse.Target] || Versions[Collapse.Position] != Collapse.Version)
+			{
+				continue;
+			}
+
+			if (!FindVertexTargets(Collapse.Position, Collapse.Target))
+			{
+				UpdateCollapse(Collapse.Position);
+				continue;
+			}
+
+			ApplyCollapse(Collapse.Position, Collapse.Target);
+		}
+	}
+
+	/** Copies the remaining triangles and the vertices they use into a new builder in the source's format */
+	FRuntimeMeshBuilderPtr BuildLOD() const
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Simplify_BuildLOD);
+
+		FRuntimeMeshBuilderRef Builder = MakeRuntimeMeshBuilder(Source);
+
+		TArray<int32> NewIndices;
+		NewIndices.Init(INDEX_NONE, Normals.Num());
+
+		Builder->EmptyIndices(NumAliveTriangles * 3);
+		for (int32 Triangle = 0; Triangle < TriangleAlive.Num(); Triangle++)
+		{
+			if (!TriangleAlive[Triangle])
+			{
+				continue;
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const int32 Vertex = Indices[Triangle * 3 + Corner];
+				if (NewIndices[Vertex] == INDEX_NONE)
+				{
+					NewIndices[Vertex] = Builder->AddVertex(Source.GetVertex(Vertex));
+				}
+				Builder->AddIndex(NewIndices[Vertex]);
+			}
+		}
+
+		return Builder;
+	}
+
+private:
+	FVector GetTriangleNormal(int32 Triangle) const
+	{
+		const FVector& P0 = Positions[VertexPositions[Indices[Triangle * 3 + 0]]];
+		const FVector& P1 = Positions[VertexPositions[Indices[Triangle * 3 + 1]]];
+		const FVector& P2 = Positions[VertexPositions[Indices[Triangle * 3 + 2]]];
+		return FVector::CrossProduct(P1 - P2, P0 - P2);
+	}
+
+	bool TriangleContainsPosition(int32 Triangle, int32 Position) const
+	{
+		return VertexPositions[Indices[Triangle * 3 + 0]] == Position || VertexPositions[Indices[Triangle * 3 + 1]] == Position || VertexPositions[Indices[Triangle * 3 + 2]] == Position;
+	}
+
+	/** Fills Neighbors with the positions around this one, dropping any collapsed triangles from its list along the way */
+	void GatherNeighbors(int32 Position)
+	{
+		Neighbors.Reset();
+
+		TArray<int32>& Triangles = PositionTriangles[Position];
+		for (int32 Index = Triangles.Num() - 1; Index >= 0; Index--)
+		{
+			if (!TriangleAlive[Triangles[Index]])
+			{
+				Triangles.RemoveAtSwap(Index, 1, false);
+			}
+		}
+
+		for (int32 Triangle : Triangles)
+		{
+			int32 Corner = 0;
+			while (VertexPositions[Indices[Triangle * 3 + Corner]] != Position)
+			{
+				Corner++;
+			}
+			const int32 Vertex = Indices[Triangle * 3 + Corner];
+
+			for (int32 Offset = 1; Offset < 3; Offset++)
+			{
+				const int32 NeighborVertex = Indices[Triangle * 3 + (Corner + Offset) % 3];
+				const int32 NeighborPosition = VertexPositions[NeighborVertex];
+
+				FRuntimeMeshSimplifierNeighbor* Existing = Neighbors.FindByPredicate([NeighborPosition](const FRuntimeMeshSimplifierNeighbor& Neighbor) { return Neighbor.Position == NeighborPosition; });
+				if (Existing)
+				{
+					Existing->NumTriangles++;
+					Existing->bSeam |= Existing->Vertex != Vertex || Existing->NeighborVertex != NeighborVertex;
+				}
+				else
+				{
+					Neighbors.Add(FRuntimeMeshSimplifierNeighbor{ NeighborPosition, 1, Vertex, NeighborVertex, false });
+				}
+			}
+		}
+	}
+
+	/**
+	*	Finds the vertex at the target position each vertex at this position should become. Fails if any vertex in use
+	*	has no triangle across the edge, or more than one candidate, as that would open or bend a seam.
+	*/
+	bool FindVertexTargets(int32 Position, int32 Target)
+	{
+		VertexTargets.Reset();
+
+		for (int32 Vertex = FirstVertexAtPosition[Position]; Vertex != INDEX_NONE; Vertex = NextVertexAtPosition[Vertex])
+		{
+			bool bUsed = false;
+			int32 TargetVertex = INDEX_NONE;
+
+			for (int32 Triangle : PositionTriangles[Position])
+			{
+				if (!TriangleAlive[Triangle])
+				{
+					continue;
+				}
+
+				int32 TriangleTarget = INDEX_NONE;
+				bool bHasVertex = false;
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const int32 CornerVertex = Indices[Triangle * 3 + Corner];
+					bHasVertex |= CornerVertex == Vertex;
+					if (VertexPositions[CornerVertex] == Target)
+					{
+						TriangleTarget = CornerVertex;
+					}
+				}
+
+				if (!bHasVertex)
+				{
+					continue;
+				}
+				bUsed = true;
+
+				if (TriangleTarget != INDEX_NONE)
+				{
+					if (TargetVertex != INDEX_NONE && TargetVertex != TriangleTarget)
+					{
+						return false;
+					}
+					TargetVertex = TriangleTarget;
+				}
+			}
+
+			if (bUsed)
+			{
+				if (TargetVertex == INDEX_NONE)
+				{
+					return false;
+				}
+				VertexTargets.Add(TPair<int32, int32>(Vertex, TargetVertex));
+			}
+		}
+
+		return VertexTargets.Num() > 0;
+	}
+
+	/** Cost of moving this position onto the target, or false if the collapse isn't allowed. Expects VertexTargets to be filled */
+	bool GetCollapseCost(int32 Position, int32 Target, double& OutCost) const
+	{
+		const FVector& NewPosition = Positions[Target];
+
+		// Reject anything that would fold triangles over
+		for (int32 Triangle : PositionTriangles[Position])
+		{
+			if (!TriangleAlive[Triangle] || TriangleContainsPosition(Triangle, Target))
+			{
+				continue;
+			}
+
+			FVector Corners[3];
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const int32 CornerPosition = VertexPositions[Indices[Triangle * 3 + Corner]];
+				Corners[Corner] = CornerPosition == Position ? NewPosition : Positions[CornerPosition];
+			}
+
+			const FVector OldNormal = GetTriangleNormal(Triangle);
+			const FVector NewNormal = FVector::CrossProduct(Corners[1] - Corners[2], Corners[0] - Corners[2]);
+			const float OldSize = OldNormal.Size();
+			const float NewSize = NewNormal.Size();
+
+			if (OldSize > SMALL_NUMBER && (NewSize <= OldSize * KINDA_SMALL_NUMBER ||
+				FVector::DotProduct(OldNormal, NewNormal) < Settings.MinTriangleNormalDot * OldSize * NewSize))
+			{
+				return false;
+			}
+		}
+
+		FRuntimeMeshQuadric Quadric = Quadrics[Position];
+		Quadric += Quadrics[Target];
+		OutCost = FMath::Max(Quadric.Evaluate(NewPosition), 0.0);
+
+		// The vertices take on the attributes of their targets, so charge for how far those are from their own
+		const double EdgeLengthSquared = FVector::DistSquared(Positions[Position], NewPosition);
+		for (const TPair<int32, int32>& VertexTarget : VertexTargets)
+		{
+			const double NormalError = 1.0 - FVector::DotProduct(Normals[VertexTarget.Key], Normals[VertexTarget.Value]);
+
+			double UVError = 0.0;
+			for (int32 Channel = 0; Channel < NumUVs; Channel++)
+			{
+				UVError += FVector2D::DistSquared(UVs[VertexTarget.Key * NumUVs + Channel], UVs[VertexTarget.Value * NumUVs + Channel]);
+			}
+
+			OutCost += EdgeLengthSquared * (Settings.NormalWeight * NormalError + Settings.UVWeight * UVError);
+		}
+
+		return true;
+	}
+
+	/** Finds the cheapest allowed collapse for this position and queues it, replacing any queued before */
+	void UpdateCollapse(int32 Position)
+	{
+		Versions[Position]++;
+
+		if (!PositionAlive[Position])
+		{
+			return;
+		}
+
+		GatherNeighbors(Position);
+
+		// Non manifold edges, and points where borders or seams meet, stay where they are
+		int32 NumFeatureEdges = 0;
+		for (const FRuntimeMeshSimplifierNeighbor& Neighbor : Neighbors)
+		{
+			if (Neighbor.NumTriangles > 2)
+			{
+				return;
+			}
+			NumFeatureEdges += Neighbor.IsFeature() ? 1 : 0;
+		}
+		if (NumFeatureEdges != 0 && NumFeatureEdges != 2)
+		{
+			return;
+		}
+
+		double BestCost = MAX_dbl;
+		int32 BestTarget = INDEX_NONE;
+
+		for (const FRuntimeMeshSimplifierNeighbor& Neighbor : Neighbors)
+		{
+			// Positions on a border or seam can only slide along it
+			if (NumFeatureEdges > 0 && !Neighbor.IsFeature())
+			{
+				continue;
+			}
+
+			double Cost;
+			if (FindVertexTargets(Position, Neighbor.Position) && GetCollapseCost(Position, Neighbor.Position, Cost) && Cost < BestCost)
+			{
+				BestCost = Cost;
+				BestTarget = Neighbor.Position;
+			}
+		}
+
+		if (BestTarget != INDEX_NONE)
+		{
+			Heap.HeapPush(FRuntimeMeshCollapse(BestCost, Position, BestTarget, Versions[Position]));
+		}
+	}
+
+	/** Moves the position onto the target, using the vertex targets from the last FindVertexTargets */
+	void ApplyCollapse(int32 Position, int32 Target)
+	{
+		for (int32 Triangle : PositionTriangles[Position])
+		{
+			if (!TriangleAlive[Triangle])
+			{
+				continue;
+			}
+
+			// Triangles along the edge disappear, the rest are moved across
+			if (TriangleContainsPosition(Triangle, Target))
+			{
+				TriangleAlive[Triangle] = false;
+				NumAliveTriangles--;
+				continue;
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				int32& Vertex = Indices[Triangle * 3 + Corner];
+				if (VertexPositions[Vertex] == Position)
+				{
+					const TPair<int32, int32>* VertexTarget = VertexTargets.FindByPredicate([Vertex](const TPair<int32, int32>& Pair) { return Pair.Key == Vertex; });
+					check(VertexTarget);
+					Vertex = VertexTarget->Value;
+				}
+			}
+			PositionTriangles[Target].Add(Triangle);
+		}
+
+		PositionTriangles[Position].Empty();
+		PositionAlive[Position] = false;
+		Quadrics[Target] += Quadrics[Position];
+
+		// Everything around the target may now have a different best collapse. Updating the target leaves its neighbors
+		// in Neighbors, which are copied out as updating them overwrites it
+		UpdateCollapse(Target);
+
+		TArray<int32, TInlineAllocator<32>> AffectedPositions;
+		for (const FRuntimeMeshSimplifierNeighbor& Neighbor : Neighbors)
+		{
+			AffectedPositions.Add(Neighbor.Position);
+		}
+		for (int32 Affected : AffectedPositions)
+		{
+			UpdateCollapse(Affected);
+		}
+	}
+};
+
+
+bool FRuntimeMeshSimplifier::GenerateLODs(const FRuntimeMeshAccessor& Source, const TArray<float>& TriangleRatios, const FRuntimeMeshSimplificationSettings& Settings, TArray<FRuntimeMeshBuilderPtr>& OutLODs)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_Simplify);
+
+	OutLODs.Reset();
+
+	FRuntimeMeshSimplifierState State(Source, Settings);
+	if (!State.Initialize())
+	{
+		return false;
+	}
+
+	const int32 SourceTriangles = State.GetNumAliveTriangles();
+	for (float Ratio : TriangleRatios)
+	{
+		const int32 TargetTriangles = FMath::Max(FMath::RoundToInt(SourceTriangles * FMath::Clamp(Ratio, 0.0f, 1.0f)), 1);
+		State.Simplify(TargetTriangles);
+
+		if (State.GetNumAliveTriangles() > TargetTriangles)
+		{
+			UE_LOG(RuntimeMeshLog, Verbose, TEXT("Simplifier stopped at %d triangles of a target of %d, nothing else could be collapsed."), State.GetNumAliveTriangles(), TargetTriangles);
+		}
+
+		OutLODs.Add(State.BuildLOD());
+	}
+
+	return true;
+}
@@ -6,6 +6,7 @@
 #include "RuntimeMesh.h"
 #include "RuntimeMeshData.h"
 #include "RuntimeMeshComponent.h"
+#include "RuntimeMeshGeometryKernels.h"
 #include "PhysicsEngine/BodySetup.h"
 
 
@@ -288,15 +289,13 @@ void URuntimeMeshSlicer::SliceRuntimeMeshSection(const FRuntimeMeshDataPtr& InRu
 	// Distance of each base vert from slice plane
 	TArray<float> VertDistance;
 	VertDistance.SetNumUninitialized(NumBaseVerts);
+	FRuntimeMeshGeometryKernels::ComputePlaneDistances(SlicePlane, SourceMeshData->GetPositionData(), VertDistance.GetData(), NumBaseVerts);
 
 	// Build vertex buffer 
 	for (int32 BaseVertIndex = 0; BaseVertIndex < NumBaseVerts; BaseVertIndex++)
 	{
 		FRuntimeMeshAccessorVertex BaseVert = SourceMeshData->GetVertex(BaseVertIndex);
 
-		// Calculate distance from plane
-		VertDistance[BaseVertIndex] = SlicePlane.PlaneDot(BaseVert.Position);
-
 		// See if vert is being kept in this section
 		if (VertDistance[BaseVertIndex] > 0.f)
 		{
@@ -645,8 +644,8 @@ void URuntimeMeshSlicer::SliceRuntimeMesh(URuntimeMesh* InRuntimeMesh, FVector P
 
 			auto MeshData = InRuntimeMesh->GetSectionReadonly(SectionIndex);
 
-			// Skip if we don't have mesh data
-			if (MeshData->NumVertices() < 3 || MeshData->NumIndices() < 3)
+			// Skip if we don't have mesh data, which includes render only sections that have released theirs
+			if (!MeshData.IsValid() || MeshData->NumVertices() < 3 || MeshData->NumIndices() < 3)
 			{
 				continue;
 			}
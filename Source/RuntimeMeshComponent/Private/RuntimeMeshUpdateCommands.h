@@ -5,13 +5,19 @@
 #include "Engine.h"
 #include "Components/MeshComponent.h"
 #include "RuntimeMeshCore.h"
+#include "RuntimeMeshClusterBuilder.h"
 
 
 
 struct FRuntimeMeshSectionVertexBufferParams
 {
-	TArray<uint8> Data;
+	// Shared with the game thread copy of the section, so this must never be written to
+	FRuntimeMeshSharedStreamDataPtr Data;
 	int32 NumVertices;
+
+	// For partial updates Data only holds the changed vertices, starting at StartVertex
+	bool bIsPartialUpdate;
+	int32 StartVertex;
 };
 struct FRuntimeMeshSectionTangentVertexBufferParams : public FRuntimeMeshSectionVertexBufferParams
 {
@@ -26,8 +32,17 @@ struct FRuntimeMeshSectionUVVertexBufferParams : public FRuntimeMeshSectionVerte
 struct FRuntimeMeshSectionIndexBufferParams
 {
 	bool b32BitIndices;
-	TArray<uint8> Data;
+	// Shared with the game thread copy of the section, so this must never be written to
+	FRuntimeMeshSharedStreamDataPtr Data;
 	int32 NumIndices;
+
+	// For partial updates Data only holds the changed indices, starting at StartIndex
+	bool bIsPartialUpdate;
+	int32 StartIndex;
+
+	// When set the indices are 16 bit offsets from each segment's base vertex, drawn as one batch element per segment.
+	// Only sent with full updates, partial updates keep the existing segments.
+	TArray<FRuntimeMeshIndexSegment> Segments;
 };
 
 struct FRuntimeMeshSectionLODUpdateParams
@@ -39,6 +54,16 @@ struct FRuntimeMeshSectionLODUpdateParams
 
 	FRuntimeMeshSectionIndexBufferParams IndexBuffer;
 	FRuntimeMeshSectionIndexBufferParams AdjacencyIndexBuffer;
+
+	/** Local space bounds of the whole LOD. Only valid when the positions are sent */
+	FBox LocalBounds;
+
+	/** Clusters of the LOD's triangles, sent along with its positions or indices. Empty if the LOD isn't clustered */
+	TArray<FRuntimeMeshCluster> Clusters;
+
+	FRuntimeMeshSectionLODUpdateParams()
+		: LocalBounds(EForceInit::ForceInit)
+	{ }
 };
 
 
@@ -53,18 +78,10 @@ struct FRuntimeMeshSectionCreationParams
 };
 using FRuntimeMeshSectionCreationParamsPtr = TSharedPtr<FRuntimeMeshSectionCreationParams, ESPMode::NotThreadSafe>;
 
-struct FRuntimeMeshSectionUpdateParams
+struct FRuntimeMeshSectionUpdateParams : public FRuntimeMeshSectionLODUpdateParams
 {
 	int32 LODIndex;
 	ERuntimeMeshBuffersToUpdate BuffersToUpdate;
-
-	FRuntimeMeshSectionVertexBufferParams PositionVertexBuffer;
-	FRuntimeMeshSectionTangentVertexBufferParams TangentsVertexBuffer;
-	FRuntimeMeshSectionUVVertexBufferParams UVsVertexBuffer;
-	FRuntimeMeshSectionVertexBufferParams ColorVertexBuffer;
-
-	FRuntimeMeshSectionIndexBufferParams IndexBuffer;
-	FRuntimeMeshSectionIndexBufferParams AdjacencyIndexBuffer;
 };
 using FRuntimeMeshSectionUpdateParamsPtr = TSharedPtr<FRuntimeMeshSectionUpdateParams, ESPMode::NotThreadSafe>;
 
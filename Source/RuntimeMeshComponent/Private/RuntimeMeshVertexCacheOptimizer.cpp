@@ -0,0 +1,442 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshVertexCacheOptimizer.h"
+#include "RuntimeMeshComponentPlugin.h"
+#include "RuntimeMeshSection.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("RM - Optimize Vertex Cache"), STAT_RuntimeMesh_OptimizeVertexCache, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Optimize Vertex Cache - Apply"), STAT_RuntimeMesh_OptimizeVertexCache_Apply, STATGROUP_RuntimeMesh);
+
+// Clusters smaller than this aren't worth splitting off for the overdraw sort
+static const int32 RuntimeMeshMinClusterTriangles = 64;
+
+// A cluster can only be closed while it's doing better than this, so restarting the cache for the next one costs little
+static const float RuntimeMeshClusterSplitACMR = 0.75f;
+
+
+// Next vertex to fan around once the current one has nothing left, the most recently used first then any with triangles left
+static int32 SkipDeadEnd(const TArray<int32>& LiveTriangles, TArray<uint32>& DeadEndStack, int32& Cursor, int32 NumVertices)
+{
+	while (DeadEndStack.Num() > 0)
+	{
+		const uint32 Vertex = DeadEndStack.Pop(false);
+		if (LiveTriangles[Vertex] > 0)
+		{
+			return Vertex;
+		}
+	}
+
+	for (; Cursor < NumVertices; Cursor++)
+	{
+		if (LiveTriangles[Cursor] > 0)
+		{
+			return Cursor;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+static void ReadIndices(const FRuntimeMeshSectionIndexBuffer& Buffer, TArray<uint32>& OutIndices)
+{
+	const int32 NumIndices = Buffer.GetNumIndices();
+	OutIndices.SetNumUninitialized(NumIndices);
+
+	if (Buffer.Is32BitIndices())
+	{
+		FMemory::Memcpy(OutIndices.GetData(), Buffer.GetData().GetData(), NumIndices * sizeof(uint32));
+	}
+	else
+	{
+		const uint16* Indices = reinterpret_cast<const uint16*>(Buffer.GetData().GetData());
+		for (int32 Index = 0; Index < NumIndices; Index++)
+		{
+			OutIndices[Index] = Indices[Index];
+		}
+	}
+}
+
+// Writes indices into the buffer in its own format, optionally remapping them on the way
+static void WriteIndices(FRuntimeMeshSectionIndexBuffer& Buffer, const TArray<uint32>& Indices, const TArray<int32>* Remap)
+{
+	TArray<uint8> NewData;
+	NewData.SetNumUninitialized(Indices.Num() * Buffer.GetStride());
+
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		const uint32 Value = Remap ? (uint32)(*Remap)[Indices[Index]] : Indices[Index];
+		if (Buffer.Is32BitIndices())
+		{
+			reinterpret_cast<uint32*>(NewData.GetData())[Index] = Value;
+		}
+		else
+		{
+			reinterpret_cast<uint16*>(NewData.GetData())[Index] = (uint16)Value;
+		}
+	}
+
+	Buffer.SetData(NewData, true);
+}
+
+// Moves each vertex to its new position. Streams that don't match the positions, like unset colors, are left alone
+static void RemapVertexStream(FRuntimeMeshSectionVertexBuffer& Buffer, const TArray<int32>& Remap)
+{
+	if (Buffer.GetNumVertices() != Remap.Num())
+	{
+		return;
+	}
+
+	const int32 Stride = Buffer.GetStride();
+	const TArray<uint8>& OldData = Buffer.GetData();
+
+	TArray<uint8> NewData;
+	NewData.SetNumUninitialized(OldData.Num());
+	for (int32 Vertex = 0; Vertex < Remap.Num(); Vertex++)
+	{
+		FMemory::Memcpy(NewData.GetData() + Remap[Vertex] * Stride, OldData.GetData() + Vertex * Stride, Stride);
+	}
+
+	Buffer.SetData(NewData, true);
+}
+
+
+float FRuntimeMeshVertexCacheOptimizer::ComputeACMR(const TArray<uint32>& Indices, int32 NumVertices, int32 CacheSize)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (NumTriangles == 0)
+	{
+		return 0.0f;
+	}
+
+	// A vertex is still in the FIFO if fewer than CacheSize misses have happened since it went in
+	TArray<int32> InsertedAt;
+	InsertedAt.Init(-(CacheSize + 1), NumVertices);
+
+	int32 Misses = 0;
+	for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+	{
+		const uint32 Vertex = Indices[Index];
+		if (Misses - InsertedAt[Vertex] > CacheSize)
+		{
+			InsertedAt[Vertex] = Misses;
+			Misses++;
+		}
+	}
+
+	return (float)Misses / NumTriangles;
+}
+
+void FRuntimeMeshVertexCacheOptimizer::OptimizeTriangleOrder(const TArray<uint32>& Indices, int32 NumVertices, TArray<uint32>& OutIndices, TArray<int32>& OutClusterStarts, int32 CacheSize)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+
+	OutIndices.Reset(NumTriangles * 3);
+	OutClusterStarts.Reset();
+
+	if (NumTriangles == 0)
+	{
+		return;
+	}
+
+	// Triangles using each vertex, as ranges of one flat list
+	TArray<int32> LiveTriangles;
+	LiveTriangles.SetNumZeroed(NumVertices);
+	for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+	{
+		LiveTriangles[Indices[Index]]++;
+	}
+
+	TArray<int32> AdjacencyOffsets;
+	AdjacencyOffsets.SetNumUninitialized(NumVertices + 1);
+	AdjacencyOffsets[0] = 0;
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		AdjacencyOffsets[Vertex + 1] = AdjacencyOffsets[Vertex] + LiveTriangles[Vertex];
+	}
+
+	TArray<int32> Adjacency;
+	Adjacency.SetNumUninitialized(NumTriangles * 3);
+	{
+		TArray<int32> WritePositions(AdjacencyOffsets.GetData(), NumVertices);
+		for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+		{
+			Adjacency[WritePositions[Indices[Index]]++] = Index / 3;
+		}
+	}
+
+	TArray<int32> CacheTime;
+	CacheTime.SetNumZeroed(NumVertices);
+
+	TArray<bool> Emitted;
+	Emitted.Init(false, NumTriangles);
+
+	TArray<uint32> DeadEndStack;
+	TArray<uint32> Candidates;
+
+	int32 Timestamp = CacheSize + 1;
+	int32 Cursor = 0;
+
+	bool bStartCluster = true;
+	int32 ClusterTriangles = 0;
+	int32 ClusterMisses = 0;
+
+	int32 FanVertex = SkipDeadEnd(LiveTriangles, DeadEndStack, Cursor, NumVertices);
+	while (FanVertex != INDEX_NONE)
+	{
+		Candidates.Reset();
+
+		// Emit every remaining triangle around the fanning vertex
+		for (int32 AdjacencyIndex = AdjacencyOffsets[FanVertex]; AdjacencyIndex < AdjacencyOffsets[FanVertex + 1]; AdjacencyIndex++)
+		{
+			const int32 Triangle = Adjacency[AdjacencyIndex];
+			if (Emitted[Triangle])
+			{
+				continue;
+			}
+
+			if (bStartCluster)
+			{
+				OutClusterStarts.Add(OutIndices.Num() / 3);
+				bStartCluster = false;
+				ClusterTriangles = 0;
+				ClusterMisses = 0;
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 Vertex = Indices[Triangle * 3 + Corner];
+				OutIndices.Add(Vertex);
+				DeadEndStack.Push(Vertex);
+				Candidates.Add(Vertex);
+				LiveTriangles[Vertex]--;
+
+				if (Timestamp - CacheTime[Vertex] > CacheSize)
+				{
+					CacheTime[Vertex] = Timestamp++;
+					ClusterMisses++;
+				}
+			}
+
+			Emitted[Triangle] = true;
+			ClusterTriangles++;
+		}
+
+		// Prefer the candidate that's been in the cache longest but will still be there once its triangles are emitted
+		int32 NextVertex = INDEX_NONE;
+		int32 BestPriority = -1;
+		for (uint32 Candidate : Candidates)
+		{
+			if (LiveTriangles[Candidate] > 0)
+			{
+				int32 Priority = 0;
+				if (Timestamp - CacheTime[Candidate] + 2 * LiveTriangles[Candidate] <= CacheSize)
+				{
+					Priority = Timestamp - CacheTime[Candidate];
+				}
+
+				if (Priority > BestPriority)
+				{
+					BestPriority = Priority;
+					NextVertex = Candidate;
+				}
+			}
+		}
+
+		if (NextVertex == INDEX_NONE)
+		{
+			// Dead end, the cache is effectively restarted so this is a natural place for a new cluster
+			NextVertex = SkipDeadEnd(LiveTriangles, DeadEndStack, Cursor, NumVertices);
+			bStartCluster = true;
+		}
+		else if (ClusterTriangles >= RuntimeMeshMinClusterTriangles && ClusterMisses < RuntimeMeshClusterSplitACMR * ClusterTriangles)
+		{
+			bStartCluster = true;
+		}
+
+		FanVertex = NextVertex;
+	}
+}
+
+void FRuntimeMeshVertexCacheOptimizer::OptimizeOverdraw(TArray<uint32>& Indices, const TArray<int32>& ClusterStarts, const TArray<FVector>& Positions)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (ClusterStarts.Num() < 2)
+	{
+		return;
+	}
+
+	struct FCluster
+	{
+		int32 FirstTriangle;
+		int32 NumTriangles;
+		FVector Center;
+		FVector Normal;
+		float SortKey;
+	};
+
+	TArray<FCluster> Clusters;
+	Clusters.SetNum(ClusterStarts.Num());
+
+	FVector MeshCenter = FVector::ZeroVector;
+	float MeshArea = 0.0f;
+
+	for (int32 ClusterIndex = 0; ClusterIndex < ClusterStarts.Num(); ClusterIndex++)
+	{
+		FCluster& Cluster = Clusters[ClusterIndex];
+		Cluster.FirstTriangle = ClusterStarts[ClusterIndex];
+		Cluster.NumTriangles = (ClusterIndex + 1 < ClusterStarts.Num() ? ClusterStarts[ClusterIndex + 1] : NumTriangles) - Cluster.FirstTriangle;
+
+		// Area weighted center and normal, winding the same way as the tangent generation
+		FVector WeightedCenter = FVector::ZeroVector;
+		FVector WeightedNormal = FVector::ZeroVector;
+		float Area = 0.0f;
+		for (int32 Triangle = Cluster.FirstTriangle; Triangle < Cluster.FirstTriangle + Cluster.NumTriangles; Triangle++)
+		{
+			const FVector& P0 = Positions[Indices[Triangle * 3 + 0]];
+			const FVector& P1 = Positions[Indices[Triangle * 3 + 1]];
+			const FVector& P2 = Positions[Indices[Triangle * 3 + 2]];
+
+			const FVector Cross = (P1 - P2) ^ (P0 - P2);
+			const float TriangleArea = Cross.Size();
+
+			WeightedNormal += Cross;
+			WeightedCenter += (P0 + P1 + P2) * (TriangleArea / 3.0f);
+			Area += TriangleArea;
+		}
+
+		Cluster.Center = Area > SMALL_NUMBER ? WeightedCenter / Area : Positions[Indices[Cluster.FirstTriangle * 3]];
+		Cluster.Normal = WeightedNormal.GetSafeNormal();
+
+		MeshCenter += WeightedCenter;
+		MeshArea += Area;
+	}
+
+	if (MeshArea > SMALL_NUMBER)
+	{
+		MeshCenter /= MeshArea;
+	}
+
+	// Clusters further out along their own normal are more likely to occlude the rest, so draw them first
+	for (FCluster& Cluster : Clusters)
+	{
+		Cluster.SortKey = (Cluster.Center - MeshCenter) | Cluster.Normal;
+	}
+	Clusters.StableSort([](const FCluster& A, const FCluster& B) { return A.SortKey > B.SortKey; });
+
+	TArray<uint32> SortedIndices;
+	SortedIndices.Reserve(Indices.Num());
+	for (const FCluster& Cluster : Clusters)
+	{
+		SortedIndices.Append(Indices.GetData() + Cluster.FirstTriangle * 3, Cluster.NumTriangles * 3);
+	}
+	Indices = MoveTemp(SortedIndices);
+}
+
+void FRuntimeMeshVertexCacheOptimizer::ComputeVertexFetchRemap(const TArray<uint32>& Indices, int32 NumVertices, TArray<int32>& OutRemap)
+{
+	OutRemap.Init(INDEX_NONE, NumVertices);
+
+	int32 NextVertex = 0;
+	for (uint32 Vertex : Indices)
+	{
+		if (OutRemap[Vertex] == INDEX_NONE)
+		{
+			OutRemap[Vertex] = NextVertex++;
+		}
+	}
+
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		if (OutRemap[Vertex] == INDEX_NONE)
+		{
+			OutRemap[Vertex] = NextVertex++;
+		}
+	}
+}
+
+bool FRuntimeMeshVertexCacheOptimizer::Optimize(const FRuntimeMeshVertexCacheOptimizationInput& Input, bool bOptimizeOverdraw, FRuntimeMeshVertexCacheOptimization& OutResult)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_OptimizeVertexCache);
+
+	if (Input.Indices.Num() % 3 != 0)
+	{
+		return false;
+	}
+
+	for (uint32 Vertex : Input.Indices)
+	{
+		if (Vertex >= (uint32)Input.NumVertices)
+		{
+			return false;
+		}
+	}
+
+	OutResult.ACMRBefore = ComputeACMR(Input.Indices, Input.NumVertices);
+
+	TArray<uint32> OrderedIndices;
+	TArray<int32> ClusterStarts;
+	OptimizeTriangleOrder(Input.Indices, Input.NumVertices, OrderedIndices, ClusterStarts);
+
+	if (bOptimizeOverdraw && Input.Positions.Num() == Input.NumVertices)
+	{
+		OptimizeOverdraw(OrderedIndices, ClusterStarts, Input.Positions);
+	}
+	else if (ComputeACMR(OrderedIndices, Input.NumVertices) >= OutResult.ACMRBefore)
+	{
+		// Already well ordered, so only the vertex order can improve
+		OrderedIndices = Input.Indices;
+	}
+
+	// The ACMR doesn't depend on the vertex numbering, so it can be measured before the remap
+	OutResult.ACMRAfter = ComputeACMR(OrderedIndices, Input.NumVertices);
+
+	ComputeVertexFetchRemap(OrderedIndices, Input.NumVertices, OutResult.VertexRemap);
+
+	OutResult.Indices.SetNumUninitialized(OrderedIndices.Num());
+	for (int32 Index = 0; Index < OrderedIndices.Num(); Index++)
+	{
+		OutResult.Indices[Index] = OutResult.VertexRemap[OrderedIndices[Index]];
+	}
+
+	return true;
+}
+
+void FRuntimeMeshVertexCacheOptimizer::GatherInput(const FRuntimeMeshSectionLODData& LOD, bool bOptimizeOverdraw, FRuntimeMeshVertexCacheOptimizationInput& OutInput)
+{
+	ReadIndices(LOD.IndexBuffer, OutInput.Indices);
+	OutInput.NumVertices = LOD.PositionBuffer.GetNumVertices();
+
+	OutInput.Positions.Reset();
+	if (bOptimizeOverdraw)
+	{
+		OutInput.Positions.SetNumUninitialized(OutInput.NumVertices);
+		FMemory::Memcpy(OutInput.Positions.GetData(), LOD.PositionBuffer.GetData().GetData(), OutInput.NumVertices * sizeof(FVector));
+	}
+}
+
+void FRuntimeMeshVertexCacheOptimizer::Apply(const FRuntimeMeshVertexCacheOptimization& Optimization, FRuntimeMeshSectionLODData& LOD)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_OptimizeVertexCache_Apply);
+
+	check(Optimization.VertexRemap.Num() == LOD.PositionBuffer.GetNumVertices());
+
+	RemapVertexStream(LOD.PositionBuffer, Optimization.VertexRemap);
+	RemapVertexStream(LOD.TangentsBuffer, Optimization.VertexRemap);
+	RemapVertexStream(LOD.UVsBuffer, Optimization.VertexRemap);
+	RemapVertexStream(LOD.ColorBuffer, Optimization.VertexRemap);
+
+	WriteIndices(LOD.IndexBuffer, Optimization.Indices, nullptr);
+
+	// Tessellation indices keep their own triangle order, they only need to point at the moved vertices
+	if (LOD.AdjacencyIndexBuffer.GetNumIndices() > 0)
+	{
+		TArray<uint32> AdjacencyIndices;
+		ReadIndices(LOD.AdjacencyIndexBuffer, AdjacencyIndices);
+		for (uint32 Vertex : AdjacencyIndices)
+		{
+			check(Vertex < (uint32)Optimization.VertexRemap.Num());
+		}
+		WriteIndices(LOD.AdjacencyIndexBuffer, AdjacencyIndices, &Optimization.VertexRemap);
+	}
+}
@@ -0,0 +1,351 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#include "RuntimeMeshVertexWelder.h"
+#include "RuntimeMeshComponentPlugin.h"
+#include "RuntimeMeshSection.h"
+#include "RuntimeMeshGenericVertex.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("RM - Weld Vertices"), STAT_RuntimeMesh_WeldVertices, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Weld Vertices - Find Targets"), STAT_RuntimeMesh_WeldVertices_FindTargets, STATGROUP_RuntimeMesh);
+
+// Keeps grid cell coordinates well inside int32 for tiny tolerances
+static const float RuntimeMeshMinWeldCellSize = 0.01f;
+
+
+// Compares the vertices of the streams that are present, in whatever precision they're stored in
+class FRuntimeMeshWeldComparer
+{
+	const FRuntimeMeshVertexWeldSettings& Settings;
+
+	const uint8* Tangents;
+	int32 TangentStride;
+	bool bHighPrecisionTangents;
+
+	const uint8* UVs;
+	int32 NumUVs;
+	bool bHighPrecisionUVs;
+
+	const FColor* Colors;
+
+public:
+	FRuntimeMeshWeldComparer(const FRuntimeMeshSectionLODData& LOD, const FRuntimeMeshVertexWeldSettings& InSettings, int32 NumVertices)
+		: Settings(InSettings)
+		, Tangents(nullptr), TangentStride(LOD.TangentsBuffer.GetStride()), bHighPrecisionTangents(LOD.TangentsBuffer.IsUsingHighPrecision())
+		, UVs(nullptr), NumUVs(LOD.UVsBuffer.NumUVs()), bHighPrecisionUVs(LOD.UVsBuffer.IsUsingHighPrecision())
+		, Colors(nullptr)
+	{
+		if (!Settings.bIgnoreTangents && LOD.TangentsBuffer.GetNumVertices() == NumVertices)
+		{
+			Tangents = LOD.TangentsBuffer.GetData().GetData();
+		}
+		if (LOD.UVsBuffer.GetNumVertices() == NumVertices)
+		{
+			UVs = LOD.UVsBuffer.GetData().GetData();
+		}
+		if (LOD.ColorBuffer.GetNumVertices() == NumVertices)
+		{
+			Colors = reinterpret_cast<const FColor*>(LOD.ColorBuffer.GetData().GetData());
+		}
+	}
+
+	bool AreEqual(int32 A, int32 B) const
+	{
+		if (Colors && Colors[A] != Colors[B])
+		{
+			return false;
+		}
+
+		if (Tangents)
+		{
+			FVector4 NormalA, NormalB;
+			FVector TangentA, TangentB;
+			GetTangents(A, NormalA, TangentA);
+			GetTangents(B, NormalB, TangentB);
+
+			// W holds the binormal sign, which has to match exactly
+			if (!FVector(NormalA).Equals(FVector(NormalB), Settings.TangentTolerance) || !TangentA.Equals(TangentB, Settings.TangentTolerance) ||
+				FMath::Sign(NormalA.W) != FMath::Sign(NormalB.W))
+			{
+				return false;
+			}
+		}
+
+		if (UVs)
+		{
+			for (int32 Channel = 0; Channel < NumUVs; Channel++)
+			{
+				if (!GetUV(A, Channel).Equals(GetUV(B, Channel), Settings.UVTolerance))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+private:
+	void GetTangents(int32 Vertex, FVector4& OutNormal, FVector& OutTangent) const
+	{
+		if (bHighPrecisionTangents)
+		{
+			const FRuntimeMeshTangentsHighPrecision& Value = *reinterpret_cast<const FRuntimeMeshTangentsHighPrecision*>(Tangents + Vertex * TangentStride);
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
+			OutNormal = Value.Normal.ToFVector4();
+			OutTangent = Value.Tangent.ToFVector();
+#else
+			OutNormal = Value.Normal;
+			OutTangent = FVector(Value.Tangent);
+#endif
+		}
+		else
+		{
+			const FRuntimeMeshTangents& Value = *reinterpret_cast<const FRuntimeMeshTangents*>(Tangents + Vertex * TangentStride);
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
+			OutNormal = Value.Normal.ToFVector4();
+			OutTangent = Value.Tangent.ToFVector();
+#else
+			OutNormal = Value.Normal;
+			OutTangent = FVector(Value.Tangent);
+#endif
+		}
+	}
+
+	FVector2D GetUV(int32 Vertex, int32 Channel) const
+	{
+		if (bHighPrecisionUVs)
+		{
+			return reinterpret_cast<const FVector2D*>(UVs)[Vertex * NumUVs + Channel];
+		}
+		return reinterpret_cast<const FVector2DHalf*>(UVs)[Vertex * NumUVs + Channel];
+	}
+};
+
+static FORCEINLINE FIntVector GetWeldCell(const FVector& Position, float InvCellSize)
+{
+	return FIntVector(FMath::FloorToInt(Position.X * InvCellSize), FMath::FloorToInt(Position.Y * InvCellSize), FMath::FloorToInt(Position.Z * InvCellSize));
+}
+
+static void ReadWeldIndices(const FRuntimeMeshSectionIndexBuffer& Buffer, TArray<uint32>& OutIndices)
+{
+	const int32 NumIndices = Buffer.GetNumIndices();
+	OutIndices.SetNumUninitialized(NumIndices);
+
+	if (Buffer.Is32BitIndices())
+	{
+		FMemory::Memcpy(OutIndices.GetData(), Buffer.GetData().GetData(), NumIndices * sizeof(uint32));
+	}
+	else
+	{
+		const uint16* Indices = reinterpret_cast<const uint16*>(Buffer.GetData().GetData());
+		for (int32 Index = 0; Index < NumIndices; Index++)
+		{
+			OutIndices[Index] = Indices[Index];
+		}
+	}
+}
+
+// Keeps only the vertices with a new index, in their existing order. Streams that don't match the positions are left alone
+static void CompactVertexStream(FRuntimeMeshSectionVertexBuffer& Buffer, const TArray<int32>& NewIndices, int32 NumKept)
+{
+	if (Buffer.GetNumVertices() != NewIndices.Num())
+	{
+		return;
+	}
+
+	const int32 Stride = Buffer.GetStride();
+	const TArray<uint8>& OldData = Buffer.GetData();
+
+	TArray<uint8> NewData;
+	NewData.SetNumUninitialized(NumKept * Stride);
+	for (int32 Vertex = 0; Vertex < NewIndices.Num(); Vertex++)
+	{
+		if (NewIndices[Vertex] != INDEX_NONE)
+		{
+			FMemory::Memcpy(NewData.GetData() + NewIndices[Vertex] * Stride, OldData.GetData() + Vertex * Stride, Stride);
+		}
+	}
+
+	Buffer.SetData(NewData, true);
+}
+
+
+void FRuntimeMeshVertexWelder::FindWeldTargets(const FRuntimeMeshSectionLODData& LOD, const FRuntimeMeshVertexWeldSettings& Settings, TArray<int32>& OutWeldTargets)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_WeldVertices_FindTargets);
+
+	const int32 NumVertices = LOD.PositionBuffer.GetNumVertices();
+	const FVector* Positions = reinterpret_cast<const FVector*>(LOD.PositionBuffer.GetData().GetData());
+	const FRuntimeMeshWeldComparer Comparer(LOD, Settings, NumVertices);
+
+	const float Tolerance = FMath::Max(Settings.PositionTolerance, 0.0f);
+	const float ToleranceSquared = FMath::Square(Tolerance);
+	const float InvCellSize = 1.0f / FMath::Max(Tolerance * 2.0f, RuntimeMeshMinWeldCellSize);
+	const FVector Extent(Tolerance);
+
+	// Each cell points at the last kept vertex in it, and each kept vertex at the one before it in the same cell
+	TMap<FIntVector, int32> CellHeads;
+	CellHeads.Reserve(NumVertices);
+	TArray<int32> NextInCell;
+	NextInCell.SetNumUninitialized(NumVertices);
+
+	OutWeldTargets.SetNumUninitialized(NumVertices);
+
+	for (int32 Vertex = 0; Vertex < NumVertices; Vertex++)
+	{
+		const FVector& Position = Positions[Vertex];
+		const FIntVector MinCell = GetWeldCell(Position - Extent, InvCellSize);
+		const FIntVector MaxCell = GetWeldCell(Position + Extent, InvCellSize);
+
+		// Cells are at least twice the tolerance, so at most 2 per axis can hold a match. All of them are checked so the
+		// earliest match wins regardless of the order of the cells
+		int32 Match = INDEX_NONE;
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					const int32* Head = CellHeads.Find(FIntVector(X, Y, Z));
+					for (int32 Candidate = Head ? *Head : INDEX_NONE; Candidate != INDEX_NONE; Candidate = NextInCell[Candidate])
+					{
+						if (FVector::DistSquared(Positions[Candidate], Position) <= ToleranceSquared && Comparer.AreEqual(Candidate, Vertex))
+						{
+							if (Match == INDEX_NONE || Candidate < Match)
+							{
+								Match = Candidate;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (Match != INDEX_NONE)
+		{
+			OutWeldTargets[Vertex] = Match;
+			continue;
+		}
+
+		OutWeldTargets[Vertex] = Vertex;
+
+		const FIntVector Cell = GetWeldCell(Position, InvCellSize);
+		if (int32* Head = CellHeads.Find(Cell))
+		{
+			NextInCell[Vertex] = *Head;
+			*Head = Vertex;
+		}
+		else
+		{
+			NextInCell[Vertex] = INDEX_NONE;
+			CellHeads.Add(Cell, Vertex);
+		}
+	}
+}
+
+FRuntimeMeshVertexWeldResult FRuntimeMeshVertexWelder::WeldLOD(FRuntimeMeshSectionLODData& LOD, const FRuntimeMeshVertexWeldSettings& Settings)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_WeldVertices);
+
+	FRuntimeMeshVertexWeldResult Result;
+	Result.NumVerticesBefore = Result.NumVerticesAfter = LOD.PositionBuffer.GetNumVertices();
+
+	TArray<uint32> Indices;
+	ReadWeldIndices(LOD.IndexBuffer, Indices);
+	if (Indices.Num() == 0 || Indices.Num() % 3 != 0)
+	{
+		return Result;
+	}
+
+	TArray<int32> WeldTargets;
+	FindWeldTargets(LOD, Settings, WeldTargets);
+
+	// Rebuild the triangles on the merged vertices, dropping any that collapsed or that are already in the list with the same winding
+	TSet<FIntVector> SeenTriangles;
+	SeenTriangles.Reserve(Indices.Num() / 3);
+
+	int32 NumKeptIndices = 0;
+	for (int32 Index = 0; Index < Indices.Num(); Index += 3)
+	{
+		if (Indices[Index] >= (uint32)WeldTargets.Num() || Indices[Index + 1] >= (uint32)WeldTargets.Num() || Indices[Index + 2] >= (uint32)WeldTargets.Num())
+		{
+			UE_LOG(RuntimeMeshLog, Warning, TEXT("Mesh LOD has indices past the end of its vertices, skipping vertex welding."));
+			return Result;
+		}
+
+		const int32 A = WeldTargets[Indices[Index]];
+		const int32 B = WeldTargets[Indices[Index + 1]];
+		const int32 C = WeldTargets[Indices[Index + 2]];
+
+		if (A == B || B == C || A == C)
+		{
+			Result.NumDegenerateTriangles++;
+			continue;
+		}
+
+		// Rotate the smallest index to the front so the same triangle always has the same key
+		const FIntVector Key = (A < B && A < C) ? FIntVector(A, B, C) : (B < C ? FIntVector(B, C, A) : FIntVector(C, A, B));
+		bool bAlreadyInSet = false;
+		SeenTriangles.Add(Key, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			Result.NumDuplicateTriangles++;
+			continue;
+		}
+
+		Indices[NumKeptIndices++] = A;
+		Indices[NumKeptIndices++] = B;
+		Indices[NumKeptIndices++] = C;
+	}
+	Indices.SetNum(NumKeptIndices, false);
+
+	// Number the vertices still in use, in their existing order
+	TArray<int32> NewIndices;
+	NewIndices.Init(INDEX_NONE, WeldTargets.Num());
+	for (uint32 Vertex : Indices)
+	{
+		NewIndices[Vertex] = 0;
+	}
+
+	int32 NumKeptVertices = 0;
+	for (int32& NewIndex : NewIndices)
+	{
+		if (NewIndex != INDEX_NONE)
+		{
+			NewIndex = NumKeptVertices++;
+		}
+	}
+
+	Result.NumVerticesAfter = NumKeptVertices;
+	if (!Result.ChangedMesh())
+	{
+		return Result;
+	}
+
+	CompactVertexStream(LOD.PositionBuffer, NewIndices, NumKeptVertices);
+	CompactVertexStream(LOD.TangentsBuffer, NewIndices, NumKeptVertices);
+	CompactVertexStream(LOD.UVsBuffer, NewIndices, NumKeptVertices);
+	CompactVertexStream(LOD.ColorBuffer, NewIndices, NumKeptVertices);
+
+	// Fewer vertices means the indices still fit the buffer's existing width
+	TArray<uint8> NewIndexData;
+	NewIndexData.SetNumUninitialized(Indices.Num() * LOD.IndexBuffer.GetStride());
+	for (int32 Index = 0; Index < Indices.Num(); Index++)
+	{
+		const uint32 Vertex = NewIndices[Indices[Index]];
+		if (LOD.IndexBuffer.Is32BitIndices())
+		{
+			reinterpret_cast<uint32*>(NewIndexData.GetData())[Index] = Vertex;
+		}
+		else
+		{
+			reinterpret_cast<uint16*>(NewIndexData.GetData())[Index] = (uint16)Vertex;
+		}
+	}
+	LOD.IndexBuffer.SetData(NewIndexData, true);
+
+	LOD.AdjacencyIndexBuffer.Empty();
+
+	return Result;
+}
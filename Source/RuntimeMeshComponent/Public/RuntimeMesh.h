@@ -91,6 +91,14 @@ private:
 	UPROPERTY(EditAnywhere, Category = "RuntimeMesh")
 	ERuntimeMeshCollisionCookingMode CollisionMode;
 
+	/**
+	*	Controls whether all sections are suballocated out of a few large shared vertex/index buffers instead of
+	*	each having their own. Sections with the same vertex format then share one vertex factory, which cuts down
+	*	on render resources for meshes with many sections. Full section updates re-upload the whole LOD in this mode.
+	*/
+	UPROPERTY(EditAnywhere, Category = "RuntimeMesh")
+	bool bUseSharedSectionBuffers;
+
 	/** Collision data */
 	UPROPERTY(Instanced)
 	UBodySetup* BodySetup;
@@ -325,6 +333,27 @@ public:
 		GetRuntimeMeshData()->UpdateMeshSectionTriangles<IndexType>(SectionId, InTriangles, UpdateFlags, LODIndex);
 	}
 
+	template<typename VertexType0>
+	FORCEINLINE void UpdateMeshSectionPrimaryBufferRange(int32 SectionId, const TArray<VertexType0>& InVertices0, int32 StartVertex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		check(IsInGameThread());
+		GetRuntimeMeshData()->UpdateMeshSectionPrimaryBufferRange<VertexType0>(SectionId, InVertices0, StartVertex, UpdateFlags, LODIndex);
+	}
+
+	template<typename VertexType1>
+	FORCEINLINE void UpdateMeshSectionSecondaryBufferRange(int32 SectionId, const TArray<VertexType1>& InVertices1, int32 StartVertex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		check(IsInGameThread());
+		GetRuntimeMeshData()->UpdateMeshSectionSecondaryBufferRange<VertexType1>(SectionId, InVertices1, StartVertex, UpdateFlags, LODIndex);
+	}
+
+	template<typename IndexType>
+	FORCEINLINE void UpdateMeshSectionTrianglesRange(int32 SectionId, const TArray<IndexType>& InTriangles, int32 StartIndex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		check(IsInGameThread());
+		GetRuntimeMeshData()->UpdateMeshSectionTrianglesRange<IndexType>(SectionId, InTriangles, StartIndex, UpdateFlags, LODIndex);
+	}
+
 
 
 	FORCEINLINE void CreateMeshSection(int32 SectionId, const TSharedPtr<FRuntimeMeshBuilder>& MeshData, bool bCreateCollision = false,
@@ -405,6 +434,13 @@ public:
 			bCreateCollision, UpdateFrequency, UpdateFlags, bUseHighPrecisionTangents, bUseHighPrecisionUVs, LODIndex);
 	}
 
+	/** Creates many sections at once, filling them in parallel and sending them to the render thread together */
+	FORCEINLINE void CreateMeshSections(TArrayView<const FRuntimeMeshSectionBulkDesc> SectionDescs)
+	{
+		check(IsInGameThread());
+		GetRuntimeMeshData()->CreateMeshSections(SectionDescs);
+	}
+
 
 	FORCEINLINE void UpdateMeshSection(int32 SectionIndex, const TArray<FVector>& Vertices, const TArray<FVector>& Normals, const TArray<FVector2D>& UV0,
 	const TArray<FColor>& Colors, const TArray<FRuntimeMeshTangent>& Tangents, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
@@ -818,6 +854,61 @@ public:
 		return bUseAsyncCooking;
 	}
 
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SetUseSharedSectionBuffers(bool bNewValue)
+	{
+		check(IsInGameThread());
+		if (bUseSharedSectionBuffers != bNewValue)
+		{
+			bUseSharedSectionBuffers = bNewValue;
+			ForceProxyRecreate();
+		}
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool IsUsingSharedSectionBuffers()
+	{
+		check(IsInGameThread());
+		return bUseSharedSectionBuffers;
+	}
+
+	/** Sets how close vertices have to be to be merged when a section is created or updated with the WeldVertices flag. Colors always have to match exactly. */
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SetVertexWeldTolerances(float PositionTolerance = 0.00002f, float TangentTolerance = 0.01f, float UVTolerance = 0.0009765625f)
+	{
+		check(IsInGameThread());
+		GetRuntimeMeshData()->SetVertexWeldTolerances(PositionTolerance, TangentTolerance, UVTolerance);
+	}
+
+	/**
+	*	Starts a batch of changes that lasts until the returned batch is destroyed. Bounds, collision, linked components
+	*	and the render thread only hear about them when it ends, all at once. Batches can nest.
+	*	Not available to Blueprint, as the mesh stays locked for as long as a batch is open.
+	*/
+	TUniquePtr<FRuntimeMeshScopedBatch> BeginBatch()
+	{
+		check(IsInGameThread());
+		return MakeUnique<FRuntimeMeshScopedBatch>(*GetRuntimeMeshData());
+	}
+
+	/**
+	*	Generates LOD1 onwards of a section from LOD0 on a worker thread, keeping each ratio of LOD0's triangles in turn.
+	*	Open borders and UV/normal seams are preserved. Any LODs beyond the new ones are removed. Use SetLODScreenSize to
+	*	choose when each LOD is drawn. The weights and minimum normal dot are those of FRuntimeMeshSimplificationSettings.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void GenerateSectionLODs(int32 SectionId, const TArray<float>& LODTriangleRatios, float NormalWeight = 1.0f, float UVWeight = 1.0f,
+		float BorderWeight = 10.0f, float MinTriangleNormalDot = 0.2f)
+	{
+		check(IsInGameThread());
+		FRuntimeMeshSimplificationSettings Settings;
+		Settings.NormalWeight = NormalWeight;
+		Settings.UVWeight = UVWeight;
+		Settings.BorderWeight = BorderWeight;
+		Settings.MinTriangleNormalDot = MinTriangleNormalDot;
+		GetRuntimeMeshData()->GenerateSectionLODs(SectionId, LODTriangleRatios, Settings);
+	}
+
 	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
 	void SetCollisionMode(ERuntimeMeshCollisionCookingMode NewMode)
 	{
@@ -933,7 +1024,7 @@ private:
 
 	FRuntimeMeshProxyPtr EnsureProxyCreated(ERHIFeatureLevel::Type InFeatureLevel)
 	{
-		return GetRuntimeMeshData()->EnsureProxyCreated(InFeatureLevel);
+		return GetRuntimeMeshData()->EnsureProxyCreated(InFeatureLevel, bUseSharedSectionBuffers);
 	}
 
 
@@ -0,0 +1,42 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+
+/*
+*	Binary tree of boxes keyed by section id, where each node holds the union of its children.
+*	Changing one section's box only recomputes the nodes above it, so the combined bounds of
+*	many sections can be kept up to date without walking all of them.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshBoundsTree
+{
+	/** Nodes in heap order, Nodes[1] is the root and leaves start at NumLeaves. Nodes[0] is unused. */
+	TArray<FBox> Nodes;
+
+	/** Number of leaves, always a power of two */
+	int32 NumLeaves;
+
+public:
+	FRuntimeMeshBoundsTree();
+
+	/** Sets the box for an id, returns false if it was already that box so nothing changed */
+	bool Set(int32 Id, const FBox& Box);
+
+	/** Clears the box for an id, returns false if there wasn't one */
+	bool Clear(int32 Id) { return Set(Id, FBox(EForceInit::ForceInitToZero)); }
+
+	void Empty();
+
+	/** Union of every box in the tree */
+	FBox GetBounds() const { return Nodes.Num() > 1 ? Nodes[1] : FBox(EForceInit::ForceInitToZero); }
+
+	static bool AreBoxesEqual(const FBox& A, const FBox& B)
+	{
+		return A.IsValid == B.IsValid && (!A.IsValid || (A.Min == B.Min && A.Max == B.Max));
+	}
+
+private:
+	void Grow(int32 MinLeaves);
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
 #include "RuntimeMeshCore.h"
 #include "RuntimeMeshGenericVertex.h"
 
@@ -66,6 +67,57 @@ public:
 	int32 AddVertex(FVector InPosition);
 
 	FVector GetPosition(int32 Index) const;
+
+	/** Positions are always stored packed, so they can be read directly as an array of NumVertices() FVectors */
+	const FVector* GetPositionData() const { check(bIsInitialized); return reinterpret_cast<const FVector*>(PositionStream->GetData()); }
+
+	/**
+	*	Views of whole streams for tight loops over the vertices, checked against the section's format once up front
+	*	instead of on every vertex. The const versions work on readonly accessors. Any call that resizes the vertices
+	*	invalidates them.
+	*/
+	TArrayView<FVector> GetPositionSpan() { check(!bIsReadonly); return GetStreamSpan<FVector>(PositionStream); }
+	TArrayView<const FVector> GetPositionSpan() const { return GetStreamSpan<const FVector>(PositionStream); }
+
+	TArrayView<FColor> GetColorSpan() { check(!bIsReadonly); return GetStreamSpan<FColor>(ColorStream); }
+	TArrayView<const FColor> GetColorSpan() const { return GetStreamSpan<const FColor>(ColorStream); }
+
+	/** Tangent and normal of each vertex. TangentType is FRuntimeMeshTangents or FRuntimeMeshTangentsHighPrecision, and has to match the section. */
+	template<typename TangentType>
+	TArrayView<TangentType> GetPackedTangentSpan()
+	{
+		check(!bIsReadonly);
+		CheckTangentSpanType<TangentType>();
+		return GetStreamSpan<TangentType>(TangentStream);
+	}
+
+	template<typename TangentType>
+	TArrayView<const TangentType> GetPackedTangentSpan() const
+	{
+		CheckTangentSpanType<TangentType>();
+		return GetStreamSpan<const TangentType>(TangentStream);
+	}
+
+	/**
+	*	UVs in the section's precision. The channels of a vertex are stored together, so with a single UV type like
+	*	FVector2D the view holds every channel in the same arrangement as SetUVs, and channel C of vertex V is at
+	*	V * NumUVChannels() + C. With a type holding every channel, like FRuntimeMeshDualUV, it holds one per vertex.
+	*/
+	template<typename UVType>
+	TArrayView<UVType> GetUVSpan()
+	{
+		check(!bIsReadonly);
+		CheckUVSpanType<UVType>();
+		return GetStreamSpan<UVType>(UVStream);
+	}
+
+	template<typename UVType>
+	TArrayView<const UVType> GetUVSpan() const
+	{
+		CheckUVSpanType<UVType>();
+		return GetStreamSpan<const UVType>(UVStream);
+	}
+
 	FVector4 GetNormal(int32 Index) const;
 	FVector GetTangent(int32 Index) const;
 	FColor GetColor(int32 Index) const;
@@ -127,6 +179,28 @@ public:
 
 private:
 
+	template<typename ElementType>
+	TArrayView<ElementType> GetStreamSpan(TArray<uint8>* Stream) const
+	{
+		check(bIsInitialized);
+		return TArrayView<ElementType>(reinterpret_cast<ElementType*>(Stream->GetData()), Stream->Num() / (int32)sizeof(ElementType));
+	}
+
+	template<typename TangentType>
+	void CheckTangentSpanType() const
+	{
+		check(GetTangentIsHighPrecision<typename TRemoveCV<TangentType>::Type>() == bTangentHighPrecision);
+	}
+
+	template<typename UVType>
+	void CheckUVSpanType() const
+	{
+		bool bSpanHighPrecision;
+		int32 SpanNumUVs;
+		GetUVVertexProperties<typename TRemoveCV<UVType>::Type>(bSpanHighPrecision, SpanNumUVs);
+		check(bSpanHighPrecision == bUVHighPrecision && (SpanNumUVs == 1 || SpanNumUVs == UVChannelCount));
+	}
+
 	template<typename Type>
 	FVector4 ConvertPackedToNormal(const Type& Input)
 	{
@@ -307,6 +381,114 @@ private:
 	}
 
 
+	// Copies one component of each vertex into its stream as is, in a single copy when both are tightly packed
+	template<int32 ComponentSize>
+	static void CopyRawComponent(TArray<uint8>* Stream, int32 StreamStride, int32 StreamOffset, const uint8* Source, int32 SourceStride, int32 SourceOffset, int32 StartIndex, int32 Count)
+	{
+		uint8* Dest = Stream->GetData() + StartIndex * StreamStride + StreamOffset;
+		Source += SourceOffset;
+
+		if (StreamStride == ComponentSize && SourceStride == ComponentSize)
+		{
+			FMemory::Memcpy(Dest, Source, Count * ComponentSize);
+			return;
+		}
+
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			FMemory::Memcpy(Dest, Source, ComponentSize);
+			Dest += StreamStride;
+			Source += SourceStride;
+		}
+	}
+
+	template<typename Type>
+	typename TEnableIf<FRuntimeMeshVertexStreamLayout<Type>::HasRawPosition, bool>::Type
+		CopyRawPositions(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		CopyRawComponent<sizeof(FVector)>(PositionStream, PositionStride, 0,
+			reinterpret_cast<const uint8*>(Vertices), sizeof(Type), FRuntimeMeshVertexStreamLayout<Type>::PositionOffset, StartIndex, Count);
+		return true;
+	}
+
+	template<typename Type>
+	typename TEnableIf<!FRuntimeMeshVertexStreamLayout<Type>::HasRawPosition, bool>::Type
+		CopyRawPositions(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		return false;
+	}
+
+	// Normal and tangent have to be in the section's precision, and go in as a pair so a missing or converted one isn't half copied
+	template<typename Type>
+	typename TEnableIf<FRuntimeMeshVertexStreamLayout<Type>::HasRawNormal && FRuntimeMeshVertexStreamLayout<Type>::HasRawTangent, bool>::Type
+		CopyRawTangents(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		typedef FRuntimeMeshVertexStreamLayout<Type> Layout;
+		if (Layout::HasHighPrecisionTangentBasis != bTangentHighPrecision)
+		{
+			return false;
+		}
+
+		const uint8* Source = reinterpret_cast<const uint8*>(Vertices);
+		if (Layout::IsTangentStream)
+		{
+			CopyRawComponent<2 * Layout::TangentBasisSize>(TangentStream, TangentStride, 0, Source, sizeof(Type), 0, StartIndex, Count);
+		}
+		else
+		{
+			CopyRawComponent<Layout::TangentBasisSize>(TangentStream, TangentStride, 0, Source, sizeof(Type), Layout::TangentOffset, StartIndex, Count);
+			CopyRawComponent<Layout::TangentBasisSize>(TangentStream, TangentStride, TangentSize, Source, sizeof(Type), Layout::NormalOffset, StartIndex, Count);
+		}
+		return true;
+	}
+
+	template<typename Type>
+	typename TEnableIf<!(FRuntimeMeshVertexStreamLayout<Type>::HasRawNormal && FRuntimeMeshVertexStreamLayout<Type>::HasRawTangent), bool>::Type
+		CopyRawTangents(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		return false;
+	}
+
+	template<typename Type>
+	typename TEnableIf<FRuntimeMeshVertexStreamLayout<Type>::HasRawColor, bool>::Type
+		CopyRawColors(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		CopyRawComponent<sizeof(FColor)>(ColorStream, ColorStride, 0,
+			reinterpret_cast<const uint8*>(Vertices), sizeof(Type), FRuntimeMeshVertexStreamLayout<Type>::ColorOffset, StartIndex, Count);
+		return true;
+	}
+
+	template<typename Type>
+	typename TEnableIf<!FRuntimeMeshVertexStreamLayout<Type>::HasRawColor, bool>::Type
+		CopyRawColors(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		return false;
+	}
+
+	// The UVs go in as one run from channel 0, so they have to be in the section's precision and fit in its channels
+	template<typename Type>
+	typename TEnableIf<FRuntimeMeshVertexStreamLayout<Type>::HasRawUVs, bool>::Type
+		CopyRawUVs(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		typedef FRuntimeMeshVertexStreamLayout<Type> Layout;
+		if (Layout::HasHighPrecisionUVs != bUVHighPrecision || Layout::NumUVs > UVChannelCount)
+		{
+			return false;
+		}
+
+		CopyRawComponent<Layout::NumUVs * Layout::UVSize>(UVStream, UVStride, 0,
+			reinterpret_cast<const uint8*>(Vertices), sizeof(Type), Layout::UVOffset, StartIndex, Count);
+		return true;
+	}
+
+	template<typename Type>
+	typename TEnableIf<!FRuntimeMeshVertexStreamLayout<Type>::HasRawUVs, bool>::Type
+		CopyRawUVs(int32 StartIndex, const Type* Vertices, int32 Count)
+	{
+		return false;
+	}
+
+
 
 
 public:
@@ -329,6 +511,65 @@ public:
 		SetUV7Value(Index, Vertex);
 	}
 
+	/**
+	*	Sets the properties of a run of existing vertices from packed vertices like the generic vertex. Each stream the
+	*	vertex type holds in the section's own format is copied as is, in one copy when the type is laid out exactly
+	*	like the stream, and only the rest is converted vertex by vertex.
+	*/
+	template<typename VertexType>
+	void SetVertexPropertiesRange(int32 StartIndex, const VertexType* Vertices, int32 Count)
+	{
+		check(bIsInitialized);
+		check(!bIsReadonly);
+		check(StartIndex >= 0 && Count >= 0 && StartIndex + Count <= NumVertices());
+
+		if (Count == 0)
+		{
+			return;
+		}
+
+		if (!CopyRawPositions(StartIndex, Vertices, Count))
+		{
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				SetPositionValue(StartIndex + Index, Vertices[Index]);
+			}
+		}
+
+		if (!CopyRawTangents(StartIndex, Vertices, Count))
+		{
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				SetNormalValue(StartIndex + Index, Vertices[Index]);
+				SetTangentValue(StartIndex + Index, Vertices[Index]);
+			}
+		}
+
+		if (!CopyRawColors(StartIndex, Vertices, Count))
+		{
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				SetColorValue(StartIndex + Index, Vertices[Index]);
+			}
+		}
+
+		if (!CopyRawUVs(StartIndex, Vertices, Count))
+		{
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				const VertexType& Vertex = Vertices[Index];
+				SetUV0Value(StartIndex + Index, Vertex);
+				SetUV1Value(StartIndex + Index, Vertex);
+				SetUV2Value(StartIndex + Index, Vertex);
+				SetUV3Value(StartIndex + Index, Vertex);
+				SetUV4Value(StartIndex + Index, Vertex);
+				SetUV5Value(StartIndex + Index, Vertex);
+				SetUV6Value(StartIndex + Index, Vertex);
+				SetUV7Value(StartIndex + Index, Vertex);
+			}
+		}
+	}
+
 	template<typename VertexType0>
 	void AddVertexByProperties(const VertexType0& Vertex0)
 	{
@@ -417,8 +658,31 @@ public:
 	bool SetIndices(const int32 InsertAtIndex, const TArray<int32>& Indices, const int32 Count, const bool bSizeToFit);
 	bool SetIndices(const int32 InsertAtIndex, const int32 *const Indices, const int32 Count, const bool bSizeToFit);
 
+	/** View of the whole index stream. IndexType has to be the stream's width, uint16 for 16 bit indices or int32/uint32 for 32 bit. */
+	template<typename IndexType>
+	TArrayView<IndexType> GetIndexSpan()
+	{
+		check(!bIsReadonly);
+		return GetIndexStreamSpan<IndexType>();
+	}
+
+	template<typename IndexType>
+	TArrayView<const IndexType> GetIndexSpan() const
+	{
+		return GetIndexStreamSpan<const IndexType>();
+	}
+
 protected:
 
+	template<typename IndexType>
+	TArrayView<IndexType> GetIndexStreamSpan() const
+	{
+		static_assert(FRuntimeMeshIndexTraits<typename TRemoveCV<IndexType>::Type>::IsValidIndexType, "Invalid index type.");
+		check(bIsInitialized);
+		check((FRuntimeMeshIndexTraits<typename TRemoveCV<IndexType>::Type>::Is32Bit != 0) == b32BitIndices);
+		return TArrayView<IndexType>(reinterpret_cast<IndexType*>(IndexStream->GetData()), IndexStream->Num() / (int32)sizeof(IndexType));
+	}
+
 	FORCEINLINE int32 GetIndexStride() const { return b32BitIndices ? sizeof(int32) : sizeof(uint16); }
 
 	void Unlink()
@@ -487,12 +751,38 @@ public:
 };
 
 
+/**
+ * Readonly accessor over a snapshot of a section's streams.
+ * Holds its own references to the section's stream blocks, so it stays valid after the lock is released.
+ * Later writes, compression or releasing the section's data swap in new blocks and leave this one untouched.
+ */
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshSharedReadonlyAccessor : public FRuntimeMeshAccessor
+{
+	FRuntimeMeshSharedStreamDataPtr PositionStream;
+	FRuntimeMeshSharedStreamDataPtr TangentStream;
+	FRuntimeMeshSharedStreamDataPtr UVStream;
+	FRuntimeMeshSharedStreamDataPtr ColorStream;
+
+	FRuntimeMeshSharedStreamDataPtr IndexStream;
+
+public:
+	FRuntimeMeshSharedReadonlyAccessor(bool bInTangentsHighPrecision, bool bInUVsHighPrecision, int32 bInUVCount, bool bIn32BitIndices, const FRuntimeMeshSharedStreamDataPtr& InPositionStream,
+		const FRuntimeMeshSharedStreamDataPtr& InTangentStream, const FRuntimeMeshSharedStreamDataPtr& InUVStream, const FRuntimeMeshSharedStreamDataPtr& InColorStream, const FRuntimeMeshSharedStreamDataPtr& InIndexStream);
+
+	virtual ~FRuntimeMeshSharedReadonlyAccessor() override;
+};
+
+
 class RUNTIMEMESHCOMPONENT_API FRuntimeMeshScopedUpdater : public FRuntimeMeshAccessor, private FRuntimeMeshScopeLock
 {
 	FRuntimeMeshDataPtr	LinkedMeshData;
 	int32 SectionIndex;
 	int32 LODIndex;
 	ESectionUpdateFlags UpdateFlags;
+
+	// Stream lengths when the update began, ranged commits can only be partial if these haven't changed
+	int32 StartingNumVertices;
+	int32 StartingNumIndices;
 	
 private:
 	FRuntimeMeshScopedUpdater(const FRuntimeMeshDataPtr& InLinkedMeshData, int32 InSectionIndex, int32 InLODIndex, ESectionUpdateFlags InUpdateFlags, bool bInTangentsHighPrecision, bool bInUVsHighPrecision, int32 bInUVCount, bool bIn32BitIndices, TArray<uint8>* PositionStreamData,
@@ -503,8 +793,24 @@ public:
 
 	void Commit(bool bNeedsPositionUpdate = true, bool bNeedsNormalTangentUpdate = true, bool bNeedsColorUpdate = true, bool bNeedsUVUpdate = true, bool bNeedsIndexUpdate = true);
 	void Commit(const FBox& BoundingBox, bool bNeedsPositionUpdate = true, bool bNeedsNormalTangentUpdate = true, bool bNeedsColorUpdate = true, bool bNeedsUVUpdate = true, bool bNeedsIndexUpdate = true);
+
+	/**
+	 *	Commits only the given ranges of vertices and indices. Meshes using shared section buffers only send the changed
+	 *	data to the render thread, others and any stream whose length changed during this update are sent whole.
+	 */
+	void Commit(const FRuntimeMeshStreamRange& DirtyVertices, const FRuntimeMeshStreamRange& DirtyIndices, bool bNeedsPositionUpdate = true, bool bNeedsNormalTangentUpdate = true, 
+		bool bNeedsColorUpdate = true, bool bNeedsUVUpdate = true, bool bNeedsIndexUpdate = true);
+	void Commit(const FBox& BoundingBox, const FRuntimeMeshStreamRange& DirtyVertices, const FRuntimeMeshStreamRange& DirtyIndices, bool bNeedsPositionUpdate = true, 
+		bool bNeedsNormalTangentUpdate = true, bool bNeedsColorUpdate = true, bool bNeedsUVUpdate = true, bool bNeedsIndexUpdate = true);
 	void Cancel();
 
+private:
+	static ERuntimeMeshBuffersToUpdate GetBuffersToUpdate(bool bNeedsPositionUpdate, bool bNeedsNormalTangentUpdate, bool bNeedsColorUpdate, bool bNeedsUVUpdate, bool bNeedsIndexUpdate);
+
+	void CommitInternal(ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FBox* BoundingBox, const FRuntimeMeshStreamRange& DirtyVertices, const FRuntimeMeshStreamRange& DirtyIndices);
+
+public:
+
 	friend class FRuntimeMeshData;
 	friend class FRuntimeMeshSection;
 	friend class FRuntimeMeshSectionLODData;
@@ -544,3 +850,185 @@ FORCEINLINE FRuntimeMeshBuilderRef MakeRuntimeMeshBuilder(const FRuntimeMeshAcce
 {
 	return MakeShared<FRuntimeMeshBuilder>(StructureToCopy.IsUsingHighPrecisionTangents(), StructureToCopy.IsUsingHighPrecisionUVs(), StructureToCopy.NumUVChannels(), StructureToCopy.IsUsing32BitIndices());
 }
+
+
+/**
+*	Mesh builder with its format fixed at compile time. TangentType is FRuntimeMeshTangents or FRuntimeMeshTangentsHighPrecision,
+*	UVType is FVector2D or FVector2DHalf and IndexType is uint16, int32 or uint32, like MakeRuntimeMeshBuilder. Each stream is a typed
+*	array already in the section's format, so the accessors are inlined with no per vertex format checks, and the streams are
+*	copied to a section in whole blocks.
+*/
+template<typename TangentType, typename UVType, typename IndexType, int32 NumUVs = 1>
+class TRuntimeMeshBuilder
+{
+	static_assert(FRuntimeMeshVertexStreamLayout<TangentType>::IsTangentStream, "Invalid Tangent type.");
+	static_assert(TAreTypesEqual<UVType, FVector2D>::Value || TAreTypesEqual<UVType, FVector2DHalf>::Value, "Invalid UV type.");
+	static_assert(FRuntimeMeshIndexTraits<IndexType>::IsValidIndexType, "Invalid index type.");
+	static_assert(NumUVs > 0 && NumUVs <= RUNTIMEMESH_MAXTEXCOORDS, "Invalid UV channel count.");
+
+	TArray<FVector> Positions;
+	TArray<TangentType> Tangents;
+	TArray<UVType> UVs;
+	TArray<FColor> Colors;
+
+	TArray<IndexType> Indices;
+
+public:
+	static const bool bHighPrecisionTangents = FRuntimeMeshVertexStreamLayout<TangentType>::HasHighPrecisionTangentBasis;
+	static const bool bHighPrecisionUVs = TAreTypesEqual<UVType, FVector2D>::Value;
+	static const bool b32BitIndices = FRuntimeMeshIndexTraits<IndexType>::Is32Bit;
+
+	FORCEINLINE int32 NumVertices() const { return Positions.Num(); }
+	FORCEINLINE static int32 NumUVChannels() { return NumUVs; }
+
+	void EmptyVertices(int32 Slack = 0)
+	{
+		Positions.Empty(Slack);
+		Tangents.Empty(Slack);
+		UVs.Empty(Slack * NumUVs);
+		Colors.Empty(Slack);
+	}
+
+	void SetNumVertices(int32 NewNum)
+	{
+		Positions.SetNumZeroed(NewNum);
+		Tangents.SetNumZeroed(NewNum);
+		UVs.SetNumZeroed(NewNum * NumUVs);
+		Colors.SetNumZeroed(NewNum);
+	}
+
+	FORCEINLINE int32 AddVertex(const FVector& InPosition)
+	{
+		const int32 NewIndex = Positions.Add(InPosition);
+		Tangents.AddZeroed();
+		UVs.AddZeroed(NumUVs);
+		Colors.AddZeroed();
+		return NewIndex;
+	}
+
+	FORCEINLINE FVector GetPosition(int32 Index) const { return Positions[Index]; }
+	FORCEINLINE FVector4 GetNormal(int32 Index) const { return ToNormal(Tangents[Index].Normal); }
+	FORCEINLINE FVector GetTangent(int32 Index) const { return ToTangent(Tangents[Index].Tangent); }
+	FORCEINLINE FColor GetColor(int32 Index) const { return Colors[Index]; }
+	FORCEINLINE FVector2D GetUV(int32 Index, int32 Channel = 0) const { return UVs[Index * NumUVs + Channel]; }
+
+	FORCEINLINE void SetPosition(int32 Index, const FVector& Value) { Positions[Index] = Value; }
+	FORCEINLINE void SetNormal(int32 Index, const FVector4& Value) { Tangents[Index].Normal = Value; }
+	FORCEINLINE void SetTangent(int32 Index, const FVector& Value) { Tangents[Index].Tangent = Value; }
+	FORCEINLINE void SetColor(int32 Index, const FColor& Value) { Colors[Index] = Value; }
+	FORCEINLINE void SetUV(int32 Index, const FVector2D& Value) { UVs[Index * NumUVs] = Value; }
+	FORCEINLINE void SetUV(int32 Index, int32 Channel, const FVector2D& Value) { UVs[Index * NumUVs + Channel] = Value; }
+
+	FORCEINLINE void SetTangent(int32 Index, const FRuntimeMeshTangent& Value)
+	{
+		FVector4 NewNormal = GetNormal(Index);
+		NewNormal.W = Value.bFlipTangentY ? -1.0f : 1.0f;
+		Tangents[Index].Normal = NewNormal;
+		Tangents[Index].Tangent = Value.TangentX;
+	}
+
+	FORCEINLINE void SetNormalTangent(int32 Index, FVector Normal, FRuntimeMeshTangent Tangent)
+	{
+		Tangents[Index].Normal = FVector4(Normal, Tangent.bFlipTangentY ? -1 : 1);
+		Tangents[Index].Tangent = Tangent.TangentX;
+	}
+
+	FORCEINLINE void SetTangents(int32 Index, FVector TangentX, FVector TangentY, FVector TangentZ)
+	{
+		Tangents[Index].Normal = FVector4(TangentZ, GetBasisDeterminantSign(TangentX, TangentY, TangentZ));
+		Tangents[Index].Tangent = TangentX;
+	}
+
+	/** Direct views of the streams, laid out the same as FRuntimeMeshVerticesAccessor's */
+	TArrayView<FVector> GetPositionSpan() { return Positions; }
+	TArrayView<TangentType> GetPackedTangentSpan() { return Tangents; }
+	TArrayView<UVType> GetUVSpan() { return UVs; }
+	TArrayView<FColor> GetColorSpan() { return Colors; }
+
+
+	FORCEINLINE int32 NumIndices() const { return Indices.Num(); }
+	void EmptyIndices(int32 Slack = 0) { Indices.Empty(Slack); }
+	void SetNumIndices(int32 NewNum) { Indices.SetNumZeroed(NewNum); }
+
+	FORCEINLINE int32 AddIndex(int32 NewIndex) { return Indices.Add((IndexType)NewIndex); }
+
+	FORCEINLINE int32 AddTriangle(int32 Index0, int32 Index1, int32 Index2)
+	{
+		const int32 NewPosition = Indices.AddUninitialized(3);
+		Indices[NewPosition + 0] = (IndexType)Index0;
+		Indices[NewPosition + 1] = (IndexType)Index1;
+		Indices[NewPosition + 2] = (IndexType)Index2;
+		return NewPosition;
+	}
+
+	FORCEINLINE int32 GetIndex(int32 Index) const { return (int32)Indices[Index]; }
+	FORCEINLINE void SetIndex(int32 Index, int32 Value) { Indices[Index] = (IndexType)Value; }
+
+	TArrayView<IndexType> GetIndexSpan() { return Indices; }
+
+
+	/**
+	*	Copies the streams into a new FRuntimeMeshBuilder, one block per stream, for CreateMeshSectionByMove or UpdateMeshSectionByMove.
+	*	Leaves this builder empty.
+	*/
+	FRuntimeMeshBuilderRef MoveToBuilder()
+	{
+		FRuntimeMeshBuilderRef Builder = MakeRuntimeMeshBuilder(bHighPrecisionTangents, bHighPrecisionUVs, NumUVs, b32BitIndices);
+
+		MoveStreamToBytes(Positions, Builder->GetPositionStream());
+		MoveStreamToBytes(Tangents, Builder->GetTangentStream());
+		MoveStreamToBytes(UVs, Builder->GetUVStream());
+		MoveStreamToBytes(Colors, Builder->GetColorStream());
+		MoveStreamToBytes(Indices, Builder->GetIndexStream());
+		return Builder;
+	}
+
+	/**
+	*	Copies the streams as they are into an accessor of the same format, like a section's FRuntimeMeshScopedUpdater
+	*	before its Commit. The accessor's vertices and indices are resized to match.
+	*/
+	void CopyTo(FRuntimeMeshAccessor& Other) const
+	{
+		check(Other.IsUsingHighPrecisionTangents() == bHighPrecisionTangents);
+		check(Other.IsUsingHighPrecisionUVs() == bHighPrecisionUVs && Other.NumUVChannels() == NumUVs);
+		check(Other.IsUsing32BitIndices() == b32BitIndices);
+
+		Other.SetNumVertices(NumVertices());
+		Other.SetNumIndices(NumIndices());
+
+		FMemory::Memcpy(Other.GetPositionSpan().GetData(), Positions.GetData(), Positions.Num() * sizeof(FVector));
+		FMemory::Memcpy(Other.GetPackedTangentSpan<TangentType>().GetData(), Tangents.GetData(), Tangents.Num() * sizeof(TangentType));
+		FMemory::Memcpy(Other.GetUVSpan<UVType>().GetData(), UVs.GetData(), UVs.Num() * sizeof(UVType));
+		FMemory::Memcpy(Other.GetColorSpan().GetData(), Colors.GetData(), Colors.Num() * sizeof(FColor));
+		FMemory::Memcpy(Other.GetIndexSpan<IndexType>().GetData(), Indices.GetData(), Indices.Num() * sizeof(IndexType));
+	}
+
+private:
+	template<typename PackedType>
+	FORCEINLINE static FVector4 ToNormal(const PackedType& Input)
+	{
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
+		return Input.ToFVector4();
+#else
+		return Input;
+#endif
+	}
+
+	template<typename PackedType>
+	FORCEINLINE static FVector ToTangent(const PackedType& Input)
+	{
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 20
+		return Input.ToFVector();
+#else
+		return Input;
+#endif
+	}
+
+	template<typename ElementType>
+	static void MoveStreamToBytes(TArray<ElementType>& Source, TArray<uint8>& Dest)
+	{
+		Dest.SetNumUninitialized(Source.Num() * sizeof(ElementType));
+		FMemory::Memcpy(Dest.GetData(), Source.GetData(), Dest.Num());
+		Source.Empty();
+	}
+};
@@ -0,0 +1,65 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+class FRuntimeMeshSectionLODData;
+
+
+/** A run of spatially close triangles in a section LOD's index buffer, with the bounds to cull it on its own */
+struct FRuntimeMeshCluster
+{
+	/** Range of the cluster within the LOD's index buffer */
+	int32 FirstIndex;
+	int32 NumIndices;
+
+	/** Sphere around the cluster's vertices, in the section's local space */
+	FVector BoundsCenter;
+	float BoundsRadius;
+
+	/** Average facing of the triangles */
+	FVector ConeAxis;
+
+	/** Sine of the widest angle any triangle faces away from the axis. 1 if they spread too far for the cluster to ever be all backfacing */
+	float ConeCutoff;
+
+	FRuntimeMeshCluster()
+		: FirstIndex(0), NumIndices(0), BoundsCenter(FVector::ZeroVector), BoundsRadius(0.0f), ConeAxis(FVector::UpVector), ConeCutoff(1.0f)
+	{ }
+
+	/**
+	*	Is every triangle of the cluster facing away from a viewer at this position, in the same local space.
+	*	Any point in the bounds has to be within 90 degrees minus the cone angle of the axis, as seen from the viewer.
+	*/
+	bool IsBackfacing(const FVector& LocalViewOrigin) const
+	{
+		const FVector ToCluster = BoundsCenter - LocalViewOrigin;
+		return FVector::DotProduct(ToCluster, ConeAxis) >= ConeCutoff * ToCluster.Size() + BoundsRadius * (1.0f + ConeCutoff);
+	}
+};
+
+
+/*
+*	Splits a triangle list into clusters of a few hundred triangles that can be frustum and backface culled on
+*	their own. Triangles are sorted along a Morton curve through their centers, then cut into runs, closing a run
+*	early once it's big enough if the next triangle faces too far from the rest. Within a cluster triangles keep
+*	their existing relative order, so an earlier vertex cache optimization mostly survives.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshClusterBuilder
+{
+	/** Most triangles in a cluster */
+	static const int32 DefaultMaxTriangles = 256;
+
+	/**
+	*	Gets the new triangle order and the clusters within it. Meshes with no more than MaxTriangles triangles
+	*	aren't worth splitting and get no clusters. Safe to call from any thread.
+	*/
+	static void BuildClusters(const TArray<uint32>& Indices, const TArray<FVector>& Positions, int32 MaxTriangles, TArray<uint32>& OutIndices, TArray<FRuntimeMeshCluster>& OutClusters);
+
+	/**
+	*	Clusters the LOD, rewriting its index buffer in cluster order. Vertices don't move. The adjacency indices keep
+	*	their own triangle order, so clusters can't be used to draw them. Returns false if no clusters were made.
+	*/
+	static bool ClusterLOD(FRuntimeMeshSectionLODData& LOD, int32 MaxTriangles, TArray<FRuntimeMeshCluster>& OutClusters);
+};
@@ -447,6 +447,24 @@ public:
 		GetOrCreateRuntimeMesh()->UpdateMeshSectionTriangles(SectionId, InTriangles, UpdateFlags, LODIndex);
 	}
 
+	template<typename VertexType0>
+	FORCEINLINE void UpdateMeshSectionPrimaryBufferRange(int32 SectionId, const TArray<VertexType0>& InVertices0, int32 StartVertex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		GetOrCreateRuntimeMesh()->UpdateMeshSectionPrimaryBufferRange(SectionId, InVertices0, StartVertex, UpdateFlags, LODIndex);
+	}
+
+	template<typename VertexType1>
+	FORCEINLINE void UpdateMeshSectionSecondaryBufferRange(int32 SectionId, const TArray<VertexType1>& InVertices1, int32 StartVertex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		GetOrCreateRuntimeMesh()->UpdateMeshSectionSecondaryBufferRange(SectionId, InVertices1, StartVertex, UpdateFlags, LODIndex);
+	}
+
+	template<typename IndexType>
+	FORCEINLINE void UpdateMeshSectionTrianglesRange(int32 SectionId, const TArray<IndexType>& InTriangles, int32 StartIndex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		GetOrCreateRuntimeMesh()->UpdateMeshSectionTrianglesRange(SectionId, InTriangles, StartIndex, UpdateFlags, LODIndex);
+	}
+
 
 
 	FORCEINLINE void CreateMeshSection(int32 SectionId, const TSharedPtr<FRuntimeMeshBuilder>& MeshData, bool bCreateCollision = false,
@@ -519,6 +537,11 @@ public:
 			UpdateFrequency, UpdateFlags, bUseHighPrecisionTangents, bUseHighPrecisionUVs, LODIndex);
 	}
 
+	FORCEINLINE void CreateMeshSections(TArrayView<const FRuntimeMeshSectionBulkDesc> SectionDescs)
+	{
+		GetOrCreateRuntimeMesh()->CreateMeshSections(SectionDescs);
+	}
+
 
 	FORCEINLINE void UpdateMeshSection(int32 SectionIndex, const TArray<FVector>& Vertices, const TArray<FVector>& Normals, const TArray<FVector2D>& UV0,
 	const TArray<FColor>& Colors, const TArray<FRuntimeMeshTangent>& Tangents, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
@@ -906,6 +929,37 @@ public:
 		return GetRuntimeMesh() != nullptr ? GetRuntimeMesh()->IsCollisionUsingAsyncCooking() : false;
 	}
 
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SetUseSharedSectionBuffers(bool bNewValue)
+	{
+		GetOrCreateRuntimeMesh()->SetUseSharedSectionBuffers(bNewValue);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	bool IsUsingSharedSectionBuffers()
+	{
+		check(IsInGameThread());
+		return GetRuntimeMesh() != nullptr ? GetRuntimeMesh()->IsUsingSharedSectionBuffers() : false;
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void SetVertexWeldTolerances(float PositionTolerance = 0.00002f, float TangentTolerance = 0.01f, float UVTolerance = 0.0009765625f)
+	{
+		GetOrCreateRuntimeMesh()->SetVertexWeldTolerances(PositionTolerance, TangentTolerance, UVTolerance);
+	}
+
+	TUniquePtr<FRuntimeMeshScopedBatch> BeginBatch()
+	{
+		return GetOrCreateRuntimeMesh()->BeginBatch();
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
+	void GenerateSectionLODs(int32 SectionId, const TArray<float>& LODTriangleRatios, float NormalWeight = 1.0f, float UVWeight = 1.0f,
+		float BorderWeight = 10.0f, float MinTriangleNormalDot = 0.2f)
+	{
+		GetOrCreateRuntimeMesh()->GenerateSectionLODs(SectionId, LODTriangleRatios, NormalWeight, UVWeight, BorderWeight, MinTriangleNormalDot);
+	}
+
 	UFUNCTION(BlueprintCallable, Category = "Components|RuntimeMesh")
 	void SetCollisionMode(ERuntimeMeshCollisionCookingMode NewMode)
 	{
@@ -0,0 +1,89 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+class FRuntimeMeshSectionLODData;
+
+
+/** Grid a LOD's positions are quantized to, 16 bit offsets from Min in steps of Step */
+struct FRuntimeMeshPositionGrid
+{
+	FVector Min;
+	FVector Step;
+	bool bIsValid;
+
+	FRuntimeMeshPositionGrid()
+		: Min(FVector::ZeroVector), Step(FVector::ZeroVector), bIsValid(false)
+	{ }
+
+	FRuntimeMeshPositionGrid(const FBox& Bounds)
+		: Min(Bounds.IsValid ? Bounds.Min : FVector::ZeroVector)
+		, Step(Bounds.IsValid ? (Bounds.Max - Bounds.Min) / 65535.0f : FVector::ZeroVector)
+		, bIsValid(!!Bounds.IsValid)
+	{ }
+
+	FVector GetMax() const { return Min + Step * 65535.0f; }
+
+	/** Whether the bounds lie on the grid and span at least half of it on every axis, so quantizing them to it loses at most one bit */
+	bool CanQuantize(const FBox& Bounds) const
+	{
+		if (!bIsValid || !Bounds.IsValid)
+		{
+			return false;
+		}
+
+		const FVector Max = GetMax();
+		const FVector GridSize = Max - Min;
+		const FVector BoundsSize = Bounds.GetSize();
+		return Bounds.Min.X >= Min.X && Bounds.Min.Y >= Min.Y && Bounds.Min.Z >= Min.Z
+			&& Bounds.Max.X <= Max.X && Bounds.Max.Y <= Max.Y && Bounds.Max.Z <= Max.Z
+			&& GridSize.X <= BoundsSize.X * 2.0f && GridSize.Y <= BoundsSize.Y * 2.0f && GridSize.Z <= BoundsSize.Z * 2.0f;
+	}
+};
+
+
+/** Compact copy of a section LOD's streams, kept in place of the raw streams while the section isn't being used */
+struct FRuntimeMeshCompressedLODData
+{
+	/** All the streams packed together and run through zlib */
+	TArray<uint8> Data;
+
+	/** Size of the packed streams before zlib, or INDEX_NONE if zlib didn't help and Data is stored as is */
+	int32 PackedSize;
+
+	/** Grid the positions are stored on */
+	FRuntimeMeshPositionGrid PositionGrid;
+
+	int32 NumVertices;
+	int32 NumIndices;
+	int32 NumAdjacencyIndices;
+
+	/** Size of the original streams, used for the compression stats */
+	int32 RawSize;
+
+	FRuntimeMeshCompressedLODData()
+		: PackedSize(INDEX_NONE), NumVertices(0), NumIndices(0), NumAdjacencyIndices(0), RawSize(0)
+	{ }
+};
+
+
+/*
+*	Packs section LOD streams for storage while they're not in use.
+*	Positions are quantized to 16 bits per axis within the bounds of the LOD, so they come back accurate to
+*	1/65535th of the size of the LOD on each axis. A LOD that's compressed again keeps its last grid while that still
+*	fits, so positions that haven't moved since they were unpacked are stored exactly as before and round trips don't build up error. Indices are delta and varint coded. Tangents, UVs and
+*	colors are kept in their existing packed formats. Everything is then compressed with zlib.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshSectionCompression
+{
+	/** Packs the LOD's streams into OutData and empties the LOD. PreviousGrid is the grid the LOD was last unpacked from, if any. */
+	static void CompressLOD(FRuntimeMeshSectionLODData& LOD, FRuntimeMeshCompressedLODData& OutData, const FRuntimeMeshPositionGrid& PreviousGrid = FRuntimeMeshPositionGrid());
+
+	/** Restores the LOD's streams from InData, which is emptied */
+	static void DecompressLOD(FRuntimeMeshCompressedLODData& InData, FRuntimeMeshSectionLODData& LOD);
+
+	/** Drops compressed data that's no longer needed, keeping the stats in sync */
+	static void DiscardCompressedLOD(FRuntimeMeshCompressedLODData& InData);
+};
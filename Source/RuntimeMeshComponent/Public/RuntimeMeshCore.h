@@ -38,6 +38,9 @@ namespace FRuntimeMeshVersion
 
 		AddLODSupport = 8,
 
+		// Sections remember whether they're render only or keep their CPU copy compressed
+		AddSectionCPUDataModes = 9,
+
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
 		LatestVersion = VersionPlusOne - 1
@@ -149,6 +152,48 @@ enum class ESectionUpdateFlags
 	*/
 	CalculateTessellationIndices = 0x8,
 
+	/**
+	*	Drops the game thread copy of the section's mesh data once this creation or update has been
+	*	sent to the render thread, roughly halving the memory used by the section. The section can't be
+	*	read, updated, used for collision or saved after that, so only use this for meshes that are never touched again.
+	*/
+	RenderOnly = 0x10,
+
+	/**
+	*	Keeps the game thread copy of the section's mesh data compressed whenever it's not being read or updated.
+	*	Positions are quantized to 16 bits per axis within the section bounds, so this is slightly lossy.
+	*	Best for sections that need a CPU copy for collision, slicing or saving but rarely change, like Infrequent ones.
+	*/
+	CompressCPUData = 0x20,
+
+	/**
+	*	Reorders the triangles for better reuse of the GPU's post transform vertex cache, then reorders the vertices
+	*	into the order they're first used. Every stream of the section is rewritten, so vertex and triangle indices
+	*	change. Big sections are optimized on a worker thread and sent again once done.
+	*/
+	OptimizeVertexCache = 0x40,
+
+	/**
+	*	Same as OptimizeVertexCache, but also sorts groups of triangles so the outward facing ones draw first,
+	*	reducing overdraw within the section for a slightly worse cache hit rate.
+	*/
+	OptimizeOverdraw = 0x80,
+
+	/**
+	*	Merges vertices that match in position, tangents, UVs and color within the mesh's weld tolerances, then drops
+	*	the triangles that became degenerate or duplicated and any vertices left unused. Every stream is compacted, so
+	*	vertex and triangle indices change. Runs before tangents are calculated, which then ignores tangents when matching.
+	*/
+	WeldVertices = 0x100,
+
+	/**
+	*	Splits the triangles into clusters of a few hundred that are frustum and backface culled on their own when the
+	*	section draws in the dynamic path, for big sections that are often only partly visible. Reorders the triangles,
+	*	so triangle indices change, but leaves vertices alone. Runs after the vertex cache optimization and keeps most
+	*	of it, but undoes the overdraw sort. Sections drawn with tessellation or 16 bit index segments aren't cluster culled.
+	*/
+	BuildClusters = 0x200,
+
 };
 ENUM_CLASS_FLAGS(ESectionUpdateFlags)
 
@@ -443,6 +488,184 @@ private:
 };
 
 
+/** Contiguous range of elements (vertices or indices) within a stream that were modified by an update */
+struct FRuntimeMeshStreamRange
+{
+	int32 Start;
+	int32 Count;
+
+	/** Creates an empty range */
+	FRuntimeMeshStreamRange() : Start(0), Count(0) { }
+	FRuntimeMeshStreamRange(int32 InStart, int32 InCount) : Start(InStart), Count(InCount) { }
+
+	/** Range covering the whole stream, whatever its length */
+	static FRuntimeMeshStreamRange All() { return FRuntimeMeshStreamRange(0, MAX_int32); }
+
+	bool IsEmpty() const { return Count <= 0; }
+
+	/** Does this range cover every element of a stream of the given length */
+	bool Covers(int32 NumElements) const { return Start <= 0 && (int64)Start + Count >= NumElements; }
+
+	/** Returns this range clipped to a stream of the given length */
+	FRuntimeMeshStreamRange Clamp(int32 NumElements) const
+	{
+		const int32 ClampedStart = FMath::Clamp(Start, 0, NumElements);
+		const int64 End = FMath::Min<int64>((int64)Start + Count, NumElements);
+		return FRuntimeMeshStreamRange(ClampedStart, (int32)FMath::Max<int64>(End - ClampedStart, 0));
+	}
+
+	/** Returns the smallest range containing both ranges */
+	FRuntimeMeshStreamRange Union(const FRuntimeMeshStreamRange& Other) const
+	{
+		if (IsEmpty())
+		{
+			return Other;
+		}
+		if (Other.IsEmpty())
+		{
+			return *this;
+		}
+		const int32 NewStart = FMath::Min(Start, Other.Start);
+		const int64 NewEnd = FMath::Max((int64)Start + Count, (int64)Other.Start + Other.Count);
+		return FRuntimeMeshStreamRange(NewStart, (int32)FMath::Min<int64>(NewEnd - NewStart, MAX_int32));
+	}
+};
+
+
+/** How a section's indices were last sent to the render thread */
+enum class ERuntimeMeshIndexEncoding : uint8
+{
+	/** Nothing has been sent since the indices were loaded, so the render thread format isn't known */
+	Unknown,
+
+	/** Sent in the section's own format */
+	None,
+
+	/** 32 bit indices that all fit in 16 bits, sent as 16 bit */
+	Packed16,
+
+	/** 32 bit indices split into segments, each sent as 16 bit offsets from its own base vertex */
+	Segmented16,
+};
+
+/** Run of whole primitives within an index buffer that's drawn relative to its own base vertex */
+struct FRuntimeMeshIndexSegment
+{
+	int32 FirstIndex;
+	int32 NumIndices;
+	int32 BaseVertexIndex;
+
+	FRuntimeMeshIndexSegment() : FirstIndex(0), NumIndices(0), BaseVertexIndex(0) { }
+	FRuntimeMeshIndexSegment(int32 InFirstIndex, int32 InNumIndices, int32 InBaseVertexIndex)
+		: FirstIndex(InFirstIndex), NumIndices(InNumIndices), BaseVertexIndex(InBaseVertexIndex) { }
+};
+
+
+/** Readonly reference to a block of stream data, safe to hand to the render thread */
+using FRuntimeMeshSharedStreamDataPtr = TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>;
+
+/*
+*	Ref counted, copy on write block of stream data.
+*	The game thread copy of a section and any updates in flight to the render thread share the same
+*	allocation. The block is only duplicated when it is written to while something else still holds it.
+*/
+struct FRuntimeMeshSharedStream
+{
+private:
+	TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Block;
+
+public:
+	FRuntimeMeshSharedStream()
+		: Block(MakeShared<TArray<uint8>, ESPMode::ThreadSafe>())
+	{
+	}
+
+	FRuntimeMeshSharedStream(const FRuntimeMeshSharedStream& Other)
+		: Block(MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(*Other.Block))
+	{
+	}
+
+	FRuntimeMeshSharedStream& operator=(const FRuntimeMeshSharedStream& Other)
+	{
+		if (this != &Other)
+		{
+			Block = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(*Other.Block);
+		}
+		return *this;
+	}
+
+	/** Readonly access to the data. Never copies. */
+	const TArray<uint8>& Get() const { return *Block; }
+
+	/** Writable access to the data. Detaches from any other holders first. */
+	TArray<uint8>& GetMutable()
+	{
+		if (!Block.IsUnique())
+		{
+			Block = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(*Block);
+		}
+		return *Block;
+	}
+
+	/** Writable access for callers that will overwrite the whole contents. Never copies the old contents. */
+	TArray<uint8>& GetForOverwrite()
+	{
+		if (!Block.IsUnique())
+		{
+			Block = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+		}
+		return *Block;
+	}
+
+	/** Replaces the data, without copying the old contents if the block is shared */
+	void Set(const TArray<uint8>& InData)
+	{
+		if (Block.IsUnique())
+		{
+			*Block = InData;
+		}
+		else
+		{
+			Block = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(InData);
+		}
+	}
+
+	/** Replaces the data by move, without copying the old contents if the block is shared */
+	void Set(TArray<uint8>&& InData)
+	{
+		if (Block.IsUnique())
+		{
+			*Block = MoveTemp(InData);
+		}
+		else
+		{
+			Block = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(InData));
+		}
+	}
+
+	/** Returns a readonly reference to the current block. Any later write will detach from it. */
+	FRuntimeMeshSharedStreamDataPtr Share() const
+	{
+		return Block;
+	}
+
+	int32 Num() const { return Block->Num(); }
+
+	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshSharedStream& Stream)
+	{
+		if (Ar.IsLoading())
+		{
+			Ar << Stream.GetMutable();
+		}
+		else
+		{
+			Ar << *Stream.Block;
+		}
+		return Ar;
+	}
+};
+
+
 
 
 template<typename T>
@@ -583,6 +806,110 @@ public:
 	static const bool HasHighPrecisionUVs = UVChannelHighPrecisionDetector<HasUV0, T>::Value;
 };
 
+// Offset and type of one named vertex component, INDEX_NONE and void when the vertex type doesn't have it
+#define RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(Component)											\
+	template<bool bHasComponent, typename Dummy = void>											\
+	struct Component##Layout																	\
+	{																							\
+		static const int32 Offset = INDEX_NONE;													\
+		typedef void Type;																		\
+	};																							\
+	template<typename Dummy>																	\
+	struct Component##Layout<true, Dummy>														\
+	{																							\
+		static const int32 Offset = STRUCT_OFFSET(VertexType, Component);						\
+		typedef decltype(DeclVal<VertexType>().Component) Type;									\
+	};
+
+/*
+*	Compile time layout of a vertex type against the section streams. Components held in exactly the stream's own format
+*	can be copied into it as is, without converting each vertex, and a type laid out exactly like a whole stream can be
+*	used as that stream directly. Works off the component names, so it covers the generic vertex declarations and any
+*	user struct named the same way.
+*/
+template<typename VertexType>
+struct FRuntimeMeshVertexStreamLayout
+{
+private:
+	typedef FRuntimeMeshVertexTraits<VertexType> Traits;
+
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(Position)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(Normal)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(Tangent)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(Color)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV0)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV1)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV2)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV3)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV4)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV5)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV6)
+	RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT(UV7)
+
+	typedef typename NormalLayout<Traits::HasNormal>::Type NormalType;
+	typedef typename TangentLayout<Traits::HasTangent>::Type TangentType;
+	typedef typename UV0Layout<Traits::HasUV0>::Type UVType;
+
+	static const bool IsTangentBasisType = TAreTypesEqual<NormalType, FPackedNormal>::Value || TAreTypesEqual<NormalType, FPackedRGBA16N>::Value;
+	static const bool IsTangentType = TAreTypesEqual<TangentType, FPackedNormal>::Value || TAreTypesEqual<TangentType, FPackedRGBA16N>::Value;
+	static const bool IsUVType = TAreTypesEqual<UVType, FVector2D>::Value || TAreTypesEqual<UVType, FVector2DHalf>::Value;
+
+	// Channel N follows straight on from channel N-1 in the same format, or there's no channel N
+	template<bool bHasChannel, typename ChannelLayout, int32 Channel>
+	struct UVChannelFollows
+	{
+		static const bool Value = !bHasChannel || (TAreTypesEqual<typename ChannelLayout::Type, UVType>::Value &&
+			ChannelLayout::Offset == UV0Layout<Traits::HasUV0>::Offset + Channel * (int32)sizeof(UVType));
+	};
+
+	static const bool UVsAreContiguous =
+		UVChannelFollows<Traits::HasUV1, UV1Layout<Traits::HasUV1>, 1>::Value &&
+		UVChannelFollows<Traits::HasUV2, UV2Layout<Traits::HasUV2>, 2>::Value &&
+		UVChannelFollows<Traits::HasUV3, UV3Layout<Traits::HasUV3>, 3>::Value &&
+		UVChannelFollows<Traits::HasUV4, UV4Layout<Traits::HasUV4>, 4>::Value &&
+		UVChannelFollows<Traits::HasUV5, UV5Layout<Traits::HasUV5>, 5>::Value &&
+		UVChannelFollows<Traits::HasUV6, UV6Layout<Traits::HasUV6>, 6>::Value &&
+		UVChannelFollows<Traits::HasUV7, UV7Layout<Traits::HasUV7>, 7>::Value;
+
+	static const bool HasOnlyPosition = Traits::HasPosition && !Traits::HasNormal && !Traits::HasTangent && !Traits::HasColor && Traits::NumUVChannels == 0;
+	static const bool HasOnlyTangentBasis = !Traits::HasPosition && Traits::HasNormal && Traits::HasTangent && !Traits::HasColor && Traits::NumUVChannels == 0;
+	static const bool HasOnlyColor = !Traits::HasPosition && !Traits::HasNormal && !Traits::HasTangent && Traits::HasColor && Traits::NumUVChannels == 0;
+	static const bool HasOnlyUVs = !Traits::HasPosition && !Traits::HasNormal && !Traits::HasTangent && !Traits::HasColor && Traits::NumUVChannels > 0;
+
+public:
+	/** Position as an FVector */
+	static const bool HasRawPosition = Traits::HasPosition && TAreTypesEqual<typename PositionLayout<Traits::HasPosition>::Type, FVector>::Value;
+	static const int32 PositionOffset = PositionLayout<Traits::HasPosition>::Offset;
+
+	/** Normal and tangent in one of the tangent stream's formats. Which one has to be checked against the section. */
+	static const bool HasRawNormal = Traits::HasNormal && IsTangentBasisType;
+	static const bool HasRawTangent = Traits::HasTangent && IsTangentType && (!Traits::HasNormal || TAreTypesEqual<NormalType, TangentType>::Value);
+	static const bool HasHighPrecisionTangentBasis = Traits::HasHighPrecisionNormals;
+	static const int32 TangentBasisSize = HasHighPrecisionTangentBasis ? sizeof(FPackedRGBA16N) : sizeof(FPackedNormal);
+	static const int32 NormalOffset = NormalLayout<Traits::HasNormal>::Offset;
+	static const int32 TangentOffset = TangentLayout<Traits::HasTangent>::Offset;
+
+	/** Color as an FColor */
+	static const bool HasRawColor = Traits::HasColor && TAreTypesEqual<typename ColorLayout<Traits::HasColor>::Type, FColor>::Value;
+	static const int32 ColorOffset = ColorLayout<Traits::HasColor>::Offset;
+
+	/** UV channels as one run from UV0 in one of the UV stream's formats. Which one, and the channel count, have to be checked against the section. */
+	static const bool HasRawUVs = Traits::HasUV0 && IsUVType && UVsAreContiguous;
+	static const bool HasHighPrecisionUVs = Traits::HasHighPrecisionUVs;
+	static const int32 NumUVs = Traits::NumUVChannels;
+	static const int32 UVSize = HasHighPrecisionUVs ? sizeof(FVector2D) : sizeof(FVector2DHalf);
+	static const int32 UVOffset = UV0Layout<Traits::HasUV0>::Offset;
+
+	/** Laid out exactly like a whole stream, so an array of it can be used as that stream */
+	static const bool IsPositionStream = TAreTypesEqual<VertexType, FVector>::Value || (HasOnlyPosition && HasRawPosition && sizeof(VertexType) == sizeof(FVector));
+	static const bool IsTangentStream = HasOnlyTangentBasis && HasRawNormal && HasRawTangent && TangentOffset == 0 && NormalOffset == TangentBasisSize && sizeof(VertexType) == 2 * TangentBasisSize;
+	static const bool IsColorStream = TAreTypesEqual<VertexType, FColor>::Value || (HasOnlyColor && HasRawColor && sizeof(VertexType) == sizeof(FColor));
+	static const bool IsUVStream = HasOnlyUVs && HasRawUVs && UVOffset == 0 && sizeof(VertexType) == NumUVs * UVSize;
+	static const bool IsStream = IsPositionStream || IsTangentStream || IsColorStream || IsUVStream;
+};
+
+#undef RUNTIMEMESH_VERTEX_COMPONENT_LAYOUT
+
 
 struct FRuntimeMeshVertexTypeTraitsAggregator
 {
@@ -3,10 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/ArrayView.h"
 #include "RuntimeMeshCore.h"
 #include "RuntimeMeshCollision.h"
 #include "RuntimeMeshSection.h"
+#include "RuntimeMeshSectionTable.h"
+#include "RuntimeMeshBoundsTree.h"
 #include "RuntimeMeshBlueprint.h"
+#include "RuntimeMeshSimplifier.h"
 
 class URuntimeMesh;
 class FRuntimeMeshProxy;
@@ -16,6 +21,22 @@ using FRuntimeMeshProxyPtr = TSharedPtr<FRuntimeMeshProxy, ESPMode::ThreadSafe>;
 
 DECLARE_DELEGATE_OneParam(FRuntimeMeshGameThreadTaskDelegate, URuntimeMesh*);
 
+/** Notifications waiting to be sent to the mesh on the game thread. Repeats of one collapse into a single send */
+enum class ERuntimeMeshGameThreadNotifications : int32
+{
+	None = 0x0,
+	BoundsChanged = 0x1,
+	CollisionDirty = 0x2,
+	ProxyRecreate = 0x4,
+	Changed = 0x8,
+	SectionsCreated = 0x10,
+	SectionsChanged = 0x20,
+
+	/** Set from when a flush task is dispatched until it starts running */
+	FlushScheduled = 0x40000000,
+};
+ENUM_CLASS_FLAGS(ERuntimeMeshGameThreadNotifications)
+
 
 
 DECLARE_CYCLE_STAT(TEXT("RM - Create Mesh Section - No Data"), STAT_RuntimeMesh_CreateMeshSection_NoData, STATGROUP_RuntimeMesh);
@@ -50,19 +71,56 @@ DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section Secondary Buffer"), STAT_Runti
 DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section Tertiary Buffer"), STAT_RuntimeMesh_UpdateMeshSectionTertiaryBuffer, STATGROUP_RuntimeMesh);
 DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section Triangles"), STAT_RuntimeMesh_UpdateMeshSectionTriangles, STATGROUP_RuntimeMesh);
 
+DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section Primary Buffer Range"), STAT_RuntimeMesh_UpdateMeshSectionPrimaryBufferRange, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section Secondary Buffer Range"), STAT_RuntimeMesh_UpdateMeshSectionSecondaryBufferRange, STATGROUP_RuntimeMesh);
+DECLARE_CYCLE_STAT(TEXT("RM - Update Mesh Section Triangles Range"), STAT_RuntimeMesh_UpdateMeshSectionTrianglesRange, STATGROUP_RuntimeMesh);
+
 DECLARE_CYCLE_STAT(TEXT("RM - Set Section Tessellation Triangles"), STAT_RuntimeMesh_SetSectionTessellationTriangles, STATGROUP_RuntimeMesh);
 
 DECLARE_CYCLE_STAT(TEXT("RM - Serialize Data"), STAT_RuntimeMesh_SerializationOperator, STATGROUP_RuntimeMesh);
 
 
+/** One section for FRuntimeMeshData::CreateMeshSections, the same data as CreateMeshSection takes in separate arrays */
+struct FRuntimeMeshSectionBulkDesc
+{
+	int32 SectionId;
+
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UV0;
+	/** Leave empty for a single UV channel */
+	TArray<FVector2D> UV1;
+	TArray<FColor> Colors;
+	TArray<FRuntimeMeshTangent> Tangents;
+
+	bool bCreateCollision;
+	EUpdateFrequency UpdateFrequency;
+	ESectionUpdateFlags UpdateFlags;
+	bool bUseHighPrecisionTangents;
+	bool bUseHighPrecisionUVs;
+
+	FRuntimeMeshSectionBulkDesc()
+		: SectionId(0)
+		, bCreateCollision(false)
+		, UpdateFrequency(EUpdateFrequency::Average)
+		, UpdateFlags(ESectionUpdateFlags::None)
+		, bUseHighPrecisionTangents(false)
+		, bUseHighPrecisionUVs(true)
+	{ }
+};
+
 /**
  *
  */
 class RUNTIMEMESHCOMPONENT_API FRuntimeMeshData : public TSharedFromThis<FRuntimeMeshData, ESPMode::ThreadSafe>
 {
 
-	/** Array of sections of mesh */
-	TArray<FRuntimeMeshSectionPtr> MeshSections;
+	/** Sections of mesh, keyed by section id */
+	FRuntimeMeshSectionTable MeshSections;
+
+	/** Section id and running face count of each section in the last collision data, used to map hit faces back to sections */
+	TArray<TPair<int32, int32>> CollisionSectionFaceRanges;
 
 	/* Array of collision only mesh sections*/
 	TMap<int32, FRuntimeMeshCollisionSection> MeshCollisionSections;
@@ -72,6 +130,9 @@ class RUNTIMEMESHCOMPONENT_API FRuntimeMeshData : public TSharedFromThis<FRuntim
 
 	TArray<float, TInlineAllocator<RUNTIMEMESH_MAXLODS>> LODScreenSizes;
 
+	/** Tolerances used by ESectionUpdateFlags::WeldVertices */
+	FRuntimeMeshVertexWeldSettings VertexWeldSettings;
+
 	TArray<FRuntimeMeshCollisionBox> CollisionBoxes;
 	TArray<FRuntimeMeshCollisionSphere> CollisionSpheres;
 	TArray<FRuntimeMeshCollisionCapsule> CollisionCapsules;
@@ -79,15 +140,34 @@ class RUNTIMEMESHCOMPONENT_API FRuntimeMeshData : public TSharedFromThis<FRuntim
 	/** Local space bounds of mesh */
 	FBoxSphereBounds LocalBounds;
 
+	/** Bounds of each rendered section keyed by section id, the root is the box LocalBounds is built from */
+	FRuntimeMeshBoundsTree SectionBounds;
+
 	/** Parent mesh object that owns this data. */
 	TWeakObjectPtr<URuntimeMesh> ParentMeshObject;
 
+	/** ERuntimeMeshGameThreadNotifications queued from other threads, sent together by one game thread task */
+	volatile int32 PendingNotifications;
+
+	/** Sections waiting to have their creation or property changes sent to the game thread, may contain repeats */
+	TQueue<int32, EQueueMode::Mpsc> PendingCreatedSections;
+	TQueue<int32, EQueueMode::Mpsc> PendingChangedSections;
+
 	/** Render proxy for this mesh */
 	FRuntimeMeshProxyPtr RenderProxy;
 
 	TUniquePtr<FRuntimeMeshLockProvider> SyncRoot;
 
 	int32 LODForCollision = 0;
+
+	/** Depth of BeginBatch calls. Only changed with SyncRoot held, which a batch keeps hold of until it ends */
+	int32 BatchDepth;
+
+	/** Did the section bounds change during the current batch */
+	bool bBatchBoundsDirty;
+
+	/** Proxy the current batch was started on, a proxy created during the batch isn't part of it */
+	FRuntimeMeshProxyPtr BatchRenderProxy;
 	
 public:
 
@@ -126,6 +206,25 @@ private:
 
 	void CheckBoundingBox(const FBox& Box) const;
 
+	/** Is the range within the section's existing vertices or indices. Logs a warning if not, since ranged updates can't resize a section. */
+	bool CheckStreamRange(int32 SectionId, int32 Start, int32 Count, int32 NumElements, bool bIndices) const;
+
+	/** Does the section still have the CPU copy that in place updates write into. Logs a warning if it's render only and has released it. */
+	bool CheckSectionHasCPUData(int32 SectionId) const;
+
+	template<typename VertexType0, typename VertexType1, typename VertexType2, typename IndexType>
+	void CreateMeshSectionForTypes(int32 SectionIndex, bool bCreateCollision, EUpdateFrequency UpdateFrequency)
+	{
+		CheckCreateLegacy<VertexType0, VertexType1, VertexType2, IndexType>();
+
+		bool bWantsHighPrecisionTangents = FRuntimeMeshVertexTypeTraitsAggregator::IsUsingHighPrecisionTangents<VertexType0, VertexType1, VertexType2>();
+		bool bWantsHighPrecisionUVs = FRuntimeMeshVertexTypeTraitsAggregator::IsUsingHighPrecisionUVs<VertexType0, VertexType1, VertexType2>();
+		int32 NumUVs = FRuntimeMeshVertexTypeTraitsAggregator::NumUVs<VertexType0, VertexType1, VertexType2>();
+		bool bUsing32BitIndices = FRuntimeMeshIndexTraits<IndexType>::Is32Bit;
+
+		CreateMeshSection(SectionIndex, bWantsHighPrecisionTangents, bWantsHighPrecisionUVs, NumUVs, bUsing32BitIndices, bCreateCollision, UpdateFrequency);
+	}
+
 public:
 
 	/* 
@@ -134,8 +233,23 @@ public:
 	*/
 	void EnterSerializedMode();
 
+	/**
+	*	Starts a batch of changes. Until the matching EndBatch the mesh stays locked to this thread, the bounds aren't
+	*	recalculated, linked components aren't told about anything and the render thread gets no section changes.
+	*	Batches nest, and the outermost EndBatch does all of that once and sends every section change in one render command.
+	*	Use FRuntimeMeshScopedBatch rather than calling these directly, a missed EndBatch leaves the mesh locked.
+	*/
+	void BeginBatch();
+	void EndBatch();
+	bool IsBatching() const { return BatchDepth > 0; }
+
 	void SetLODScreenSize(int32 LODIndex, float MinScreenSize);
 
+	/** Sets how close vertices have to be to be merged by ESectionUpdateFlags::WeldVertices. Applies to later creates/updates only. */
+	void SetVertexWeldTolerances(float PositionTolerance, float TangentTolerance, float UVTolerance);
+
+	FRuntimeMeshVertexWeldSettings GetVertexWeldSettings();
+
 	void SetLODForCollision(int32 LODIndex);
 
 	int32 GetLODForCollision();
@@ -161,13 +275,9 @@ public:
 
 		auto Mesh = BeginSectionUpdate(SectionIndex, LODIndex, UpdateFlags);
 		
-		Mesh->EmptyVertices(InVertices0.Num());
-
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->AddVertexByProperties<VertexType0>(InVertices0[Index]);
-		}
+		Mesh->SetNumVertices(InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->EmptyIndices(InTriangles.Num());
 
@@ -198,13 +308,9 @@ public:
 
 		auto Mesh = BeginSectionUpdate(SectionIndex, LODIndex, UpdateFlags);
 
-		Mesh->EmptyVertices(InVertices0.Num());
-
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->AddVertexByProperties<VertexType0>(InVertices0[Index]);
-		}
+		Mesh->SetNumVertices(InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->EmptyIndices(InTriangles.Num());
 
@@ -235,13 +341,10 @@ public:
 
 		auto Mesh = BeginSectionUpdate(SectionIndex, LODIndex, UpdateFlags);
 
-		Mesh->EmptyVertices(InVertices0.Num());
-
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->AddVertexByProperties<VertexType0, VertexType1>(InVertices0[Index], InVertices1[Index]);
-		}
+		Mesh->SetNumVertices(InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
 
 		Mesh->EmptyIndices(InTriangles.Num());
 
@@ -272,13 +375,10 @@ public:
 
 		auto Mesh = BeginSectionUpdate(SectionIndex, LODIndex, UpdateFlags);
 
-		Mesh->EmptyVertices(InVertices0.Num());
-
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->AddVertexByProperties<VertexType0, VertexType1>(InVertices0[Index], InVertices1[Index]);
-		}
+		Mesh->SetNumVertices(InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
 
 		Mesh->EmptyIndices(InTriangles.Num());
 
@@ -309,13 +409,11 @@ public:
 
 		auto Mesh = BeginSectionUpdate(SectionIndex, LODIndex, UpdateFlags);
 
-		Mesh->EmptyVertices(InVertices0.Num());
-
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->AddVertexByProperties<VertexType0, VertexType1, VertexType2>(InVertices0[Index], InVertices1[Index], InVertices2[Index]);
-		}
+		Mesh->SetNumVertices(InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), FMath::Min(InVertices2.Num(), InVertices0.Num()));
 
 		Mesh->EmptyIndices(InTriangles.Num());
 
@@ -346,13 +444,11 @@ public:
 
 		auto Mesh = BeginSectionUpdate(SectionIndex, LODIndex,UpdateFlags);
 
-		Mesh->EmptyVertices(InVertices0.Num());
-
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->AddVertexByProperties<VertexType0, VertexType1, VertexType2>(InVertices0[Index], InVertices1[Index], InVertices2[Index]);
-		}
+		Mesh->SetNumVertices(InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), FMath::Min(InVertices2.Num(), InVertices0.Num()));
 
 		Mesh->EmptyIndices(InTriangles.Num());
 
@@ -380,10 +476,7 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->Commit();
 	}
@@ -403,10 +496,7 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->Commit(BoundingBox);
 	}
@@ -425,10 +515,7 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->SetNumIndices(InTriangles.Num());
 
@@ -456,10 +543,7 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->SetNumIndices(InTriangles.Num());
 
@@ -486,14 +570,8 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
 
 		Mesh->Commit();
 	}
@@ -514,14 +592,8 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
 
 		Mesh->Commit(BoundingBox);
 	}
@@ -541,14 +613,8 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
 
 		Mesh->SetNumIndices(InTriangles.Num());
 
@@ -576,14 +642,8 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
 
 		Mesh->SetNumIndices(InTriangles.Num());
 
@@ -610,18 +670,9 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-			if (InVertices2.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType2>(Index, InVertices2[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), FMath::Min(InVertices2.Num(), InVertices0.Num()));
 
 		Mesh->Commit();
 	}
@@ -642,18 +693,9 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-			if (InVertices2.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType2>(Index, InVertices2[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), FMath::Min(InVertices2.Num(), InVertices0.Num()));
 
 		Mesh->Commit(BoundingBox);
 	}
@@ -673,18 +715,9 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-			if (InVertices2.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType2>(Index, InVertices2[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), FMath::Min(InVertices2.Num(), InVertices0.Num()));
 
 		Mesh->SetNumIndices(InTriangles.Num());
 
@@ -712,18 +745,9 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-			if (InVertices1.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-			}
-			if (InVertices2.Num() > Index)
-			{
-				Mesh->SetVertexProperties<VertexType2>(Index, InVertices2[Index]);
-			}
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), FMath::Min(InVertices1.Num(), InVertices0.Num()));
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), FMath::Min(InVertices2.Num(), InVertices0.Num()));
 
 		Mesh->SetNumIndices(InTriangles.Num());
 
@@ -751,10 +775,7 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->Commit();
 	}
@@ -774,10 +795,7 @@ public:
 		Mesh->SetNumVertices(InVertices0.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < InVertices0.Num(); Index++)
-		{
-			Mesh->SetVertexProperties<VertexType0>(Index, InVertices0[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices0.GetData(), InVertices0.Num());
 
 		Mesh->Commit(BoundingBox);
 	}
@@ -796,10 +814,7 @@ public:
 		int32 NumVerts = FMath::Min(Mesh->NumVertices(), InVertices1.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < NumVerts; Index++)
-		{
-			Mesh->SetVertexProperties<VertexType1>(Index, InVertices1[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices1.GetData(), NumVerts);
 
 		Mesh->Commit();
 	}
@@ -818,10 +833,7 @@ public:
 		int32 NumVerts = FMath::Min(Mesh->NumVertices(), InVertices2.Num());
 
 		// Copy the mesh data to the mesh builder
-		for (int32 Index = 0; Index < NumVerts; Index++)
-		{
-			Mesh->SetVertexProperties<VertexType2>(Index, InVertices2[Index]);
-		}
+		Mesh->SetVertexPropertiesRange(0, InVertices2.GetData(), NumVerts);
 
 		Mesh->Commit();
 	}
@@ -848,6 +860,106 @@ public:
 	}
 
 
+	/**
+	 *	Overwrites the primary buffer vertices starting at StartVertex with the supplied vertices. Only meshes using
+	 *	shared section buffers send just the changed range to the render thread, others send the whole stream.
+	 *	The section must already hold StartVertex + InVertices0.Num() vertices, otherwise nothing is updated.
+	 */
+	template<typename VertexType0>
+	void UpdateMeshSectionPrimaryBufferRange(int32 SectionId, const TArray<VertexType0>& InVertices0, int32 StartVertex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateMeshSectionPrimaryBufferRange);
+
+		FRuntimeMeshScopeLock Lock(SyncRoot);
+
+		CheckUpdateLegacy<VertexType0, FRuntimeMeshNullVertex, FRuntimeMeshNullVertex, uint16>(SectionId, false);
+
+		if (!CheckSectionHasCPUData(SectionId))
+		{
+			return;
+		}
+
+		auto Mesh = BeginSectionUpdate(SectionId, LODIndex, UpdateFlags);
+
+		if (!CheckStreamRange(SectionId, StartVertex, InVertices0.Num(), Mesh->NumVertices(), false))
+		{
+			Mesh->Cancel();
+			return;
+		}
+
+		Mesh->SetVertexPropertiesRange(StartVertex, InVertices0.GetData(), InVertices0.Num());
+
+		Mesh->Commit(FRuntimeMeshStreamRange(StartVertex, InVertices0.Num()), FRuntimeMeshStreamRange(), true, true, true, true, false);
+	}
+
+	/**
+	 *	Overwrites the secondary buffer vertices starting at StartVertex with the supplied vertices. Only meshes using
+	 *	shared section buffers send just the changed range to the render thread, others send the whole stream.
+	 *	The section must already hold StartVertex + InVertices1.Num() vertices, otherwise nothing is updated.
+	 */
+	template<typename VertexType1>
+	void UpdateMeshSectionSecondaryBufferRange(int32 SectionId, const TArray<VertexType1>& InVertices1, int32 StartVertex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateMeshSectionSecondaryBufferRange);
+
+		FRuntimeMeshScopeLock Lock(SyncRoot);
+
+		CheckUpdateLegacy<FRuntimeMeshNullVertex, VertexType1, FRuntimeMeshNullVertex, uint16>(SectionId, false);
+
+		if (!CheckSectionHasCPUData(SectionId))
+		{
+			return;
+		}
+
+		auto Mesh = BeginSectionUpdate(SectionId, LODIndex, UpdateFlags);
+
+		if (!CheckStreamRange(SectionId, StartVertex, InVertices1.Num(), Mesh->NumVertices(), false))
+		{
+			Mesh->Cancel();
+			return;
+		}
+
+		Mesh->SetVertexPropertiesRange(StartVertex, InVertices1.GetData(), InVertices1.Num());
+
+		Mesh->Commit(FRuntimeMeshStreamRange(StartVertex, InVertices1.Num()), FRuntimeMeshStreamRange(), false, true, true, true, false);
+	}
+
+	/**
+	 *	Overwrites the indices starting at StartIndex with the supplied indices. Only meshes using shared section buffers
+	 *	send just the changed range to the render thread, others send the whole stream. The section must already hold
+	 *	StartIndex + InTriangles.Num() indices, otherwise nothing is updated.
+	 */
+	template<typename IndexType>
+	void UpdateMeshSectionTrianglesRange(int32 SectionId, const TArray<IndexType>& InTriangles, int32 StartIndex, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeMesh_UpdateMeshSectionTrianglesRange);
+
+		FRuntimeMeshScopeLock Lock(SyncRoot);
+
+		CheckUpdateLegacy<FRuntimeMeshNullVertex, FRuntimeMeshNullVertex, FRuntimeMeshNullVertex, IndexType>(SectionId, true);
+
+		if (!CheckSectionHasCPUData(SectionId))
+		{
+			return;
+		}
+
+		auto Mesh = BeginSectionUpdate(SectionId, LODIndex, UpdateFlags);
+
+		if (!CheckStreamRange(SectionId, StartIndex, InTriangles.Num(), Mesh->NumIndices(), true))
+		{
+			Mesh->Cancel();
+			return;
+		}
+
+		for (int32 Index = 0; Index < InTriangles.Num(); Index++)
+		{
+			Mesh->SetIndex(StartIndex + Index, InTriangles[Index]);
+		}
+
+		Mesh->Commit(FRuntimeMeshStreamRange(), FRuntimeMeshStreamRange(StartIndex, InTriangles.Num()), false, false, false, false, true);
+	}
+
+
 
 	void CreateMeshSection(int32 SectionId, const TSharedPtr<FRuntimeMeshBuilder>& MeshData, bool bCreateCollision = false,
 		EUpdateFrequency UpdateFrequency = EUpdateFrequency::Average, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None);
@@ -861,6 +973,13 @@ public:
 
 	void UpdateMeshSectionLOD(int32 SectionId, int32 LODIndex, const TSharedPtr<FRuntimeMeshBuilder>& MeshData, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None);
 
+	/**
+	*	Generates LOD1 onwards of a section by simplifying LOD0 down to each ratio of its triangles in turn, on a worker thread.
+	*	The LODs are filled in through UpdateMeshSectionLOD once done, unless LOD0's triangles changed in the meantime.
+	*	Any LODs beyond the new ones are removed. Use SetLODScreenSize to choose when each is drawn.
+	*/
+	void GenerateSectionLODs(int32 SectionId, const TArray<float>& LODTriangleRatios, const FRuntimeMeshSimplificationSettings& Settings = FRuntimeMeshSimplificationSettings());
+
 	void UpdateMeshSectionByMove(int32 SectionId, const TSharedPtr<FRuntimeMeshBuilder>& MeshData, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None);
 
 
@@ -877,7 +996,8 @@ public:
 
 
 private:
-	void EndSectionUpdate(FRuntimeMeshScopedUpdater* Updater, ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FBox* BoundingBox = nullptr);
+	void EndSectionUpdate(FRuntimeMeshScopedUpdater* Updater, ERuntimeMeshBuffersToUpdate BuffersToUpdate, const FBox* BoundingBox = nullptr,
+		const FRuntimeMeshStreamRange& VertexRange = FRuntimeMeshStreamRange::All(), const FRuntimeMeshStreamRange& IndexRange = FRuntimeMeshStreamRange::All());
 
 
 private:
@@ -901,6 +1021,12 @@ public:
 		bool bUseHighPrecisionTangents = false, bool bUseHighPrecisionUVs = true, int32 LODIndex = 0);
 
 
+	/**
+	*	Creates many sections at once. The sections are filled and their update flags handled in parallel, then they're
+	*	all sent to the render thread in one command, with the bounds and components updated once at the end.
+	*/
+	void CreateMeshSections(TArrayView<const FRuntimeMeshSectionBulkDesc> SectionDescs);
+
 	void UpdateMeshSection(int32 SectionIndex, const TArray<FVector>& Vertices, const TArray<FVector>& Normals, const TArray<FVector2D>& UV0,
 		const TArray<FColor>& Colors, const TArray<FRuntimeMeshTangent>& Tangents, ESectionUpdateFlags UpdateFlags = ESectionUpdateFlags::None, int32 LODIndex = 0);
 
@@ -1089,11 +1215,30 @@ private:
 	/* Finishes creating a section, including entering it for batch updating, or updating the RT directly */
 	void CreateSectionInternal(int32 SectionIndex, ESectionUpdateFlags UpdateFlags);
 
+	/** The part of CreateSectionInternal after the update flags are handled, sending the new section to the render thread and components */
+	void PublishSectionCreation(int32 SectionId, ESectionUpdateFlags UpdateFlags);
+
 	/* Finishes updating a section, including entering it for batch updating, or updating the RT directly */
-	void UpdateSectionInternal(int32 SectionIndex, int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate, ESectionUpdateFlags UpdateFlags);
+	void UpdateSectionInternal(int32 SectionIndex, int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate, ESectionUpdateFlags UpdateFlags,
+		const FRuntimeMeshStreamRange& VertexRange = FRuntimeMeshStreamRange::All(), const FRuntimeMeshStreamRange& IndexRange = FRuntimeMeshStreamRange::All());
+
+	/*
+		Handles things like automatic tessellation and tangent calculation that is common to both section creation and update.
+		Only touches the given section, so it's safe to run on sections that aren't in the table yet from other threads.
+	*/
+	void HandleCommonSectionUpdateFlags(const FRuntimeMeshSectionPtr& Section, int32 SectionIndex, int32 LODIndex, ESectionUpdateFlags UpdateFlags, ERuntimeMeshBuffersToUpdate& BuffersToUpdate);
 
-	/* Handles things like automatic tessellation and tangent calculation that is common to both section creation and update. */
-	void HandleCommonSectionUpdateFlags(int32 SectionIndex, int32 LODIndex, ESectionUpdateFlags UpdateFlags, ERuntimeMeshBuffersToUpdate& BuffersToUpdate);
+	/** Reorders a section LOD for the vertex cache, inline for small sections or on a worker thread for big ones if bAllowAsync */
+	void OptimizeSectionVertexCache(const FRuntimeMeshSectionPtr& Section, int32 SectionId, int32 LODIndex, bool bOptimizeOverdraw, bool bAllowAsync, ERuntimeMeshBuffersToUpdate& BuffersToUpdate);
+
+	/** Applies a vertex cache optimization to a section LOD, returns false if the section changed since it was started */
+	bool ApplySectionVertexCacheOptimization(const FRuntimeMeshSectionPtr& Section, int32 SectionId, int32 LODIndex, const FRuntimeMeshVertexCacheOptimizationInput& Input, const FRuntimeMeshVertexCacheOptimization& Optimization);
+
+	/** Fills in the LODs generated on a worker thread by GenerateSectionLODs */
+	void FinishAsyncLODGeneration(int32 SectionId, uint32 SourceTopologyCrc, const TArray<FRuntimeMeshBuilderPtr>& GeneratedLODs);
+
+	/** Applies and sends a vertex cache optimization that finished on a worker thread */
+	void FinishAsyncVertexCacheOptimization(int32 SectionId, int32 LODIndex, const FRuntimeMeshVertexCacheOptimizationInput& Input, const FRuntimeMeshVertexCacheOptimization& Optimization);
 
 	/* Finishes updating a sections properties, like visible/casts shadow, a*/
 	void UpdateSectionPropertiesInternal(int32 SectionIndex, bool bUpdateRequiresProxyRecreateIfStatic);
@@ -1101,11 +1246,27 @@ private:
 	/* Sends the LOD config to the render thread */
 	void UpdateLODDataInternal();
 
-	/** Update LocalBounds member from the local box of each section */
+	/** Flags a section as render only, turning off collision since it won't have the data for it */
+	void MarkSectionRenderOnly(int32 SectionId);
+
+	/** Puts a section's CPU copy at rest after it's been used, dropping it if the section is render only and has been sent, or compressing it if the section asked for that */
+	void ReleaseOrCompressSectionData(int32 SectionId);
+
+	/** Called when an updater is closed without committing, so the section can be put back at rest */
+	void EndSectionAccess(int32 SectionId);
+
+	/** Rebuild LocalBounds from the local box of every section */
 	void UpdateLocalBounds();
 
-	FRuntimeMeshProxyPtr EnsureProxyCreated(ERHIFeatureLevel::Type InFeatureLevel);
+	/** Refresh a single section's contribution to LocalBounds, only does any work if its box or visibility changed */
+	void UpdateSectionBounds(int32 SectionId);
+
+	/** Sets LocalBounds from the combined box, notifying linked components if it changed */
+	void SetLocalBounds(const FBox& LocalBox);
+
+	FRuntimeMeshProxyPtr EnsureProxyCreated(ERHIFeatureLevel::Type InFeatureLevel, bool bUseSharedSectionBuffers = false);
 	
+	/** Snapshot of a section's LOD 0 streams. Holds its own references to them, so later changes to the section don't affect it. */
 	TSharedPtr<const FRuntimeMeshAccessor> GetReadonlyMeshAccessor(int32 SectionId);
 
 	void Initialize();
@@ -1122,11 +1283,23 @@ private:
 
 	int32 GetSectionAndFaceFromCollisionFaceIndex(int32 & FaceIndex) const;
 
+	/**
+	*	Sends notifications to the mesh, right away on the game thread. Anywhere else they're queued, with one task
+	*	per mesh dispatched to send everything queued by the time it runs. SectionId is for SectionsCreated and SectionsChanged.
+	*/
+	void SendGameThreadNotifications(ERuntimeMeshGameThreadNotifications Notifications, int32 SectionId = INDEX_NONE);
+
+	/** Sends everything queued by SendGameThreadNotifications */
+	void FlushGameThreadNotifications();
 
-	void DoOnGameThread(FRuntimeMeshGameThreadTaskDelegate Func);
+	/** Adds notifications to the queue, dispatching a flush to the game thread if bScheduleFlush is set and one isn't already on its way */
+	void QueueGameThreadNotifications(ERuntimeMeshGameThreadNotifications Notifications, int32 SectionId, bool bScheduleFlush);
 
 	void MarkChanged();
 
+	/** Logs a warning for each render only section that has released its data, as those are left out when saving */
+	void WarnOfSectionsThatCantBeSaved() const;
+
 
 	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshData& MeshData)
 	{
@@ -1134,6 +1307,11 @@ private:
 
 		FRuntimeMeshScopeLock Lock(MeshData.SyncRoot, false, true);
 
+		if (Ar.IsSaving())
+		{
+			MeshData.WarnOfSectionsThatCantBeSaved();
+		}
+
 		Ar << MeshData.MeshSections;
 
 		Ar << MeshData.MeshCollisionSections;
@@ -1148,6 +1326,15 @@ private:
 		{
 			MeshData.UpdateLocalBounds();
 		}
+
+		// Saving unpacks compressed sections, so pack them back up
+		if (Ar.IsSaving())
+		{
+			for (int32 Index = 0; Index < MeshData.MeshSections.Num(); Index++)
+			{
+				MeshData.MeshSections.GetAt(Index)->CompressData();
+			}
+		}
 		return Ar;
 	}
 
@@ -1155,5 +1342,30 @@ private:
 	friend class FRuntimeMeshScopedUpdater;
 };
 
+/** 
+ *	Runs a batch of changes on the mesh for the life of the scope, see FRuntimeMeshData::BeginBatch. 
+ *	This is the only way to batch from outside the mesh, so every batch is sure to end.
+ */
+class FRuntimeMeshScopedBatch
+{
+	FRuntimeMeshDataPtr MeshData;
+
+public:
+	FRuntimeMeshScopedBatch(FRuntimeMeshData& InMeshData)
+		: MeshData(InMeshData.AsShared())
+	{
+		MeshData->BeginBatch();
+	}
+
+	~FRuntimeMeshScopedBatch()
+	{
+		MeshData->EndBatch();
+	}
+
+private:
+	FRuntimeMeshScopedBatch(const FRuntimeMeshScopedBatch&);
+	FRuntimeMeshScopedBatch& operator=(const FRuntimeMeshScopedBatch&);
+};
+
 using FRuntimeMeshDataRef = TSharedRef<FRuntimeMeshData, ESPMode::ThreadSafe>;
 using FRuntimeMeshDataPtr = TSharedPtr<FRuntimeMeshData, ESPMode::ThreadSafe>;
\ No newline at end of file
@@ -775,6 +775,17 @@ struct FRuntimeMeshDualUVHighPrecision
 	}
 };
 
+// The templated section functions copy these straight into the section streams, so keep them laid out like the streams
+static_assert(FRuntimeMeshVertexStreamLayout<FRuntimeMeshTangents>::IsTangentStream, "FRuntimeMeshTangents must match the tangent stream layout");
+static_assert(FRuntimeMeshVertexStreamLayout<FRuntimeMeshTangentsHighPrecision>::IsTangentStream, "FRuntimeMeshTangentsHighPrecision must match the tangent stream layout");
+static_assert(FRuntimeMeshVertexStreamLayout<FRuntimeMeshDualUV>::IsUVStream, "FRuntimeMeshDualUV must match the UV stream layout");
+static_assert(FRuntimeMeshVertexStreamLayout<FRuntimeMeshDualUVHighPrecision>::IsUVStream, "FRuntimeMeshDualUVHighPrecision must match the UV stream layout");
+static_assert(FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexSimple>::HasRawPosition && FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexSimple>::HasRawNormal &&
+	FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexSimple>::HasRawTangent && FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexSimple>::HasRawColor &&
+	FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexSimple>::HasRawUVs, "Generic vertex components must be in the section stream formats");
+static_assert(FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexDualUVHiPrecisionNormals>::HasRawTangent &&
+	FRuntimeMeshVertexStreamLayout<FRuntimeMeshVertexDualUVHiPrecisionNormals>::HasRawUVs, "Generic vertex components must be in the section stream formats");
+
 
 template<typename VertexType>
 inline bool GetTangentIsHighPrecision()
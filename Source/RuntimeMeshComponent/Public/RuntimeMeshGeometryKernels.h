@@ -0,0 +1,25 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+
+/*
+*	Vectorized kernels for common operations over tightly packed arrays of positions.
+*	Large inputs are split into chunks and processed in parallel on the task graph.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshGeometryKernels
+{
+	/** Gets the axis aligned box around the positions, which will be invalid if there are none */
+	static FBox ComputeBoundingBox(const FVector* Positions, int32 NumPositions);
+
+	/** Gets a sphere around the positions, centered on their bounding box */
+	static FSphere ComputeBoundingSphere(const FVector* Positions, int32 NumPositions);
+
+	/** Transforms positions by a matrix. InPositions and OutPositions can be the same array. */
+	static void TransformPositions(const FMatrix& Matrix, const FVector* InPositions, FVector* OutPositions, int32 NumPositions);
+
+	/** Gets the signed distance of each position from a plane */
+	static void ComputePlaneDistances(const FPlane& Plane, const FVector* Positions, float* OutDistances, int32 NumPositions);
+};
@@ -5,6 +5,10 @@
 #include "Engine.h"
 #include "RuntimeMeshCore.h"
 #include "RuntimeMeshBuilder.h"
+#include "RuntimeMeshCompression.h"
+#include "RuntimeMeshVertexCacheOptimizer.h"
+#include "RuntimeMeshVertexWelder.h"
+#include "RuntimeMeshClusterBuilder.h"
 
 enum class ERuntimeMeshBuffersToUpdate : uint8;
 struct FRuntimeMeshSectionVertexBufferParams;
@@ -18,7 +22,7 @@ struct FRuntimeMeshSectionVertexBuffer
 {
 private:
 	const int32 Stride;
-	TArray<uint8> Data;
+	FRuntimeMeshSharedStream Data;
 public:
 	FRuntimeMeshSectionVertexBuffer(int32 InStride) : Stride(InStride)
 	{
@@ -30,26 +34,27 @@ public:
 	{
 		if (bUseMove)
 		{
-			Data = MoveTemp(InVertices);
+			Data.Set(MoveTemp(InVertices));
 		}
 		else
 		{
-			Data = InVertices;
+			Data.Set(InVertices);
 		}
 	}
 
 	template<typename VertexType>
 	void SetData(const TArray<VertexType>& InVertices)
 	{
+		TArray<uint8>& NewData = Data.GetForOverwrite();
 		if (InVertices.Num() == 0)
 		{
-			Data.Empty();
+			NewData.Empty();
 			return;
 		}
 		check(InVertices.GetTypeSize() == GetStride());
 
-		Data.SetNum(InVertices.GetTypeSize() * InVertices.Num());
-		FMemory::Memcpy(Data.GetData(), InVertices.GetData(), Data.Num());
+		NewData.SetNum(InVertices.GetTypeSize() * InVertices.Num());
+		FMemory::Memcpy(NewData.GetData(), InVertices.GetData(), NewData.Num());
 	}
 
 	int32 GetStride() const
@@ -62,9 +67,19 @@ public:
 		return Stride > 0 ? Data.Num() / Stride : 0;
 	}
 
-	TArray<uint8>& GetData() { return Data; }
+	/** Readonly access to the data. Does not detach from pending render thread updates. */
+	const TArray<uint8>& GetData() const { return Data.Get(); }
 
-	void FillUpdateParams(FRuntimeMeshSectionVertexBufferParams& Params);
+	/** Writable access to the data. Copies the data first if it's still shared with a pending render thread update. */
+	TArray<uint8>& GetMutableData() { return Data.GetMutable(); }
+
+	/** Drops the data. Any pending render thread update keeps its own reference to it. */
+	void Empty() { Data.GetForOverwrite().Empty(); }
+
+	/** Readonly reference to the current data, which a later write or Empty detaches from */
+	FRuntimeMeshSharedStreamDataPtr ShareData() const { return Data.Share(); }
+
+	void FillUpdateParams(FRuntimeMeshSectionVertexBufferParams& Params, const FRuntimeMeshStreamRange& Range = FRuntimeMeshStreamRange::All());
 
 	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshSectionVertexBuffer& Buffer)
 	{
@@ -110,7 +125,7 @@ public:
 
 	bool IsUsingHighPrecision() const { return bUseHighPrecision; }
 
-	void FillUpdateParams(FRuntimeMeshSectionTangentVertexBufferParams& Params);
+	void FillUpdateParams(FRuntimeMeshSectionTangentVertexBufferParams& Params, const FRuntimeMeshStreamRange& Range = FRuntimeMeshStreamRange::All());
 
 	virtual void Serialize(FArchive& Ar) override
 	{
@@ -142,7 +157,7 @@ public:
 
 	int32 NumUVs() const { return UVCount; }
 
-	void FillUpdateParams(FRuntimeMeshSectionUVVertexBufferParams& Params);
+	void FillUpdateParams(FRuntimeMeshSectionUVVertexBufferParams& Params, const FRuntimeMeshStreamRange& Range = FRuntimeMeshStreamRange::All());
 
 	virtual void Serialize(FArchive& Ar) override
 	{
@@ -168,11 +183,19 @@ struct FRuntimeMeshSectionIndexBuffer
 {
 private:
 	const bool b32BitIndices;
-	TArray<uint8> Data;
+	FRuntimeMeshSharedStream Data;
+
+	/** Format of the last full upload, partial updates have to be sent in the same format */
+	ERuntimeMeshIndexEncoding Encoding;
+	int32 EncodedNumIndices;
+	TArray<FRuntimeMeshIndexSegment> EncodedSegments;
+
 public:
-	FRuntimeMeshSectionIndexBuffer() : b32BitIndices(false) { }
+	FRuntimeMeshSectionIndexBuffer() : b32BitIndices(false), Encoding(ERuntimeMeshIndexEncoding::Unknown), EncodedNumIndices(0) { }
 	FRuntimeMeshSectionIndexBuffer(bool bIn32BitIndices)
 		: b32BitIndices(bIn32BitIndices)
+		, Encoding(ERuntimeMeshIndexEncoding::Unknown)
+		, EncodedNumIndices(0)
 	{
 
 	}
@@ -181,11 +204,11 @@ public:
 	{
 		if (bUseMove)
 		{
-			Data = MoveTemp(InIndices);
+			Data.Set(MoveTemp(InIndices));
 		}
 		else
 		{
-			Data = InIndices;
+			Data.Set(InIndices);
 		}
 	}
 
@@ -194,8 +217,9 @@ public:
 	{
 		check(InIndices.GetTypeSize() == GetStride());
 
-		Data.SetNum(InIndices.GetTypeSize() * InIndices.Num());
-		FMemory::Memcpy(Data.GetData(), InIndices.GetData(), Data.Num());
+		TArray<uint8>& NewData = Data.GetForOverwrite();
+		NewData.SetNum(InIndices.GetTypeSize() * InIndices.Num());
+		FMemory::Memcpy(NewData.GetData(), InIndices.GetData(), NewData.Num());
 	}
 
 	int32 GetStride() const
@@ -213,14 +237,39 @@ public:
 		return Data.Num() / GetStride();
 	}
 
-	TArray<uint8>& GetData() { return Data; }
+	/** Readonly access to the data. Does not detach from pending render thread updates. */
+	const TArray<uint8>& GetData() const { return Data.Get(); }
 
-	void FillUpdateParams(FRuntimeMeshSectionIndexBufferParams& Params);
+	/** Writable access to the data. Copies the data first if it's still shared with a pending render thread update. */
+	TArray<uint8>& GetMutableData() { return Data.GetMutable(); }
+
+	/** Drops the data. Any pending render thread update keeps its own reference to it. */
+	void Empty() { Data.GetForOverwrite().Empty(); }
+
+	/** Readonly reference to the current data, which a later write or Empty detaches from */
+	FRuntimeMeshSharedStreamDataPtr ShareData() const { return Data.Share(); }
+
+	/*
+	*	Fills the render thread params for the indices. 32 bit indices are sent as 16 bit whenever they fit, either
+	*	directly or split into segments with their own base vertex. Partial updates are sent in the format of
+	*	the last full update, see CanUpdateRangeInPlace. IndicesPerPrimitive keeps segments on primitive boundaries.
+	*/
+	void FillUpdateParams(FRuntimeMeshSectionIndexBufferParams& Params, const FRuntimeMeshStreamRange& Range = FRuntimeMeshStreamRange::All(), 
+		int32 IndicesPerPrimitive = 3, bool bAllowEncoding = true);
+
+	/** Can a partial update of this range be sent in the format the render thread already has */
+	bool CanUpdateRangeInPlace(const FRuntimeMeshStreamRange& Range) const;
 
 	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshSectionIndexBuffer& Buffer)
 	{
 		Ar << const_cast<bool&>(Buffer.b32BitIndices);
 		Ar << Buffer.Data;
+
+		if (Ar.IsLoading())
+		{
+			Buffer.Encoding = ERuntimeMeshIndexEncoding::Unknown;
+			Buffer.EncodedSegments.Empty();
+		}
 		return Ar;
 	}
 };
@@ -258,6 +307,17 @@ public:
 	}
 
 
+	/** Drops all the stream data, keeping the stream formats */
+	void EmptyData()
+	{
+		PositionBuffer.Empty();
+		TangentsBuffer.Empty();
+		UVsBuffer.Empty();
+		ColorBuffer.Empty();
+		IndexBuffer.Empty();
+		AdjacencyIndexBuffer.Empty();
+	}
+
 	bool HasValidMeshData() const 
 	{
 		if (IndexBuffer.GetNumIndices() <= 0)
@@ -281,6 +341,12 @@ public:
 		PositionBuffer.SetData(InVertices, bUseMove);
 	}
 
+	template<typename VertexType>
+	void UpdatePositionBuffer(const TArray<VertexType>& InVertices)
+	{
+		PositionBuffer.SetData(InVertices);
+	}
+
 	void UpdateTangentsBuffer(TArray<uint8>& InVertices, bool bUseMove)
 	{
 		TangentsBuffer.SetData(InVertices, bUseMove);
@@ -331,21 +397,30 @@ public:
 		AdjacencyIndexBuffer.SetData(InIndices);
 	}
 
-	TSharedPtr<FRuntimeMeshAccessor> GetSectionMeshAccessor()
+	TSharedPtr<FRuntimeMeshAccessor> GetSectionMeshAccessor(bool bIsReadonly = false)
 	{
 		return MakeShared<FRuntimeMeshAccessor>(TangentsBuffer.IsUsingHighPrecision(), UVsBuffer.IsUsingHighPrecision(), UVsBuffer.NumUVs(), IndexBuffer.Is32BitIndices(),
-			&PositionBuffer.GetData(), &TangentsBuffer.GetData(), &UVsBuffer.GetData(), &ColorBuffer.GetData(), &IndexBuffer.GetData());
+			GetStreamForAccess(PositionBuffer, bIsReadonly), GetStreamForAccess(TangentsBuffer, bIsReadonly), GetStreamForAccess(UVsBuffer, bIsReadonly), 
+			GetStreamForAccess(ColorBuffer, bIsReadonly), GetStreamForAccess(IndexBuffer, bIsReadonly), bIsReadonly);
+	}
+
+	/** Readonly accessor that holds its own references to the streams, so it can outlive the lock */
+	TSharedPtr<const FRuntimeMeshAccessor> GetSharedReadonlyAccessor() const
+	{
+		return MakeShared<FRuntimeMeshSharedReadonlyAccessor>(TangentsBuffer.IsUsingHighPrecision(), UVsBuffer.IsUsingHighPrecision(), UVsBuffer.NumUVs(), IndexBuffer.Is32BitIndices(),
+			PositionBuffer.ShareData(), TangentsBuffer.ShareData(), UVsBuffer.ShareData(), ColorBuffer.ShareData(), IndexBuffer.ShareData());
 	}
 
 	TUniquePtr<FRuntimeMeshScopedUpdater> GetSectionMeshUpdater(const FRuntimeMeshDataPtr& ParentData, int32 SectionIndex, int32 LODIndex, ESectionUpdateFlags UpdateFlags, FRuntimeMeshLockProvider* LockProvider, bool bIsReadonly)
 	{
 		return TUniquePtr<FRuntimeMeshScopedUpdater>(new FRuntimeMeshScopedUpdater(ParentData, SectionIndex, LODIndex, UpdateFlags, TangentsBuffer.IsUsingHighPrecision(), UVsBuffer.IsUsingHighPrecision(), UVsBuffer.NumUVs(), IndexBuffer.Is32BitIndices(),
-			&PositionBuffer.GetData(), &TangentsBuffer.GetData(), &UVsBuffer.GetData(), &ColorBuffer.GetData(), &IndexBuffer.GetData(), LockProvider, bIsReadonly));
+			GetStreamForAccess(PositionBuffer, bIsReadonly), GetStreamForAccess(TangentsBuffer, bIsReadonly), GetStreamForAccess(UVsBuffer, bIsReadonly), 
+			GetStreamForAccess(ColorBuffer, bIsReadonly), GetStreamForAccess(IndexBuffer, bIsReadonly), LockProvider, bIsReadonly));
 	}
 
 	TSharedPtr<FRuntimeMeshIndicesAccessor> GetTessellationIndexAccessor()
 	{
-		return MakeShared<FRuntimeMeshIndicesAccessor>(AdjacencyIndexBuffer.Is32BitIndices(), &AdjacencyIndexBuffer.GetData());
+		return MakeShared<FRuntimeMeshIndicesAccessor>(AdjacencyIndexBuffer.Is32BitIndices(), &AdjacencyIndexBuffer.GetMutableData());
 	}
 
 	bool CheckTangentBuffer(bool bInUseHighPrecision) const
@@ -363,6 +438,19 @@ public:
 		return b32BitIndices == IndexBuffer.Is32BitIndices();
 	}
 
+	/** Fills the params for whichever of the index and adjacency buffers are given, keeping them in the same width */
+	void FillIndexUpdateParams(FRuntimeMeshSectionIndexBufferParams* IndexParams, FRuntimeMeshSectionIndexBufferParams* AdjacencyParams,
+		const FRuntimeMeshStreamRange& IndexRange = FRuntimeMeshStreamRange::All());
+
+private:
+	// Readonly access leaves the stream shared with any pending render thread update, the accessor enforces that it isn't written
+	template<typename BufferType>
+	static TArray<uint8>* GetStreamForAccess(BufferType& Buffer, bool bIsReadonly)
+	{
+		return bIsReadonly ? const_cast<TArray<uint8>*>(&Buffer.GetData()) : &Buffer.GetMutableData();
+	}
+
+public:
 
 	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshSectionLODData& LODData)
 	{
@@ -392,14 +480,41 @@ class FRuntimeMeshSection
 	bool bIsVisible;
 
 	bool bCastsShadow;
+
+	/** Whether the CPU copy of the mesh data is dropped once it's been sent to the render thread */
+	bool bIsRenderOnly;
+
+	/** Set once a render only section has dropped its CPU copy, after which none of its mesh data can be read */
+	bool bHasReleasedData;
+
+	/** Whether the mesh data was valid when it was released or compressed, so the section still knows if it renders */
+	bool bHadValidMeshData;
+
+	/** Whether the CPU copy is kept compressed while nothing is using it */
+	bool bCompressCPUData;
+
+	/** Set while the LOD streams are empty and their data lives in CompressedLODs */
+	bool bIsCompressed;
+
+	TArray<FRuntimeMeshCompressedLODData, TInlineAllocator<RUNTIMEMESH_MAXLODS>> CompressedLODs;
+
+	/** Grid each LOD was last unpacked from, so compressing it again doesn't quantize the positions a second time */
+	TArray<FRuntimeMeshPositionGrid, TInlineAllocator<RUNTIMEMESH_MAXLODS>> LODPositionGrids;
+
+	/** Clusters of each LOD's triangles, only set while its index buffer is in cluster order. Kept apart from the LODs as compression doesn't touch them */
+	TArray<TArray<FRuntimeMeshCluster>, TInlineAllocator<RUNTIMEMESH_MAXLODS>> LODClusters;
 public:
 	FRuntimeMeshSection(FArchive& Ar);
 	FRuntimeMeshSection(bool bInUseHighPrecisionTangents, bool bInUseHighPrecisionUVs, int32 InNumUVs, bool b32BitIndices, EUpdateFrequency InUpdateFrequency);
+	~FRuntimeMeshSection();
 
 	void AddLODLevelIfNotExists(int32 Index)
 	{
 		check(Index >= 0 && Index < RUNTIMEMESH_MAXLODS);
 
+		// Everything that goes through here touches the streams, so they have to be unpacked first
+		DecompressData();
+
 		while (!LODs.IsValidIndex(Index))
 		{
 			LODs.Emplace(LODs[0].TangentsBuffer.IsUsingHighPrecision(), LODs[0].UVsBuffer.IsUsingHighPrecision(), LODs[0].UVsBuffer.NumUVs(), LODs[0].IndexBuffer.Is32BitIndices());
@@ -416,23 +531,54 @@ public:
 	int32 GetNumVertices(int32 LODIndex) const 
 	{ 
 		check(LODs.IsValidIndex(LODIndex));
-		return LODs[LODIndex].PositionBuffer.GetNumVertices();
+		return bIsCompressed ? CompressedLODs[LODIndex].NumVertices : LODs[LODIndex].PositionBuffer.GetNumVertices();
 	}
 	int32 GetNumIndices(int32 LODIndex) const 
 	{
 		check(LODs.IsValidIndex(LODIndex));
-		return LODs[LODIndex].IndexBuffer.GetNumIndices();
+		return bIsCompressed ? CompressedLODs[LODIndex].NumIndices : LODs[LODIndex].IndexBuffer.GetNumIndices();
+	}
+	int32 GetNumAdjacencyIndices(int32 LODIndex) const
+	{
+		check(LODs.IsValidIndex(LODIndex));
+		return bIsCompressed ? CompressedLODs[LODIndex].NumAdjacencyIndices : LODs[LODIndex].AdjacencyIndexBuffer.GetNumIndices();
 	}
 	int32 GetNumLODs() const
 	{
 		return LODs.Num();
 	}
 
+	/** Drops every LOD from NumLODsToKeep onwards, always keeping LOD0 */
+	void RemoveLODsAbove(int32 NumLODsToKeep);
+
 	bool HasValidMeshData() const 
 	{
+		if (bHasReleasedData || bIsCompressed)
+		{
+			return bHadValidMeshData;
+		}
 		return LODs.IsValidIndex(0) && LODs[0].HasValidMeshData();
 	}
 
+	bool IsRenderOnly() const { return bIsRenderOnly; }
+	void SetRenderOnly(bool bNewRenderOnly) { bIsRenderOnly = bNewRenderOnly; }
+
+	/** False once a render only section has released its CPU copy */
+	bool HasCPUData() const { return !bHasReleasedData; }
+
+	/** Drops the CPU copy of all LODs. The render thread keeps its own copy, but this section can no longer be read, collided or saved. */
+	void ReleaseCPUData();
+
+	bool ShouldCompressCPUData() const { return bCompressCPUData; }
+	void SetCompressCPUData(bool bNewCompressCPUData) { bCompressCPUData = bNewCompressCPUData; }
+	bool IsCompressed() const { return bIsCompressed; }
+
+	/** Packs the CPU copy of all LODs if this section keeps its data compressed. Any access to the streams unpacks them again. */
+	void CompressData();
+
+	/** Unpacks the CPU copy if it's currently compressed */
+	void DecompressData();
+
 	void SetVisible(bool bNewVisible)
 	{
 		bIsVisible = bNewVisible;
@@ -463,7 +609,7 @@ public:
 	{
 		AddLODLevelIfNotExists(LODIndex);
 
-		LODs[LODIndex].UpdatePositionBuffer(InVertices, bUseMove);
+		LODs[LODIndex].UpdatePositionBuffer(InVertices);
 
 		if (LODIndex == 0)
 		{
@@ -546,11 +692,18 @@ public:
 		LODs[LODIndex].UpdateAdjacencyIndexBuffer(InIndices);
 	}
 
-	TSharedPtr<FRuntimeMeshAccessor> GetSectionMeshAccessor(int32 LODIndex)
+	TSharedPtr<FRuntimeMeshAccessor> GetSectionMeshAccessor(int32 LODIndex, bool bIsReadonly = false)
 	{
 		AddLODLevelIfNotExists(LODIndex);
 
-		return LODs[LODIndex].GetSectionMeshAccessor();
+		return LODs[LODIndex].GetSectionMeshAccessor(bIsReadonly);
+	}
+
+	TSharedPtr<const FRuntimeMeshAccessor> GetSharedReadonlyAccessor(int32 LODIndex)
+	{
+		AddLODLevelIfNotExists(LODIndex);
+
+		return LODs[LODIndex].GetSharedReadonlyAccessor();
 	}
 
 	TUniquePtr<FRuntimeMeshScopedUpdater> GetSectionMeshUpdater(const FRuntimeMeshDataPtr& ParentData, int32 SectionIndex, int32 LODIndex, ESectionUpdateFlags UpdateFlags, FRuntimeMeshLockProvider* LockProvider, bool bIsReadonly)
@@ -571,11 +724,52 @@ public:
 
 	TSharedPtr<struct FRuntimeMeshSectionCreationParams, ESPMode::NotThreadSafe> GetSectionCreationParams();
 
-	TSharedPtr<struct FRuntimeMeshSectionUpdateParams, ESPMode::NotThreadSafe> GetSectionUpdateData(int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate);
+	/** 
+	 *	Builds the render thread update for the given buffers. Vertex and index buffers only carry the given
+	 *	ranges, which must only be partial if the stream length hasn't changed since the last update.
+	 */
+	TSharedPtr<struct FRuntimeMeshSectionUpdateParams, ESPMode::NotThreadSafe> GetSectionUpdateData(int32 LODIndex, ERuntimeMeshBuffersToUpdate BuffersToUpdate,
+		const FRuntimeMeshStreamRange& VertexRange = FRuntimeMeshStreamRange::All(), const FRuntimeMeshStreamRange& IndexRange = FRuntimeMeshStreamRange::All());
+
+	/** Copies what the vertex cache optimizer needs out of a LOD */
+	void GatherVertexCacheOptimizationInput(int32 LODIndex, bool bOptimizeOverdraw, FRuntimeMeshVertexCacheOptimizationInput& OutInput);
+
+	/** Applies an optimization of a LOD. Returns false without changing anything if the LOD's triangles changed since the input was gathered */
+	bool ApplyVertexCacheOptimization(int32 LODIndex, const FRuntimeMeshVertexCacheOptimizationInput& Input, const FRuntimeMeshVertexCacheOptimization& Optimization);
+
+	/** Merges matching vertices in a LOD and drops the degenerate and duplicate triangles left behind */
+	FRuntimeMeshVertexWeldResult WeldVertices(int32 LODIndex, const FRuntimeMeshVertexWeldSettings& Settings);
+
+	/** Reorders a LOD's triangles into clusters that can be culled on their own. Returns false if the LOD is too small to be worth it */
+	bool BuildClusters(int32 LODIndex, int32 MaxTriangles = FRuntimeMeshClusterBuilder::DefaultMaxTriangles);
+
+	/** Forgets a LOD's clusters, for when its triangles or positions have changed */
+	void ClearClusters(int32 LODIndex)
+	{
+		if (LODClusters.IsValidIndex(LODIndex))
+		{
+			LODClusters[LODIndex].Empty();
+		}
+	}
+
+	bool HasClusters(int32 LODIndex) const { return LODClusters.IsValidIndex(LODIndex) && LODClusters[LODIndex].Num() > 0; }
+
+	/** Copies a LOD into a standalone builder that can be used away from the section. Streams that were never filled are padded out. */
+	FRuntimeMeshBuilderRef CopyLODToBuilder(int32 LODIndex);
+
+	/** Checksum of a LOD's vertex count and indices, to tell if its triangles have changed since a copy was taken */
+	uint32 GetLODTopologyCrc(int32 LODIndex);
+
+	/** Can a partial index update of this range be sent as is, or does the whole index buffer have to be re-encoded */
+	bool CanUpdateIndexRangeInPlace(int32 LODIndex, const FRuntimeMeshStreamRange& IndexRange);
 
 	TSharedPtr<struct FRuntimeMeshSectionPropertyUpdateParams, ESPMode::NotThreadSafe> GetSectionPropertyUpdateData();
 
 	void UpdateBoundingBox();
+
+	/** Bounds of a single LOD, LOD0 uses the section bounds so user supplied boxes carry through */
+	FBox GetLODBoundingBox(int32 LODIndex);
+
 	void SetBoundingBox(const FBox& InBoundingBox) { LocalBoundingBox = InBoundingBox; }
 
 	int32 GetCollisionData(int32 LODIndex, TArray<FVector>& OutPositions, TArray<FTriIndices>& OutIndices, TArray<FVector2D>& OutUVs);
@@ -598,6 +792,9 @@ public:
 
 	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshSection& MeshData)
 	{
+		// Always saved uncompressed so the format doesn't change
+		MeshData.DecompressData();
+
 		Ar << const_cast<EUpdateFrequency&>(MeshData.UpdateFrequency);
 		
 		if (Ar.CustomVer(FRuntimeMeshVersion::GUID) >= FRuntimeMeshVersion::AddLODSupport)
@@ -634,6 +831,12 @@ public:
 		Ar << MeshData.bIsVisible;
 		Ar << MeshData.bCastsShadow;
 
+		if (Ar.CustomVer(FRuntimeMeshVersion::GUID) >= FRuntimeMeshVersion::AddSectionCPUDataModes)
+		{
+			Ar << MeshData.bIsRenderOnly;
+			Ar << MeshData.bCompressCPUData;
+		}
+
 		// This is a hack to read the old data and ignore it
 		if (Ar.CustomVer(FRuntimeMeshVersion::GUID) < FRuntimeMeshVersion::RuntimeMeshComponentUE4_19)
 		{
@@ -661,7 +864,8 @@ FORCEINLINE static FArchive& operator <<(FArchive& Ar, FRuntimeMeshSectionPtr& S
 {
 	if (Ar.IsSaving())
 	{
-		bool bHasSection = Section.IsValid();
+		// Render only sections have nothing left to save once they've released their data
+		bool bHasSection = Section.IsValid() && Section->HasCPUData();
 		Ar << bHasSection;
 		if (bHasSection)
 		{
@@ -0,0 +1,73 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshSection.h"
+
+
+/*
+*	Sparse set of sections keyed by section id.
+*	Live sections are packed into a dense array so iterating only touches real sections, and
+*	free ids below the highest id are kept in a min heap so the lowest free id is always at hand.
+*/
+class RUNTIMEMESHCOMPONENT_API FRuntimeMeshSectionTable
+{
+	/** Index into the dense arrays for each id, INDEX_NONE for ids without a section */
+	TArray<int32> SparseIndices;
+
+	/** Live sections, and the id of each, in no particular order */
+	TArray<FRuntimeMeshSectionPtr> DenseSections;
+	TArray<int32> DenseIds;
+
+	/**
+	*	Min heap of free ids below SparseIndices.Num(). Ids are removed lazily so it can also
+	*	hold ids that have since been reused, but the top is always a free id.
+	*/
+	TArray<int32> FreeIds;
+
+public:
+
+	/** Number of live sections */
+	int32 Num() const { return DenseSections.Num(); }
+
+	/** One past the highest id in use, so every section id is less than this */
+	int32 GetMaxId() const { return SparseIndices.Num(); }
+
+	bool Contains(int32 SectionId) const
+	{
+		return SparseIndices.IsValidIndex(SectionId) && SparseIndices[SectionId] != INDEX_NONE;
+	}
+
+	/** Gets the lowest id that doesn't have a section */
+	int32 GetAvailableId() const
+	{
+		return FreeIds.Num() > 0 && FreeIds.HeapTop() < SparseIndices.Num() ? FreeIds.HeapTop() : SparseIndices.Num();
+	}
+
+	const FRuntimeMeshSectionPtr& operator[](int32 SectionId) const
+	{
+		check(Contains(SectionId));
+		return DenseSections[SparseIndices[SectionId]];
+	}
+
+	/** Access to live sections by dense index, for iterating over all of them */
+	int32 GetIdAt(int32 DenseIndex) const { return DenseIds[DenseIndex]; }
+	const FRuntimeMeshSectionPtr& GetAt(int32 DenseIndex) const { return DenseSections[DenseIndex]; }
+
+	/** Gets the ids of all live sections */
+	const TArray<int32>& GetIds() const { return DenseIds; }
+
+	/** Adds a section at the given id, replacing any section already there */
+	void Add(int32 SectionId, const FRuntimeMeshSectionPtr& Section);
+
+	/** Removes the section at the given id, returns false if there wasn't one */
+	bool Remove(int32 SectionId);
+
+	void Empty();
+
+	friend FArchive& operator <<(FArchive& Ar, FRuntimeMeshSectionTable& Table);
+
+private:
+	void RebuildFreeIds();
+};
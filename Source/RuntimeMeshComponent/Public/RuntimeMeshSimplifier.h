@@ -0,0 +1,45 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+#include "RuntimeMeshBuilder.h"
+
+
+/** Weights for the parts of the cost of each collapse */
+struct FRuntimeMeshSimplificationSettings
+{
+	/** Cost of bending normals, scaled by the squared edge length so it's comparable to the position error */
+	float NormalWeight;
+
+	/** Cost of moving UVs, scaled the same way */
+	float UVWeight;
+
+	/** Weight of the planes that keep open borders and UV/normal seams in place */
+	float BorderWeight;
+
+	/** A collapse is rejected if it would turn any triangle further than this from its original facing, as a cosine */
+	float MinTriangleNormalDot;
+
+	FRuntimeMeshSimplificationSettings()
+		: NormalWeight(1.0f), UVWeight(1.0f), BorderWeight(10.0f), MinTriangleNormalDot(0.2f)
+	{ }
+};
+
+
+/*
+*	Generates lower detail versions of a mesh by quadric error edge collapse (Garland and Heckbert 1997).
+*	Collapses are half edge, so every vertex of a generated LOD is an unmodified vertex of the source and no
+*	attributes have to be interpolated. Vertices on open borders or on UV/normal seams only move along the
+*	border or seam, and vertices where several of those meet, or on non manifold edges, never move.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshSimplifier
+{
+	/**
+	*	Simplifies the source down to each of the ratios of its triangle count in turn, each LOD continuing from the
+	*	last, so ratios should be decreasing. A LOD can end up above its target if nothing else can be collapsed.
+	*	OutLODs gets one builder per ratio in the source's format. Safe to call from any thread.
+	*	Returns false if the source isn't a valid triangle list.
+	*/
+	static bool GenerateLODs(const FRuntimeMeshAccessor& Source, const TArray<float>& TriangleRatios, const FRuntimeMeshSimplificationSettings& Settings, TArray<FRuntimeMeshBuilderPtr>& OutLODs);
+};
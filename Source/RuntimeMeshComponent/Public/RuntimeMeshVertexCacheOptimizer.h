@@ -0,0 +1,74 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+class FRuntimeMeshSectionLODData;
+
+
+/** Copy of the parts of a section LOD the optimizer reads, so it can run away from the section */
+struct FRuntimeMeshVertexCacheOptimizationInput
+{
+	/** Triangle list, widened to 32 bits */
+	TArray<uint32> Indices;
+
+	/** Only gathered when optimizing for overdraw */
+	TArray<FVector> Positions;
+
+	int32 NumVertices;
+
+	FRuntimeMeshVertexCacheOptimizationInput() : NumVertices(0) { }
+};
+
+/** New triangle and vertex order for a section LOD */
+struct FRuntimeMeshVertexCacheOptimization
+{
+	/** Triangle list in the new order, already using the new vertex indices */
+	TArray<uint32> Indices;
+
+	/** New index of each of the original vertices */
+	TArray<int32> VertexRemap;
+
+	/** Average cache misses per triangle before and after */
+	float ACMRBefore;
+	float ACMRAfter;
+
+	FRuntimeMeshVertexCacheOptimization() : ACMRBefore(0.0f), ACMRAfter(0.0f) { }
+};
+
+
+/*
+*	Reorders triangles for post transform vertex cache reuse, using Tipsify (Sander, Nehab and Barczak 2007),
+*	optionally sorts the resulting clusters of triangles to reduce overdraw, then reorders vertices into the
+*	order they're first used so vertex fetches stay local.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshVertexCacheOptimizer
+{
+	/** Size of the FIFO cache the optimizer targets and ACMR is measured against */
+	static const int32 DefaultCacheSize = 16;
+
+	/** Average number of cache misses per triangle for a FIFO cache of the given size. 0.5 is ideal for big meshes, 3 means no reuse */
+	static float ComputeACMR(const TArray<uint32>& Indices, int32 NumVertices, int32 CacheSize = DefaultCacheSize);
+
+	/**
+	*	Reorders triangles for cache reuse. OutClusterStarts is filled with the first triangle of each run that can be
+	*	moved as a whole without hurting the cache much, for use by OptimizeOverdraw.
+	*/
+	static void OptimizeTriangleOrder(const TArray<uint32>& Indices, int32 NumVertices, TArray<uint32>& OutIndices, TArray<int32>& OutClusterStarts, int32 CacheSize = DefaultCacheSize);
+
+	/** Sorts clusters of triangles so the ones facing out from the middle of the mesh draw first */
+	static void OptimizeOverdraw(TArray<uint32>& Indices, const TArray<int32>& ClusterStarts, const TArray<FVector>& Positions);
+
+	/** Gets the new index of each vertex, in the order they're first used. Unused vertices go at the end in their existing order. */
+	static void ComputeVertexFetchRemap(const TArray<uint32>& Indices, int32 NumVertices, TArray<int32>& OutRemap);
+
+	/** Runs all the passes over the input. Safe to call from any thread. Returns false if the input isn't a valid triangle list */
+	static bool Optimize(const FRuntimeMeshVertexCacheOptimizationInput& Input, bool bOptimizeOverdraw, FRuntimeMeshVertexCacheOptimization& OutResult);
+
+	/** Copies what the optimizer needs out of a LOD */
+	static void GatherInput(const FRuntimeMeshSectionLODData& LOD, bool bOptimizeOverdraw, FRuntimeMeshVertexCacheOptimizationInput& OutInput);
+
+	/** Rewrites every stream of the LOD in the new order, including the adjacency indices */
+	static void Apply(const FRuntimeMeshVertexCacheOptimization& Optimization, FRuntimeMeshSectionLODData& LOD);
+};
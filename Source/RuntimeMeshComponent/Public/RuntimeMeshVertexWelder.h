@@ -0,0 +1,62 @@
+// Copyright 2016-2018 Chris Conway (Koderz). All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+class FRuntimeMeshSectionLODData;
+
+
+/** How close two vertices have to be in each stream to be merged */
+struct FRuntimeMeshVertexWeldSettings
+{
+	/** Max distance between positions */
+	float PositionTolerance;
+
+	/** Max difference per component of the unpacked normal and tangent */
+	float TangentTolerance;
+
+	/** Max difference per component of each UV channel */
+	float UVTolerance;
+
+	/** Skips comparing tangents, used when they're about to be recalculated anyway */
+	bool bIgnoreTangents;
+
+	FRuntimeMeshVertexWeldSettings()
+		: PositionTolerance(THRESH_POINTS_ARE_SAME), TangentTolerance(0.01f), UVTolerance(1.0f / 1024.0f), bIgnoreTangents(false)
+	{ }
+};
+
+/** What a weld removed from a section LOD */
+struct FRuntimeMeshVertexWeldResult
+{
+	int32 NumVerticesBefore;
+	int32 NumVerticesAfter;
+	int32 NumDegenerateTriangles;
+	int32 NumDuplicateTriangles;
+
+	FRuntimeMeshVertexWeldResult() : NumVerticesBefore(0), NumVerticesAfter(0), NumDegenerateTriangles(0), NumDuplicateTriangles(0) { }
+
+	bool ChangedMesh() const { return NumVerticesAfter != NumVerticesBefore || NumDegenerateTriangles > 0 || NumDuplicateTriangles > 0; }
+};
+
+
+/*
+*	Merges vertices that match in every stream, then drops the triangles left degenerate or duplicated by it.
+*	Candidates are found through a hash grid over the positions with cells twice the position tolerance, so each
+*	vertex only has to be compared against the few already in the cells it overlaps. Colors have to match exactly.
+*/
+struct RUNTIMEMESHCOMPONENT_API FRuntimeMeshVertexWelder
+{
+	/**
+	*	Gets the vertex each vertex should be merged into, which is always the first of its matches. Vertices that are
+	*	kept map to themselves. Streams that don't match the positions in length aren't compared.
+	*/
+	static void FindWeldTargets(const FRuntimeMeshSectionLODData& LOD, const FRuntimeMeshVertexWeldSettings& Settings, TArray<int32>& OutWeldTargets);
+
+	/**
+	*	Welds the LOD and compacts every stream in place, keeping vertices and triangles in their existing order.
+	*	Vertices no triangle uses anymore are removed. The adjacency indices are emptied, as they no longer match the triangles.
+	*/
+	static FRuntimeMeshVertexWeldResult WeldLOD(FRuntimeMeshSectionLODData& LOD, const FRuntimeMeshVertexWeldSettings& Settings);
+};